@@ -24,6 +24,7 @@ class KthRecipe(KnuthConanFileV2):
         "shared": [True, False],
         "fPIC": [True, False],
         "tests": [True, False],
+        "benchmarks": [True, False],
         "console": [True, False],
         "march_id": ["ANY"],
         "march_strategy": ["download_if_possible", "optimized", "download_or_fail"],
@@ -66,6 +67,7 @@ class KthRecipe(KnuthConanFileV2):
         "shared": False,
         "fPIC": True,
         "tests": True,
+        "benchmarks": False,
         "console": False,
         "march_strategy": "download_if_possible",
         "currency": "BCH",
@@ -140,7 +142,7 @@ class KthRecipe(KnuthConanFileV2):
 
     def build_requirements(self):
         self.tool_requires("secp256k1-precompute/1.0.0")
-        if self.options.tests:
+        if self.options.tests or self.options.benchmarks:
             self.test_requires("catch2/3.6.0")
 
     def config_options(self):
@@ -234,6 +236,7 @@ class KthRecipe(KnuthConanFileV2):
             
         # Enable compatibility with the tests - unify all test variables
         tc.variables["ENABLE_TEST"] = option_on_off(self.options.tests)
+        tc.variables["WITH_BENCHMARKS"] = option_on_off(self.options.benchmarks)
         tc.variables["SECP256K1_BUILD_TEST"] = option_on_off(self.options.tests)
         # Secp256k1 -------------------------------------------- (END)
 
@@ -0,0 +1,77 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/blockchain/mining/mempool.hpp>
+#include <kth/blockchain.hpp>
+
+using namespace kth;
+using namespace kd::chain;
+using namespace kth::mining;
+
+// Independent synthetic transactions, each one spending a distinct output
+// (not in the pool) of which the prevout is already cached.
+
+namespace {
+
+transaction make_independent(uint32_t id) {
+    hash_digest previous = null_hash;
+    previous[0] = uint8_t(id);
+    previous[1] = uint8_t(id >> 8);
+    previous[2] = uint8_t(id >> 16);
+    previous[3] = uint8_t(id >> 24);
+    previous[31] = 1;
+
+    transaction tx {1, 0, {input{output_point{previous, 0}, script{}, 0xffffffff}}, {output{900, script{}, token_data_opt{}}}};
+    tx.inputs()[0].previous_output().validation.cache = output{1000, script{}, token_data_opt{}};
+    return tx;
+}
+
+} // namespace
+
+// Start Benchmark Suite: mempool benchmarks
+
+// The time to remove the transactions of a block should not depend on the
+// size of the pool. Every run removes its own block of new transactions,
+// added to the pool outside of the measurement.
+TEST_CASE("mempool  remove block  by pool size", "[mempool benchmarks]") {
+    size_t const block_size = 1000;
+    uint32_t next_id = 0;
+
+    for (size_t const pool_size : {10000, 40000, 160000}) {
+        mempool pool;
+        for (size_t i = 0; i < pool_size; ++i) {
+            pool.add(make_independent(next_id++));
+        }
+        REQUIRE(pool.all_transactions() == pool_size);
+
+        auto const name = "mempool::remove " + std::to_string(block_size) + " of " + std::to_string(pool_size);
+
+        BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter) {
+            std::vector<transaction::list> blocks(meter.runs());
+            for (auto& block : blocks) {
+                block.reserve(block_size);
+                for (size_t i = 0; i < block_size; ++i) {
+                    block.push_back(make_independent(next_id++));
+                    pool.add(block.back());
+                }
+            }
+
+            meter.measure([&](int run) {
+                auto const& block = blocks[run];
+                return pool.remove(block.begin(), block.end(), block.size());
+            });
+        };
+
+        REQUIRE(pool.all_transactions() == pool_size);
+    }
+}
+
+// End Benchmark Suite
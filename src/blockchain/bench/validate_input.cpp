@@ -0,0 +1,89 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstdint>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/blockchain.hpp>
+
+using namespace kth;
+using namespace kd::chain;
+using namespace kth::blockchain;
+using namespace kd::machine;
+
+// Mainnet transactions of the validate block tests, with their prevouts.
+// The signature cache is disabled so that every run verifies the signature.
+
+namespace {
+
+transaction make_spend(char const* encoded_tx, char const* encoded_script, uint64_t value) {
+    data_chunk decoded_tx;
+    REQUIRE(decode_base16(decoded_tx, encoded_tx));
+
+    data_chunk decoded_script;
+    REQUIRE(decode_base16(decoded_script, encoded_script));
+
+    byte_reader tx_reader(decoded_tx);
+    auto tx = transaction::from_data(tx_reader, true);
+    REQUIRE(tx);
+
+    byte_reader script_reader(decoded_script);
+    auto prevout_script = script::from_data(script_reader, false);
+    REQUIRE(prevout_script);
+
+    auto& prevout = tx->inputs()[0].previous_output().validation.cache;
+    prevout.set_value(value);
+    prevout.set_script(std::move(*prevout_script));
+    REQUIRE(prevout.script().is_valid());
+    return std::move(*tx);
+}
+
+} // namespace
+
+// Start Benchmark Suite: validate input benchmarks
+
+TEST_CASE("validate input  verify script  p2sh", "[validate input benchmarks]") {
+    // Block 438513.
+    auto const tx = make_spend(
+        "0100000001a06bf74cc36eac395188b06850c5a01d00b355065c589d14036e89e075d7518e000000009d483045022100ba555ac17a084e2a1b621c2171fa563bc4fb75cd5c0968153f44ba7203cb876f022036626f4579de16e3ad160df01f649ffb8dbf47b504ee56dc3ad7260af24ca0db0101004c50632102768e47607c52e581595711e27faffa7cb646b4f481fe269bd49691b2fbc12106ad6704355e2658b1756821028a5af8284a12848d69a25a0ac5cea20be905848eb645fd03d3b065df88a9117cacfeffffff0158920100000000001976a9149d86f66406d316d44d58cbf90d71179dd8162dd388ac355e2658",
+        "a914faa558780a5767f9e3be14992a578fc1cbcf483087",
+        0);
+
+    validate_input::set_signature_cache_size(0);
+    REQUIRE(validate_input::verify_script(tx, 0, 62u).first == error::success);
+
+    BENCHMARK("validate_input::verify_script p2sh") {
+        return validate_input::verify_script(tx, 0, 62u);
+    };
+}
+
+#if defined(KTH_CURRENCY_BCH)
+TEST_CASE("validate input  verify script  p2pkh", "[validate input benchmarks]") {
+    // Block 520679, validated with the forks of the November 2018 upgrade on.
+    auto const tx = make_spend(
+        "0100000001072dcb9a422dd03a42d6cedc3dfc883fb21c7a0cacb37fcfc6f4fbc6edc28f20000000006b48304502210099212bdccb2f12d26a1e6d859601bcd76ae3c8861261c6143923937200fa62a40220114e8003a90ffcb6ab3e05641b3daf64006d7bc4f959870f04efb01cad9aa4f3412102822d3e9a0bd0be3f4fab74c2ac9c85f4a0316b331bf92b3c3ef4484975c85e24ffffffff013c000c00000000001976a91463b302f02c2635a4054aa9b43995abbaa28c6f1088ac00000000",
+        "76a9149a45c630ad1ddde200adbf048a929329220dd9a388ac",
+        801932);
+
+    uint32_t forks = rule_fork::bip16_rule;
+    forks |= rule_fork::bip65_rule;
+    forks |= rule_fork::bip66_rule;
+    forks |= rule_fork::bip112_rule;
+    forks |= rule_fork::bch_uahf;
+    forks |= rule_fork::bch_daa_cw144;
+    forks |= rule_fork::bch_euclid;
+    forks |= rule_fork::bch_pisano;
+
+    validate_input::set_signature_cache_size(0);
+    REQUIRE(validate_input::verify_script(tx, 0, forks).first == error::success);
+
+    BENCHMARK("validate_input::verify_script p2pkh") {
+        return validate_input::verify_script(tx, 0, forks);
+    };
+}
+#endif
+
+// End Benchmark Suite
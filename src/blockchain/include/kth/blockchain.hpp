@@ -35,6 +35,7 @@
 #include <kth/blockchain/populate/populate_block.hpp>
 #include <kth/blockchain/populate/populate_chain_state.hpp>
 #include <kth/blockchain/populate/populate_transaction.hpp>
+#include <kth/blockchain/validate/script_cache.hpp>
 #include <kth/blockchain/validate/validate_block.hpp>
 #include <kth/blockchain/validate/validate_input.hpp>
 #include <kth/blockchain/validate/validate_transaction.hpp>
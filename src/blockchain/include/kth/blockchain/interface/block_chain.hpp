@@ -23,9 +23,10 @@
 #include <kth/blockchain/pools/transaction_organizer.hpp>
 #include <kth/blockchain/populate/populate_chain_state.hpp>
 #include <kth/blockchain/settings.hpp>
+#include <kth/blockchain/validate/script_cache.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
@@ -62,6 +63,10 @@ public:
     /// Get the output that is referenced by the outpoint in the UTXO Set.
     bool get_utxo(domain::chain::output& out_output, size_t& out_height, uint32_t& out_median_time_past, bool& out_coinbase, domain::chain::output_point const& outpoint, size_t branch_height) const override;
 
+    void populate_utxos(std::vector<domain::chain::output_point const*> const& outpoints, size_t branch_height) const override;
+
+    void prefetch_utxos(std::vector<domain::chain::output_point const*> const& outpoints) const override;
+
     std::pair<bool, database::internal_database::utxo_pool_t> get_utxo_pool_from(uint32_t from, uint32_t to) const override;
 
     /// Get a determination of whether the block hash exists in the store.
@@ -342,7 +347,7 @@ public:
     settings const& chain_settings() const;
 
 #if defined(KTH_WITH_MEMPOOL)
-    std::pair<std::vector<kth::mining::transaction_element>, uint64_t> get_block_template() const;
+    kth::mining::mempool::block_template_ptr get_block_template() const;
 #endif
 
 protected:
@@ -390,6 +395,7 @@ private:
     mutable prioritized_mutex validation_mutex_;
     mutable threadpool priority_pool_;
     mutable dispatcher dispatch_;
+    script_cache script_cache_;
 
 
 #if defined(KTH_WITH_MEMPOOL)
@@ -6,6 +6,7 @@
 #define KTH_BLOCKCHAIN_FAST_CHAIN_HPP
 
 #include <cstddef>
+#include <vector>
 #include <kth/database.hpp>
 #include <kth/blockchain/define.hpp>
 #include <kth/blockchain/pools/branch.hpp>
@@ -66,6 +67,13 @@ public:
     /// Get the output that is referenced by the outpoint in the UTXO Set.
     virtual bool get_utxo(domain::chain::output& out_output, size_t& out_height, uint32_t& out_median_time_past, bool& out_coinbase, domain::chain::output_point const& outpoint, size_t branch_height) const = 0;
 
+    /// Populate the validation of the outpoints from the UTXO Set, in a single batch.
+    virtual void populate_utxos(std::vector<domain::chain::output_point const*> const& outpoints, size_t branch_height) const = 0;
+
+    /// Read the outpoints from the UTXO Set without populating them, so that
+    /// a later population finds the store pages in memory.
+    virtual void prefetch_utxos(std::vector<domain::chain::output_point const*> const& outpoints) const = 0;
+
     /// Get a UTXO subset from the reorganization pool, [from, to] the specified heights.
     virtual std::pair<bool, database::internal_database::utxo_pool_t> get_utxo_pool_from(uint32_t from, uint32_t to) const = 0;
 
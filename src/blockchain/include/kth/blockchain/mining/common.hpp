@@ -23,7 +23,7 @@
 namespace kth::mining {
 
 #if defined(KTH_CURRENCY_BCH)
-constexpr size_t min_transaction_size_for_capacity = min_transaction_size;
+constexpr size_t min_transaction_size_for_capacity = min_transaction_size_descartes;
 #else
  //TODO(fernando): check if it is possible to be a TX size less than this...
 constexpr size_t min_transaction_size_for_capacity = 61;
@@ -0,0 +1,126 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_BLOCKCHAIN_MINING_INDEXED_HEAP_HPP_
+#define KTH_BLOCKCHAIN_MINING_INDEXED_HEAP_HPP_
+
+#include <utility>
+#include <vector>
+
+#include <kth/blockchain/mining/common.hpp>
+
+namespace kth {
+namespace mining {
+
+// A binary heap of pool indexes that keeps the position of each of them, so
+// that any element, not only the top, is erased or re-sifted in O(log n).
+// cmp(a, b) is true when a goes below b, the top is the greatest element.
+template <typename Cmp>
+class indexed_heap {
+public:
+    explicit
+    indexed_heap(Cmp cmp)
+        : cmp_(std::move(cmp))
+    {}
+
+    bool empty() const {
+        return heap_.empty();
+    }
+
+    size_t size() const {
+        return heap_.size();
+    }
+
+    bool contains(index_t index) const {
+        return index < positions_.size() && positions_[index] != null_index;
+    }
+
+    index_t top() const {
+        //precondition: ! empty()
+        return heap_.front();
+    }
+
+    void push(index_t index) {
+        //precondition: ! contains(index)
+        if (index >= positions_.size()) {
+            positions_.resize(index + 1, null_index);
+        }
+
+        heap_.push_back(index);
+        sift_up(heap_.size() - 1);
+    }
+
+    void pop() {
+        //precondition: ! empty()
+        erase(top());
+    }
+
+    void erase(index_t index) {
+        //precondition: contains(index)
+        auto const position = positions_[index];
+        auto const last = heap_.back();
+        heap_.pop_back();
+        positions_[index] = null_index;
+
+        if (last != index) {
+            heap_[position] = last;
+            sift_down(sift_up(position));
+        }
+    }
+
+    // Restores the order after the key of index changed.
+    void update(index_t index) {
+        //precondition: contains(index)
+        sift_down(sift_up(positions_[index]));
+    }
+
+private:
+    void place(index_t index, size_t position) {
+        heap_[position] = index;
+        positions_[index] = position;
+    }
+
+    size_t sift_up(size_t position) {
+        auto const index = heap_[position];
+        while (position > 0) {
+            auto const parent = (position - 1) / 2;
+            if ( ! cmp_(heap_[parent], index)) {
+                break;
+            }
+            place(heap_[parent], position);
+            position = parent;
+        }
+        place(index, position);
+        return position;
+    }
+
+    size_t sift_down(size_t position) {
+        auto const index = heap_[position];
+        while (true) {
+            auto child = 2 * position + 1;
+            if (child >= heap_.size()) {
+                break;
+            }
+            if (child + 1 < heap_.size() && cmp_(heap_[child], heap_[child + 1])) {
+                ++child;
+            }
+            if ( ! cmp_(index, heap_[child])) {
+                break;
+            }
+            place(heap_[child], position);
+            position = child;
+        }
+        place(index, position);
+        return position;
+    }
+
+    Cmp cmp_;
+    indexes_t heap_;
+    indexes_t positions_;
+};
+
+}  // namespace mining
+}  // namespace kth
+
+#endif  //KTH_BLOCKCHAIN_MINING_INDEXED_HEAP_HPP_
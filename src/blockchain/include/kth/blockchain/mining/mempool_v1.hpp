@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <map>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -20,11 +22,13 @@
 
 // #include <boost/bimap.hpp>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/node_v1.hpp>
-#include <kth/mining/prioritizer.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/indexed_heap.hpp>
+#include <kth/blockchain/mining/node_v1.hpp>
+#include <kth/blockchain/mining/prioritizer.hpp>
 
 #include <kth/domain.hpp>
+#include <kth/infrastructure/math/sip_hash.hpp>
 
 
 template <typename F>
@@ -48,13 +52,28 @@ node make_node(domain::chain::transaction const& tx) {
 #if ! defined(KTH_CURRENCY_BCH)
                                   , tx.hash(true)
 #endif
-                                  , tx.to_data(true, KTH_WITNESS_DEFAULT)
+                                  , tx.to_data(true)
                                   , tx.fees()
                                   , tx.signature_operations()
                                   , tx.outputs().size())
                         );
 }
 
+// The content of a free slot of the pool.
+inline
+node make_free_node() {
+    return node(
+                transaction_element(null_hash
+#if ! defined(KTH_CURRENCY_BCH)
+                                  , null_hash
+#endif
+                                  , data_chunk{}
+                                  , 0
+                                  , 0
+                                  , 0)
+                        );
+}
+
 #ifdef KTH_MINING_STATISTICS_ENABLED
 template <typename F>
 void measure(F f, measurements_t& t) {
@@ -86,22 +105,17 @@ using all_transactions_t = std::vector<node>;
 
 
 #if defined(KTH_CURRENCY_BCH)
-inline
-void sort_ctor(all_transactions_t& all, std::vector<size_t>& candidates) {
-    auto const cmp = [&all](index_t ia, index_t ib) {
-        auto const& a = all[ia];
-        auto const& b = all[ib];
-        return std::lexicographical_compare(a.txid().rbegin(), a.txid().rend(),
-                                            b.txid().rbegin(), b.txid().rend());
-    };
-    // candidates.sort(cmp);
-    std::sort(std::begin(candidates), std::end(candidates), cmp);
-}
+// Canonical transaction ordering (CTOR): the txids as little endian numbers.
+struct ctor_less {
+    bool operator()(hash_digest const& a, hash_digest const& b) const {
+        return std::lexicographical_compare(a.rbegin(), a.rend(), b.rbegin(), b.rend());
+    }
+};
 
 #else
 
 inline
-void sort_ltor(bool sorted, all_transactions_t& all, std::vector<size_t>& candidates) {
+void sort_ltor(bool sorted, all_transactions_t const& all, std::vector<size_t>& candidates) {
 
     if ( ! sorted) {
         auto const cmp = [&all](index_t ia, index_t ib) {
@@ -313,13 +327,32 @@ public:
     using internal_utxo_set_t = std::unordered_map<domain::chain::point, domain::chain::output>;
     using previous_outputs_t = std::unordered_map<domain::chain::point, index_t>;
     using hash_index_t = std::unordered_map<hash_digest, std::pair<index_t, domain::chain::transaction>>;
+    using prevout_validations_t = std::vector<domain::chain::output_point::validation_type>;
+    using validated_subset_t = std::unordered_map<hash_digest, prevout_validations_t>;
+    using short_id_index_t = std::unordered_map<uint64_t, uint16_t>;
+    using block_template_t = std::pair<std::vector<transaction_element>, uint64_t>;
+    using block_template_ptr = std::shared_ptr<block_template_t const>;
+
+    struct arrival_links_t {
+        index_t previous = null_index;
+        index_t next = null_index;
+    };
+
+    // The waiting transaction with the best fee per byte goes on top.
+    struct waiting_cmp {
+        mempool const* pool;
+
+        bool operator()(index_t a, index_t b) const {
+            return pool->fee_per_size_cmp(b, a);
+        }
+    };
 
     // using mutex_t = boost::shared_mutex;
     // using shared_lock_t = boost::shared_lock<mutex_t>;
     // using unique_lock_t = boost::unique_lock<mutex_t>;
     // using upgrade_lock_t = boost::upgrade_lock<mutex_t>;
 
-    static constexpr size_t max_template_size_default = get_max_block_weight() - coinbase_reserved_size;
+    static constexpr size_t max_template_size_default = static_max_block_size_network_independent() - coinbase_reserved_size;
 
 #if defined(KTH_CURRENCY_BCH)
     static constexpr size_t mempool_size_multiplier_default = 10;
@@ -333,9 +366,11 @@ public:
     mempool(size_t max_template_size = max_template_size_default, size_t mempool_size_multiplier = mempool_size_multiplier_default)
         : max_template_size_(max_template_size)
         // , mempool_size_multiplier_(mempool_size_multiplier)
-        , mempool_total_size_(get_max_block_weight() * mempool_size_multiplier)
-        // , sorted_(false) {
-        BOOST_ASSERT(max_template_size <= get_max_block_weight()); //TODO(fernando): what happend in BTC with SegWit.
+        , mempool_total_size_(static_max_block_size_network_independent() * mempool_size_multiplier)
+        , waiting_transactions_(waiting_cmp{this})
+        // , sorted_(false)
+    {
+        BOOST_ASSERT(max_template_size <= static_max_block_size_network_independent()); //TODO(fernando): what happend in BTC with SegWit.
 
         size_t const candidates_capacity = max_template_size_ / min_transaction_size_for_capacity;
         size_t const all_capacity = mempool_total_size_ / min_transaction_size_for_capacity;
@@ -383,10 +418,10 @@ public:
         //              tx is fully validated: check() && accept() && connect()
         //              ! tx.is_coinbase()
 
-        // std::cout << encode_base16(tx.to_data(true, KTH_WITNESS_DEFAULT)) << std::endl;
+        // std::cout << encode_base16(tx.to_data(true)) << std::endl;
 
         return prioritizer_.low_job([this, &tx]{
-            auto const index = all_transactions_.size();
+            auto const index = next_slot();
 
             auto start = std::chrono::high_resolution_clock::now();
             auto temp_node = make_node(tx);
@@ -403,18 +438,21 @@ public:
             }
 
             start = std::chrono::high_resolution_clock::now();
-            all_transactions_.push_back(std::move(temp_node));
+            occupy_slot(index, std::move(temp_node));
             end = std::chrono::high_resolution_clock::now();
             increment_time(start, end, all_transactions_push_back_time);
 
             // res = add_node(index);
-            node& inserted = all_transactions_.back();
+            node& inserted = all_transactions_[index];
 
             start = std::chrono::high_resolution_clock::now();
             res = insert_candidate(index, inserted);
             end = std::chrono::high_resolution_clock::now();
             increment_time(start, end, insert_candidate_time);
 
+            if (inserted.candidate_index() == null_index) {
+                waiting_transactions_.push(index);
+            }
 
     #ifndef NDEBUG
             check_invariant();
@@ -482,6 +520,7 @@ public:
                 candidate_transactions_.push_back(candidate_index_t{main_index});
                 auto cand_index = candidate_transactions_.size() - 1;
                 inserted.set_candidate_index(cand_index);
+                candidate_inserted(main_index);
                 accumulate_non_sorted(inserted);
                 return error::success;
             }
@@ -523,12 +562,12 @@ public:
         // precondition: [f, l) is a valid non-empty range
         //               there are no coinbase transactions in the range
 
-        if (all_transactions_.empty()) {
+        if (pool_size() == 0) {
             return error::success;
         }
 
         // std::cout << "Arrive Block -------------------------------------------------------------------" << std::endl;
-        // std::cout << encode_base16(tx.to_data(true, KTH_WITNESS_DEFAULT)) << std::endl;
+        // std::cout << encode_base16(tx.to_data(true)) << std::endl;
 
 
         processing_block_ = true;
@@ -570,21 +609,26 @@ public:
 
             find_double_spend_issues(to_remove, outs);
 
+            // Only the removed transactions and the candidates that depend on
+            // them are touched, the rest of the pool is left as it is.
+            remove_from_candidates(to_remove);
 
-            //TODO(fernando): process batches of adjacent elements
+            // The indexes of the remaining transactions do not change.
             for (auto i : to_remove) {
-                auto it = std::next(all_transactions_.begin(), i);
-                hash_index_.erase(it->txid());
-                remove_from_utxo(it->txid(), it->output_count());
-
-                if (i < all_transactions_.size() - 1) {
-                    reindex_relatives(i + 1);
+                auto const& node = all_transactions_[i];
+                auto it = hash_index_.find(node.txid());
+                for (auto const& input : it->second.second.inputs()) {
+                    auto po = previous_outputs_.find(input.previous_output());
+                    if (po != previous_outputs_.end() && po->second == i) {
+                        previous_outputs_.erase(po);
+                    }
                 }
-
-                all_transactions_.erase(it);
+                hash_index_.erase(it);
+                remove_from_utxo(node.txid(), node.output_count());
+                free_slot(i);
             }
 
-            BOOST_ASSERT(all_transactions_.size() == hash_index_.size());
+            BOOST_ASSERT(pool_size() == hash_index_.size());
 
 // #ifndef NDEBUG
 //             auto diff = old_transactions.size() - all_transactions_.size();
@@ -632,43 +676,7 @@ public:
 // #endif
 
 
-            sorted_ = false;
-            candidate_transactions_.clear();
-            previous_outputs_.clear();
-
-            accum_fees_ = 0;
-            accum_size_ = 0;
-            accum_sigops_ = 0;
-
-            // for (size_t i = 0; i < all_transactions_.size(); ++i) {
-            //     all_transactions_[i].set_candidate_index(null_index);
-            //     all_transactions_[i].reset_children_values();
-            // }
-
-            for (auto& atx : all_transactions_) {
-                atx.set_candidate_index(null_index);
-                atx.reset_children_values();
-            }
-
-// #ifndef NDEBUG
-//             check_invariant();
-// #endif
-
-            for (size_t i = 0; i < all_transactions_.size(); ++i) {
-
-                auto it = hash_index_.find(all_transactions_[i].txid());
-                if (it != hash_index_.end()) {
-                    // if (it->second.first != i) {
-                    //     std::cout << "pepe\n";
-                    // }
-                    it->second.first = i;
-                }
-
-                re_add_node(i);
-// #ifndef NDEBUG
-//                 check_invariant();
-// #endif
-            }
+            promote_waiting();
 
 #ifndef NDEBUG
             check_invariant();
@@ -688,7 +696,7 @@ public:
     size_t all_transactions() const {
         // shared_lock_t lock(mutex_);
         return prioritizer_.low_job([this]{
-            return all_transactions_.size();
+            return pool_size();
         });
     }
 
@@ -729,9 +737,77 @@ public:
         });
     }
 
-    hash_index_t get_validated_txs_high() const {
-        return prioritizer_.high_job([this]{
-            return hash_index_;
+    // Membership of each of the given txids, in a single job and without
+    // copying the pool.
+    std::vector<bool> contains(hash_list const& txids) const {
+        return prioritizer_.low_job([&txids, this]{
+            std::vector<bool> res;
+            res.reserve(txids.size());
+            for (auto const& txid : txids) {
+                res.push_back(hash_index_.find(txid) != hash_index_.end());
+            }
+            return res;
+        });
+    }
+
+    // Looks up the given transactions in the pool without copying it.
+    // Only the prevout validation data of the ones found is returned.
+    validated_subset_t get_validated_subset_high(domain::chain::transaction::list const& txs) const {
+        return prioritizer_.high_job([&txs, this]{
+            validated_subset_t res;
+            for (auto const& tx : txs) {
+                auto it = hash_index_.find(tx.hash());
+                if (it == hash_index_.end()) {
+                    continue;
+                }
+
+                auto const& inputs = it->second.second.inputs();
+                prevout_validations_t prevouts;
+                prevouts.reserve(inputs.size());
+                for (auto const& i : inputs) {
+                    prevouts.push_back(i.previous_output().validation);
+                }
+                res.emplace(it->first, std::move(prevouts));
+            }
+            return res;
+        });
+    }
+
+    // Fills the slots of a compact block (bip152) with the pool transactions
+    // whose short id, under the (k0, k1) key of the block, maps to them. The
+    // short ids of the whole pool are computed in one batch. A slot matched by
+    // two transactions is left empty, to be requested from the peer.
+    // Returns the number of slots filled.
+    size_t fill_compact_block_high(uint64_t k0, uint64_t k1, short_id_index_t const& short_ids, domain::chain::transaction::list& txs) const {
+        return prioritizer_.high_job([k0, k1, &short_ids, &txs, this]{
+            std::vector<uint64_t> ids(txids_.size());
+            sip_hash_uint256(k0, k1, txids_.data(), txids_.size(), ids.data());
+
+            std::vector<bool> have(txs.size());
+            size_t filled = 0;
+            for (size_t i = 0; i < ids.size(); ++i) {
+                auto const found = short_ids.find(ids[i] & uint64_t(0xffffffffffff));
+                if (found == short_ids.end()) {
+                    continue;
+                }
+
+                // A free slot of the pool has no transaction.
+                auto const tx = hash_index_.find(txids_[i]);
+                if (tx == hash_index_.end()) {
+                    continue;
+                }
+
+                auto const slot = found->second;
+                if ( ! have[slot]) {
+                    txs[slot] = tx->second.second;
+                    have[slot] = true;
+                    ++filled;
+                } else if (txs[slot].is_valid()) {
+                    txs[slot] = domain::chain::transaction{};
+                    --filled;
+                }
+            }
+            return filled;
         });
     }
 
@@ -765,60 +841,19 @@ public:
         });
     }
 
-    std::pair<std::vector<transaction_element>, uint64_t> get_block_template() const {
-        //TODO(fernando): implement a cache, outside
-
+    // The candidates in block order and their fees. The snapshot is shared by
+    // every caller until the candidate set changes.
+    block_template_ptr get_block_template() const {
         if (processing_block_) {
-            return {};
+            return std::make_shared<block_template_t const>();
         }
 
-        auto copied_data = prioritizer_.high_job([this] {
-            std::vector<size_t> candidates;
-            candidates.reserve(candidate_transactions_.size());
-            std::transform(std::begin(candidate_transactions_), std::end(candidate_transactions_), std::back_inserter(candidates),
-                   [](candidate_index_t const& x) {
-                       return x.index();
-                    }
-            );
-
-            return make_tuple(std::move(candidates), all_transactions_, accum_fees_, sorted_);
-            // return make_tuple(candidate_transactions_, all_transactions_, accum_fees_);
+        return prioritizer_.high_job([this] {
+            if ( ! block_template_) {
+                block_template_ = make_block_template();
+            }
+            return block_template_;
         });
-
-        auto& candidates = std::get<0>(copied_data);
-        auto& all = std::get<1>(copied_data);
-        auto accum_fees = std::get<2>(copied_data);
-        auto sorted = std::get<3>(copied_data);
-
-// #if defined(KTH_CURRENCY_BCH)
-
-//         auto const cmp = [this](size_t a, size_t b) {
-//             return ctor_cmp(a, b);
-//         };
-
-//         // start = chrono::high_resolution_clock::now();
-//         std::sort(std::begin(candidates), std::end(candidates), cmp);
-//         // end = chrono::high_resolution_clock::now();
-//         // auto sort_time = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
-// #else
-//         sort_ltor(all, candidates);
-// #endif
-
-#if defined(KTH_CURRENCY_BCH)
-        sort_ctor(all, candidates);
-#else
-        sort_ltor(sorted, all, candidates);
-#endif
-
-
-        std::vector<transaction_element> res;
-        res.reserve(candidates.size());
-
-        for (auto i : candidates) {
-            res.push_back(std::move(all[i].element()));
-        }
-
-        return {std::move(res), accum_fees};
     }
 
     domain::chain::output get_utxo(domain::chain::point const& point) const {
@@ -919,23 +954,43 @@ public:
 
         //TODO(fernando): replicate this invariant test in V2
         {
-            for (size_t i = 0; i < all_transactions_.size(); ++i) {
+            size_t live = 0;
+            for (auto i = first_arrival_; i != null_index; i = arrival_[i].next) {
                 auto it = hash_index_.find(all_transactions_[i].txid());
                 BOOST_ASSERT(it != hash_index_.end());
                 BOOST_ASSERT(it->second.first == i);
+                BOOST_ASSERT(txids_[i] == all_transactions_[i].txid());
+                ++live;
             }
+            BOOST_ASSERT(live == pool_size());
+            BOOST_ASSERT(live == hash_index_.size());
+#if defined(KTH_CURRENCY_BCH)
+            BOOST_ASSERT(ctor_candidates_.size() == candidate_transactions_.size());
+#endif
+
+            for (auto i : free_slots_) {
+                BOOST_ASSERT(txids_[i] == null_hash);
+                BOOST_ASSERT(all_transactions_[i].candidate_index() == null_index);
+                BOOST_ASSERT( ! waiting_transactions_.contains(i));
+            }
+
+            for (auto i = first_arrival_; i != null_index; i = arrival_[i].next) {
+                auto const waiting = all_transactions_[i].candidate_index() == null_index;
+                BOOST_ASSERT(waiting_transactions_.contains(i) == waiting);
+            }
+            BOOST_ASSERT(waiting_transactions_.size() + candidate_transactions_.size() == pool_size());
+            BOOST_ASSERT(sorted_ || waiting_transactions_.empty());
         }
 
         {
-            size_t i = 0;
-            for (auto const& node : all_transactions_) {
+            for (auto i = first_arrival_; i != null_index; i = arrival_[i].next) {
+                auto const& node = all_transactions_[i];
                 if (node.candidate_index() != null_index) {
                     for (auto pi : node.parents()) {
                         auto const& parent = all_transactions_[pi];
                         BOOST_ASSERT(parent.candidate_index() != null_index);
                     }
                 }
-                ++i;
             }
         }
 
@@ -950,10 +1005,8 @@ public:
         }
 
         {
-            size_t i = 0;
-            for (auto const& node : all_transactions_) {
+            for (auto i = first_arrival_; i != null_index; i = arrival_[i].next) {
                 check_children_accum(i);
-                ++i;
             }
         }
 
@@ -1180,6 +1233,7 @@ public:
             }
 
             BOOST_ASSERT(candidate_transactions_.size() + non_indexed == all_transactions_.size());
+            BOOST_ASSERT(non_indexed >= free_slots_.size());
         }
     }
 
@@ -1191,42 +1245,96 @@ public:
 
 private:
 
-    void reindex_relatives(size_t index) {
+    size_t pool_size() const {
+        return all_transactions_.size() - free_slots_.size();
+    }
 
-        for (auto& node : all_transactions_) {
+    // The slot of the next transaction, a free one if there is any.
+    index_t next_slot() const {
+        return free_slots_.empty() ? all_transactions_.size() : free_slots_.back();
+    }
 
-            for (auto& ci : node.children()) {
-                if (ci >= index) {
-                    --ci;
-                }
-            }
+    void occupy_slot(index_t index, node&& x) {
+        if (index == all_transactions_.size()) {
+            txids_.push_back(x.txid());
+            all_transactions_.push_back(std::move(x));
+            arrival_.emplace_back();
+        } else {
+            BOOST_ASSERT(index == free_slots_.back());
+            free_slots_.pop_back();
+            txids_[index] = x.txid();
+            all_transactions_[index] = std::move(x);
+        }
 
-            for (auto& pi : node.parents()) {
-                if (pi >= index) {
-                    --pi;
-                }
-            }
+        arrival_[index] = {last_arrival_, null_index};
+        if (last_arrival_ == null_index) {
+            first_arrival_ = index;
+        } else {
+            arrival_[last_arrival_].next = index;
         }
+        last_arrival_ = index;
     }
 
-    void re_add_node(index_t index) {
-        auto& elem = all_transactions_[index];
+    void free_slot(index_t index) {
+        auto const links = arrival_[index];
+        if (links.previous == null_index) {
+            first_arrival_ = links.next;
+        } else {
+            arrival_[links.previous].next = links.next;
+        }
 
-        auto it = hash_index_.find(elem.txid());
-        if (it != hash_index_.end()) {
+        if (links.next == null_index) {
+            last_arrival_ = links.previous;
+        } else {
+            arrival_[links.next].previous = links.previous;
+        }
 
-            it->second.first = index;
-            auto const& tx = it->second.second;
+        // Releases the raw transaction and the relatives of the node.
+        all_transactions_[index] = make_free_node();
+        txids_[index] = null_hash;
+        free_slots_.push_back(index);
+    }
 
-            for (auto const& i : tx.inputs()) {
-                previous_outputs_.insert({i.previous_output(), index});
-            }
-            // add_node(index);
-            insert_candidate(index, elem);
-        } else {
-            //No debería pasar por aca
-            BOOST_ASSERT(false);
+    // Keeps the block order of the candidates and drops the last template.
+    void candidate_inserted(index_t index) {
+#if defined(KTH_CURRENCY_BCH)
+        ctor_candidates_.emplace(all_transactions_[index].txid(), index);
+#endif
+        block_template_.reset();
+    }
+
+    void candidate_removed(index_t index) {
+#if defined(KTH_CURRENCY_BCH)
+        ctor_candidates_.erase(all_transactions_[index].txid());
+#endif
+        block_template_.reset();
+    }
+
+    block_template_ptr make_block_template() const {
+        std::vector<transaction_element> elements;
+        elements.reserve(candidate_transactions_.size());
+
+#if defined(KTH_CURRENCY_BCH)
+        for (auto const& candidate : ctor_candidates_) {
+            elements.push_back(all_transactions_[candidate.second].element());
+        }
+#else
+        std::vector<size_t> candidates;
+        candidates.reserve(candidate_transactions_.size());
+        std::transform(std::begin(candidate_transactions_), std::end(candidate_transactions_), std::back_inserter(candidates),
+               [](candidate_index_t const& x) {
+                   return x.index();
+                }
+        );
+
+        sort_ltor(sorted_, all_transactions_, candidates);
+
+        for (auto i : candidates) {
+            elements.push_back(all_transactions_[i].element());
         }
+#endif
+
+        return std::make_shared<block_template_t const>(std::move(elements), accum_fees_);
     }
 
     error::error_code_t add_node(index_t index) {
@@ -1433,11 +1541,20 @@ private:
         //TODO(fernando): reindex_parents_for_removal_time
         reindex_parents_for_removal(to_remove);
 
-
+        for (auto i : to_remove) {
+            waiting_transactions_.push(i);
+        }
     }
 
     void do_candidates_insertion(to_insert_t const& to_insert) {
 
+        // Before their fees are accumulated, which is the key of the heap.
+        for (auto i : std::get<0>(to_insert)) {
+            if (waiting_transactions_.contains(i)) {
+                waiting_transactions_.erase(i);
+            }
+        }
+
         for (auto i : std::get<0>(to_insert)) {
             insert_in_candidate(i, std::get<0>(to_insert));
 
@@ -1451,6 +1568,92 @@ private:
         accum_sigops_ += std::get<3>(to_insert);
     }
 
+    // Takes the transactions removed from the pool out of the candidates or
+    // the waiting transactions, and updates every ancestor left in the pool.
+    void remove_from_candidates(std::set<index_t, std::greater<>> const& to_remove) {
+        // The removed transactions, and whether each one was a candidate.
+        std::vector<std::pair<index_t, bool>> removed;
+        bool any_candidate = false;
+        for (auto i : to_remove) {
+            if (waiting_transactions_.contains(i)) {
+                waiting_transactions_.erase(i);
+                removed.emplace_back(i, false);
+                continue;
+            }
+
+            auto& node = all_transactions_[i];
+            if ( ! sorted_) {
+                // The order of the candidates does not matter yet.
+                using std::swap;
+                swap(candidate_transactions_[node.candidate_index()], candidate_transactions_.back());
+                candidate_transactions_.pop_back();
+            }
+            node.set_candidate_index(null_index);
+            candidate_removed(i);
+
+            accum_fees_ -= node.fee();
+            accum_size_ -= node.size();
+            accum_sigops_ -= node.sigops();
+            removed.emplace_back(i, true);
+            any_candidate = true;
+        }
+
+        if (sorted_ && any_candidate) {
+            // One pass for the whole block, the order of the rest is kept.
+            candidate_indexes_t kept;
+            kept.reserve(candidate_transactions_.capacity());
+            for (auto const& ci : candidate_transactions_) {
+                auto& node = all_transactions_[ci.index()];
+                if (node.candidate_index() != null_index) {
+                    node.set_candidate_index(kept.size());
+                    kept.push_back(candidate_index_t{ci.index()});
+                }
+            }
+            candidate_transactions_ = std::move(kept);
+        }
+
+        for (auto const& [i, was_candidate] : removed) {
+            auto const& node = all_transactions_[i];
+            for (auto pi : node.parents()) {
+                if (to_remove.count(pi) != 0) {
+                    continue;
+                }
+
+                auto& parent = all_transactions_[pi];
+                parent.remove_child(i);
+
+                if (parent.candidate_index() == null_index) {
+                    // A waiting transaction is scored by its own values only.
+                    parent.reset_children_values();
+                    waiting_transactions_.update(pi);
+                } else if (was_candidate) {
+                    if (sorted_) {
+                        reindex_parent_for_removal(node, parent, pi);
+                    } else {
+                        parent.decrement_values(node.fee(), node.size(), node.sigops());
+                    }
+                }
+            }
+        }
+    }
+
+    // Fills the room left in the candidates with the best waiting
+    // transactions, each one with the ancestors it needs.
+    void promote_waiting() {
+        while ( ! waiting_transactions_.empty()) {
+            auto const to_insert = what_to_insert(waiting_transactions_.top());
+            if ( ! has_room_for(std::get<2>(to_insert), std::get<3>(to_insert))) {
+                break;
+            }
+            do_candidates_insertion(to_insert);
+        }
+
+        // Everything fits again, the candidates are taken in arrival order.
+        if (waiting_transactions_.empty()) {
+            sorted_ = false;
+        }
+    }
+
     bool has_room_for(size_t size, size_t sigops) const {
         if (accum_size_ > max_template_size_ - size) {
             return false;
@@ -1656,6 +1859,7 @@ private:
             auto& node = all_transactions_[ci];
             node.set_candidate_index(null_index);
             node.reset_children_values();
+            candidate_removed(ci);
 
             accum_size_ -= node.size();
             accum_sigops_ -= node.sigops();
@@ -1708,6 +1912,7 @@ private:
 
         all_transactions_[ci].set_candidate_index(null_index);
         all_transactions_[ci].reset_children_values();
+        candidate_removed(ci);
 
         // std::cout << "++++++++++++++++++++++++++++++++++" << std::endl;
         // print_candidates();
@@ -2104,6 +2309,7 @@ private:
         if (it == std::end(candidate_transactions_)) {
             node.set_candidate_index(candidate_transactions_.size());
             candidate_transactions_.push_back(candidate_index_t{node_index});
+            candidate_inserted(node_index);
 #ifndef NDEBUG
             check_invariant_consistency_partial();
 #endif
@@ -2133,6 +2339,7 @@ private:
 
             // start = std::chrono::high_resolution_clock::now();
             candidate_transactions_.insert(it, candidate_index_t{node_index});
+            candidate_inserted(node_index);
             // end = std::chrono::high_resolution_clock::now();
             // time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
             // insert_time += time_ns;
@@ -2170,9 +2377,29 @@ private:
     //TODO(fernando): chequear el anidamiento de TX con su máximo (25??) y si es regla de consenso.
 
     internal_utxo_set_t internal_utxo_set_;
+    // all_transactions_ is a slab: a removed transaction leaves a free slot
+    // for the next one, so the indexes held by the graph, the candidates and
+    // hash_index_ never move and removing a transaction does not renumber the
+    // rest. The live slots are linked in arrival order.
     all_transactions_t all_transactions_;
+    indexes_t free_slots_;
+    std::vector<arrival_links_t> arrival_;
+    index_t first_arrival_ = null_index;
+    index_t last_arrival_ = null_index;
     hash_index_t hash_index_;
+
+    // The txids of all_transactions_, by index, contiguous to be hashed in batches.
+    hash_list txids_;
     candidate_indexes_t candidate_transactions_;
+    // The transactions of the pool that are not candidates. There are none
+    // until the candidates are sorted.
+    indexed_heap<waiting_cmp> waiting_transactions_;
+#if defined(KTH_CURRENCY_BCH)
+    // The candidates in block order, kept on every insertion and removal.
+    std::map<hash_digest, index_t, ctor_less> ctor_candidates_;
+#endif
+    // The last block template, dropped when the candidates change.
+    mutable block_template_ptr block_template_;
     bool sorted_ {false};
 
     previous_outputs_t previous_outputs_;
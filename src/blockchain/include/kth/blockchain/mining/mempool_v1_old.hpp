@@ -15,9 +15,9 @@
 
 // #include <boost/bimap.hpp>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/node_v1.hpp>
-#include <kth/mining/prioritizer.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/node_v1.hpp>
+#include <kth/blockchain/mining/prioritizer.hpp>
 
 #include <kth/domain.hpp>
 
@@ -13,11 +13,11 @@
 #include <unordered_set>
 #include <vector>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/node_v2.hpp>
-#include <kth/mining/prioritizer.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/node_v2.hpp>
+#include <kth/blockchain/mining/prioritizer.hpp>
 
-#include <kth/mining/partially_indexed.hpp>
+#include <kth/blockchain/mining/partially_indexed.hpp>
 
 #include <kth/domain.hpp>
 
@@ -7,8 +7,8 @@
 
 #include <kth/domain.hpp>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/transaction_element.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/transaction_element.hpp>
 
 namespace kth {
 namespace mining {
@@ -34,6 +34,10 @@ public:
         return std::move(te_);
     }
 
+    transaction_element const& element() const {
+        return te_;
+    }
+
     hash_digest const& txid() const {
         return te_.txid();
     }
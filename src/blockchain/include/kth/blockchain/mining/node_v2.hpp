@@ -7,8 +7,8 @@
 
 #include <kth/domain.hpp>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/transaction_element.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/transaction_element.hpp>
 
 namespace kth {
 namespace mining {
@@ -8,8 +8,8 @@
 #include <list>
 #include <vector>
 
-#include <kth/mining/common.hpp>
-#include <kth/mining/partially_indexed_node.hpp>
+#include <kth/blockchain/mining/common.hpp>
+#include <kth/blockchain/mining/partially_indexed_node.hpp>
 
 #include <kth/domain.hpp>
 
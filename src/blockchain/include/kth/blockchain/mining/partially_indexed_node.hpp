@@ -8,7 +8,7 @@
 #include <list>
 #include <vector>
 
-#include <kth/mining/common.hpp>
+#include <kth/blockchain/mining/common.hpp>
 
 #include <kth/domain.hpp>
 
@@ -34,7 +34,8 @@ public:
         , fee_(fee)
         , sigops_(sigops)
         , output_count_(output_count)
-        // , previous_outputs_(previous_outputs) {}
+        // , previous_outputs_(previous_outputs)
+    {}
 
     transaction_element(hash_digest const& txid,
 #if ! defined(KTH_CURRENCY_BCH)
@@ -54,7 +55,8 @@ public:
         , fee_(fee)
         , sigops_(sigops)
         , output_count_(output_count)
-        // , previous_outputs_(std::move(previous_outputs)) {}
+        // , previous_outputs_(std::move(previous_outputs))
+    {}
 
     hash_digest const& txid() const {
         return txid_;
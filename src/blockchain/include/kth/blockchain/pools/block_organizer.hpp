@@ -6,9 +6,14 @@
 #define KTH_BLOCKCHAIN_BLOCK_ORGANIZER_HPP
 
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <semaphore>
+#include <set>
 
 #include <kth/blockchain/define.hpp>
 #include <kth/blockchain/interface/fast_chain.hpp>
@@ -35,15 +40,24 @@ public:
 
     /// Construct an instance.
 #if defined(KTH_WITH_MEMPOOL)
-    block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, domain::config::network network, bool relay_transactions, mining::mempool& mp);
+    block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions, mining::mempool& mp);
 #else
-    block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, domain::config::network network, bool relay_transactions);
+    block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions);
 #endif
 
     bool start();
     bool stop();
 
+    /// The blocks in each stage of the organize pipeline.
+    struct pipeline_occupancy {
+        size_t check;
+        size_t prefetch;
+        size_t wait;
+        size_t organize;
+    };
+
     void organize(block_const_ptr block, result_handler handler);
+    pipeline_occupancy occupancy() const;
     void subscribe(reorganize_handler&& handler);
     void unsubscribe();
 
@@ -57,6 +71,15 @@ private:
     // Utility.
     bool set_branch_height(branch::ptr branch);
 
+    // Pipeline stages before the critical section.
+    code check(block_const_ptr block) const;
+    void prefetch(block_const_ptr block) const;
+
+    // Turns of the critical section, in the order the blocks took a slot.
+    uint64_t take_ticket();
+    bool wait_turn(uint64_t ticket);
+    void end_turn(uint64_t ticket);
+
     // Verify sub-sequence.
     void handle_check(code const& ec, block_const_ptr block, result_handler handler);
     void handle_accept(code const& ec, branch::ptr branch, result_handler handler);
@@ -90,6 +113,16 @@ private:
     prioritized_mutex& mutex_;
     std::atomic<bool> stopped_;
     std::promise<code> resume_;
+    std::counting_semaphore<> pipeline_slots_;
+    std::atomic<size_t> checking_{0};
+    std::atomic<size_t> prefetching_{0};
+    std::atomic<size_t> waiting_{0};
+    std::atomic<size_t> organizing_{0};
+    std::mutex turn_mutex_;
+    std::condition_variable turn_;
+    uint64_t next_ticket_ = 0;
+    uint64_t next_turn_ = 0;
+    std::set<uint64_t> ended_turns_;
     dispatcher& dispatch_;
     block_pool block_pool_;
     validate_block validator_;
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <future>
 #include <memory>
+#include <semaphore>
 
 #include <kth/blockchain/define.hpp>
 #include <kth/blockchain/interface/fast_chain.hpp>
@@ -23,7 +24,7 @@
 #include <kth/infrastructure/utility/resubscriber.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 
 #endif
 
@@ -46,9 +47,9 @@ public:
     /// Construct an instance.
 
 #if defined(KTH_WITH_MEMPOOL)
-    transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, mining::mempool& mp);
+    transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, mining::mempool& mp);
 #else
-    transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings);
+    transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts);
 #endif
 
     bool start();
@@ -73,6 +74,9 @@ protected:
     uint64_t price(transaction_const_ptr tx) const;
 
 private:
+    // Verification outside of the critical section.
+    code verify(transaction_const_ptr tx) const;
+
     // Verify sub-sequence.
     void handle_check(code const& ec, transaction_const_ptr tx, result_handler handler);
     void handle_accept(code const& ec, transaction_const_ptr tx, result_handler handler);
@@ -99,6 +103,7 @@ private:
     prioritized_mutex& mutex_;
     std::atomic<bool> stopped_;
     std::promise<code> resume_;
+    std::counting_semaphore<> pipeline_slots_;
     settings const& settings_;
     dispatcher& dispatch_;
     transaction_pool transaction_pool_;
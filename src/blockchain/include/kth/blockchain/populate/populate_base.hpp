@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include <kth/blockchain/define.hpp>
 #include <kth/blockchain/interface/fast_chain.hpp>
@@ -25,6 +26,7 @@ protected:
     void populate_duplicate(size_t maximum_height, const domain::chain::transaction& tx, bool require_confirmed) const;
     void populate_pooled(domain::chain::transaction const& tx, uint32_t forks) const;
     void populate_prevout(size_t maximum_height, domain::chain::output_point const& outpoint, bool require_confirmed) const;
+    void populate_prevouts(size_t maximum_height, std::vector<domain::chain::output_point const*> const& outpoints) const;
 
     // This is thread safe.
     dispatcher& dispatch_;
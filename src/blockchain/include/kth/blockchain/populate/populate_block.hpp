@@ -6,6 +6,8 @@
 #define KTH_BLOCKCHAIN_POPULATE_BLOCK_HPP
 
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 #include <kth/blockchain/define.hpp>
 #include <kth/blockchain/interface/fast_chain.hpp>
@@ -14,7 +16,7 @@
 #include <kth/domain.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
@@ -23,6 +25,10 @@ namespace kth::blockchain {
 class BCB_API populate_block : public populate_base {
 public:
     using utxo_pool_t = database::internal_database::utxo_pool_t;
+    using utxo_pool_ptr = std::shared_ptr<utxo_pool_t const>;
+#if defined(KTH_WITH_MEMPOOL)
+    using validated_txs_ptr = std::shared_ptr<mining::mempool::validated_subset_t const>;
+#endif
 
 #if defined(KTH_WITH_MEMPOOL)
     populate_block(dispatcher& dispatch, fast_chain const& chain, bool relay_transactions, mining::mempool const& mp);
@@ -35,18 +41,19 @@ public:
 
 protected:
     using branch_ptr = branch::const_ptr;
+    using prevouts_t = std::vector<domain::chain::output_point const*>;
 
     void populate_coinbase(branch::const_ptr branch, block_const_ptr block) const;
     ////void populate_duplicate(branch_ptr branch, const domain::chain::transaction& tx) const;
 
     utxo_pool_t get_reorg_subset_conditionally(size_t first_height, size_t& out_chain_top) const;
     void populate_from_reorg_subset(domain::chain::output_point const& outpoint, utxo_pool_t const& reorg_subset) const;
-    void populate_transaction_inputs(branch::const_ptr branch, domain::chain::input::list const& inputs, size_t bucket, size_t buckets, size_t input_position, local_utxo_set_t const& branch_utxo, size_t first_height, size_t chain_top, utxo_pool_t const& reorg_subset) const;
+    void collect_prevouts(domain::chain::input::list const& inputs, size_t bucket, size_t buckets, size_t& input_position, prevouts_t& out_prevouts) const;
 
 #if defined(KTH_WITH_MEMPOOL)
-    void populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, mining::mempool::hash_index_t const& validated_txs, result_handler handler) const;
+    void populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, size_t chain_top, utxo_pool_ptr const& reorg_subset, validated_txs_ptr const& validated_txs, result_handler handler) const;
 #else
-    void populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, result_handler handler) const;
+    void populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, size_t chain_top, utxo_pool_ptr const& reorg_subset, result_handler handler) const;
 #endif
 
     void populate_prevout(branch_ptr branch, domain::chain::output_point const& outpoint, local_utxo_set_t const& branch_utxo) const;
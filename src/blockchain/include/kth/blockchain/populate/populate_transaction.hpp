@@ -13,7 +13,7 @@
 #include <kth/domain.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
@@ -18,7 +18,7 @@ namespace kth::blockchain {
 /// Common blockchain configuration settings, properties not thread safe.
 class BCB_API settings {
 public:
-    settings() = default;
+    settings();
     settings(domain::config::network net);
 
     /// Fork flags combiner.
@@ -34,6 +34,10 @@ public:
     uint32_t reorganization_limit = 256;
     infrastructure::config::checkpoint::list checkpoints;
     bool fix_checkpoints = true;
+    uint32_t signature_cache_mb = 32;
+    uint32_t script_cache_mb = 16;
+    uint32_t organize_pipeline_depth = 4;
+    uint32_t transaction_pipeline_depth = 16;
     bool allow_collisions = true;
     bool easy_blocks = false;
     bool retarget = true;
@@ -130,8 +134,9 @@ public:
 #endif //KTH_CURRENCY_BCH
 
 #if defined(KTH_WITH_MEMPOOL)
-    size_t mempool_max_template_size = mining::mempool::max_template_size_default;
-    size_t mempool_size_multiplier = mining::mempool::mempool_size_multiplier_default;
+    // Defaults set in settings.cpp, keeps mining/mempool.hpp out of this header.
+    size_t mempool_max_template_size;
+    size_t mempool_size_multiplier;
 #endif
 
 };
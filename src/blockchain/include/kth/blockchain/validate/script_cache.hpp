@@ -0,0 +1,71 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_BLOCKCHAIN_SCRIPT_CACHE_HPP
+#define KTH_BLOCKCHAIN_SCRIPT_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <kth/blockchain/define.hpp>
+#include <kth/domain.hpp>
+
+namespace kth::blockchain {
+
+/// Bounded set of inputs whose scripts are known to pass under a set of
+/// forks, together with the sigchecks they consumed. Written on mempool
+/// acceptance and read on block connect, so that scripts already verified
+/// in the mempool are not executed again. Keys are salted per process.
+/// This class is thread safe.
+class BCB_API script_cache {
+public:
+    static constexpr size_t default_size = 16 * 1024 * 1024;
+
+    explicit
+    script_cache(size_t max_bytes = default_size);
+
+    /// The sigchecks of a cached input, or nullopt if it is not cached.
+    std::optional<size_t> find(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks) const;
+
+    /// Record an input whose scripts have been verified successfully.
+    void store(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks, size_t sigchecks);
+
+    /// Cumulative counters.
+    uint64_t hits() const;
+    uint64_t misses() const;
+    size_t size() const;
+
+private:
+    using key_type = hash_digest;
+
+    struct shard {
+        mutable std::mutex mutex;
+        std::unordered_map<key_type, uint32_t> entries;
+        std::deque<key_type> order;
+    };
+
+    static constexpr size_t shard_count = 16;
+
+    // Approximate memory used by an entry (key, value, node and eviction order).
+    static constexpr size_t entry_size = 2 * sizeof(key_type) + sizeof(uint32_t) + 2 * sizeof(void*);
+
+    key_type compute_key(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks) const;
+    shard& shard_for(key_type const& key) const;
+
+    hash_digest salt_;
+    size_t const max_shard_entries_;
+    mutable std::array<shard, shard_count> shards_;
+    mutable std::atomic<uint64_t> hits_;
+    mutable std::atomic<uint64_t> misses_;
+};
+
+} // namespace kth::blockchain
+
+#endif
@@ -15,10 +15,11 @@
 #include <kth/blockchain/pools/branch.hpp>
 #include <kth/blockchain/populate/populate_block.hpp>
 #include <kth/blockchain/settings.hpp>
+#include <kth/blockchain/validate/script_cache.hpp>
 #include <kth/domain.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
@@ -29,9 +30,9 @@ public:
     using result_handler = handle0;
 
 #if defined(KTH_WITH_MEMPOOL)
-    validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, domain::config::network network, bool relay_transactions, mining::mempool const& mp);
+    validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions, mining::mempool const& mp);
 #else
-    validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, domain::config::network network, bool relay_transactions);
+    validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions);
 #endif
 
     void start();
@@ -48,11 +49,19 @@ protected:
     }
 
     float hit_rate() const;
+    float script_hit_rate() const;
 
 private:
     using atomic_counter = std::atomic<size_t>;
     using atomic_counter_ptr = std::shared_ptr<atomic_counter>;
 
+    // Script verifiers of the block transactions, built on first use.
+    class verifier_list;
+
+    // Inputs to verify and state shared by the connect tasks of a block.
+    struct connect_job;
+    using connect_job_ptr = std::shared_ptr<connect_job>;
+
     static
     void dump(code const& ec, const domain::chain::transaction& tx, uint32_t input_index, uint32_t forks, size_t height);
 
@@ -61,16 +70,19 @@ private:
     void handle_populated(code const& ec, block_const_ptr block, result_handler handler) const;
     void accept_transactions(block_const_ptr block, size_t bucket, size_t buckets, atomic_counter_ptr sigops, bool bip16, bool bip141, result_handler handler) const;
     void handle_accepted(code const& ec, block_const_ptr block, atomic_counter_ptr sigops, bool bip141, result_handler handler) const;
-    void connect_inputs(block_const_ptr block, size_t bucket, size_t buckets, result_handler handler) const;
-    void handle_connected(code const& ec, block_const_ptr block, result_handler handler) const;
+    void connect_inputs(block_const_ptr block, connect_job_ptr job, result_handler handler) const;
+    void handle_connected(code const& ec, block_const_ptr block, connect_job_ptr job, result_handler handler) const;
 
     // These are thread safe.
     std::atomic<bool> stopped_;
     fast_chain const& fast_chain_;
     domain::config::network network_;
     dispatcher& priority_dispatch_;
+    script_cache& script_cache_;
     mutable atomic_counter hits_;
     mutable atomic_counter queries_;
+    mutable atomic_counter script_hits_;
+    mutable atomic_counter script_queries_;
 
     // Caller must not invoke accept/connect concurrently.
     populate_block block_populator_;
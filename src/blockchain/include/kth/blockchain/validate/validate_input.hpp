@@ -6,6 +6,8 @@
 #define KTH_BLOCKCHAIN_VALIDATE_INPUT_HPP
 
 #include <cstdint>
+#include <memory>
+#include <utility>
 
 #include <kth/blockchain/define.hpp>
 #include <kth/domain.hpp>
@@ -16,6 +18,29 @@
 
 namespace kth::blockchain {
 
+/// Script verification state of a single transaction, shared by its inputs.
+/// The transaction and its prevouts are serialized (and parsed by consensus)
+/// once, at construction. The prevout caches must be populated beforehand.
+/// This class is thread safe once constructed.
+class BCB_API transaction_verifier {
+public:
+    using const_ptr = std::shared_ptr<transaction_verifier const>;
+
+    transaction_verifier(domain::chain::transaction const& tx, uint32_t forks);
+
+    std::pair<code, size_t> verify(uint32_t input_index) const;
+
+private:
+    domain::chain::transaction const& tx_;
+
+#ifdef WITH_CONSENSUS
+    uint32_t const flags_;
+    consensus::verification_session const session_;
+#else
+    uint32_t const forks_;
+#endif
+};
+
 /// This class is static.
 class BCB_API validate_input {
 public:
@@ -30,6 +55,10 @@ public:
 
     static
     std::pair<code, size_t> verify_script(domain::chain::transaction const& tx, uint32_t input_index, uint32_t forks);
+
+    /// Bound the process-wide signature cache (no-op without consensus).
+    static
+    void set_signature_cache_size(size_t bytes);
 };
 
 } // namespace kth::blockchain
@@ -13,10 +13,12 @@
 #include <kth/blockchain/pools/branch.hpp>
 #include <kth/blockchain/populate/populate_transaction.hpp>
 #include <kth/blockchain/settings.hpp>
+#include <kth/blockchain/validate/script_cache.hpp>
+#include <kth/blockchain/validate/validate_input.hpp>
 #include <kth/domain.hpp>
 
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
@@ -28,9 +30,9 @@ public:
     using result_handler = handle0;
 
 #if defined(KTH_WITH_MEMPOOL)
-    validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, mining::mempool const& mp);
+    validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, mining::mempool const& mp);
 #else
-    validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings);
+    validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts);
 #endif
 
     void start();
@@ -48,13 +50,14 @@ protected:
 
 private:
     void handle_populated(code const& ec, transaction_const_ptr tx, result_handler handler) const;
-    void connect_inputs(transaction_const_ptr tx, size_t bucket, size_t buckets, result_handler handler) const;
+    void connect_inputs(transaction_const_ptr tx, transaction_verifier::const_ptr verifier, size_t bucket, size_t buckets, result_handler handler) const;
 
     // These are thread safe.
     std::atomic<bool> stopped_;
     bool const retarget_;
     fast_chain const& fast_chain_;
     dispatcher& dispatch_;
+    script_cache& script_cache_;
 
     // Caller must not invoke accept/connect concurrently.
     populate_transaction transaction_populator_;
@@ -18,6 +18,7 @@
 
 #include <kth/blockchain/populate/populate_chain_state.hpp>
 #include <kth/blockchain/settings.hpp>
+#include <kth/blockchain/validate/validate_input.hpp>
 #include <kth/database.hpp>
 #include <kth/domain.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
@@ -86,16 +87,19 @@ block_chain::block_chain(threadpool& pool, blockchain::settings const& chain_set
     , validation_mutex_(relay_transactions)
     , priority_pool_("blockchain", thread_ceiling(chain_settings.cores), priority(chain_settings.priority))
     , dispatch_(priority_pool_, NAME "_priority")
+    , script_cache_(size_t(chain_settings.script_cache_mb) * 1024 * 1024)
 
 #if defined(KTH_WITH_MEMPOOL)
     , mempool_(chain_settings.mempool_max_template_size, chain_settings.mempool_size_multiplier)
-    , transaction_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, mempool_)
-    , block_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, network, relay_transactions, mempool_)
+    , transaction_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, script_cache_, mempool_)
+    , block_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, script_cache_, network, relay_transactions, mempool_)
 #else
-    , transaction_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings)
-    , block_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, network, relay_transactions)
+    , transaction_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, script_cache_)
+    , block_organizer_(validation_mutex_, dispatch_, pool, *this, chain_settings, script_cache_, network, relay_transactions)
 #endif
-{}
+{
+    validate_input::set_signature_cache_size(size_t(chain_settings.signature_cache_mb) * 1024 * 1024);
+}
 
 // ============================================================================
 // FAST CHAIN
@@ -165,23 +169,25 @@ bool block_chain::get_block_exists_safe(hash_digest const& block_hash) const {
 }
 
 bool block_chain::get_block_hash(hash_digest& out_hash, size_t height) const {
-    auto const result = database_.internal_db().get_header(height);
-    if ( ! result.is_valid()) return false;
-    out_hash = result.hash();
+    auto const result = database_.internal_db().get_block_hash(height);
+    if ( ! result) return false;
+    out_hash = *result;
     return true;
 }
 
+// The work is not limited to the maximum, it is only compared against it.
 bool block_chain::get_branch_work(uint256_t& out_work, uint256_t const& maximum, size_t from_height) const {
     size_t top;
     if ( ! get_last_height(top)) return false;
 
-    out_work = 0;
-    for (uint32_t height = from_height; height <= top && out_work < maximum; ++height) {
-        auto const result = database_.internal_db().get_header(height);
-        if ( ! result.is_valid()) return false;
-        out_work += domain::chain::header::proof(result.bits());
+    if (from_height > top) {
+        out_work = 0;
+        return true;
     }
 
+    auto const result = database_.internal_db().get_work(uint32_t(from_height), uint32_t(top));
+    if ( ! result) return false;
+    out_work = *result;
     return true;
 }
 
@@ -246,6 +252,26 @@ bool block_chain::get_utxo(domain::chain::output& out_output, size_t& out_height
     return true;
 }
 
+void block_chain::populate_utxos(std::vector<domain::chain::output_point const*> const& outpoints, size_t branch_height) const {
+    auto const entries = database_.internal_db().get_utxos(outpoints);
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        auto const& entry = entries[i];
+        if ( ! entry.is_valid()) continue;
+        if (entry.height() > branch_height) continue;
+
+        auto& prevout = outpoints[i]->validation;
+        prevout.cache = entry.output();
+        prevout.height = entry.height();
+        prevout.median_time_past = entry.median_time_past();
+        prevout.coinbase = entry.coinbase();
+    }
+}
+
+void block_chain::prefetch_utxos(std::vector<domain::chain::output_point const*> const& outpoints) const {
+    database_.internal_db().get_utxos(outpoints);
+}
+
 std::pair<bool, database::internal_database::utxo_pool_t> block_chain::get_utxo_pool_from(uint32_t from, uint32_t to) const {
     auto p = database_.internal_db().get_utxo_pool_from(from, to);
 
@@ -376,6 +402,13 @@ bool block_chain::start() {
         return false;
     }
 
+#if ! defined(KTH_DB_READONLY)
+    // The blocks under the last checkpoint are not populated from the store.
+    if ( ! settings_.checkpoints.empty()) {
+        database_.set_group_commit_height(settings_.checkpoints.back().height());
+    }
+#endif
+
     //switch to fast mode if the database is stale
     //set_database_flags();
 
@@ -713,39 +746,15 @@ void block_chain::fetch_transaction_position(hash_digest const& hash, bool requi
 
 //TODO (Mario) : Review and move to proper location
 hash_digest generate_merkle_root(std::vector<domain::chain::transaction> transactions) {
-    using std::swap;
-
-    if (transactions.empty()) return null_hash;
-
-    hash_list merkle;
-
-    auto hasher = [&merkle](transaction const& tx) {
-        merkle.push_back(tx.hash());
-    };
+    hash_list hashes;
+    hashes.reserve(transactions.size());
 
     // Hash ordering matters, don't use std::transform here.
-    std::for_each(transactions.begin(), transactions.end(), hasher);
-
-    hash_list update;
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
-    while (merkle.size() > 1) {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0) {
-            merkle.push_back(merkle.back());
-        }
-
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2) {
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
-        }
-
-        swap(merkle, update);
-        update.clear();
+    for (auto const& tx : transactions) {
+        hashes.push_back(tx.hash());
     }
 
-    // There is now only one item in the list.
-    return merkle.front();
+    return merkle_root(std::move(hashes));
 }
 
 namespace {
@@ -763,9 +772,21 @@ std::tuple<uint8_t, uint8_t> get_address_versions(bool use_testnet_rules) {
 
 }
 
+// The address as extracted from an output script under the given rules.
+std::string encode_address(kth::domain::wallet::payment_address const& address, bool use_testnet_rules) {
+    using kth::domain::wallet::payment_address;
+    auto const [encoding_p2kh, encoding_p2sh] = get_address_versions(use_testnet_rules);
+    auto const script = address.version() == payment_address::mainnet_p2sh || address.version() == payment_address::testnet_p2sh;
+    auto const version = script ? encoding_p2sh : encoding_p2kh;
+
+    if (address.hash_span().size() == kth::short_hash_size) {
+        return payment_address(address.hash20(), version).encoded_cashaddr(false);
+    }
+    return payment_address(address.hash32(), version).encoded_cashaddr(false);
+}
+
 } // anonymous namespace
 
-//TODO(fernando): refactor!!!
 std::vector<kth::blockchain::mempool_transaction_summary> block_chain::get_mempool_transactions(std::vector<std::string> const& payment_addresses, bool use_testnet_rules) const {
 /*          "    \"address\"  (string) The base58check encoded address\n"
             "    \"txid\"  (string) The related txid\n"
@@ -776,63 +797,29 @@ std::vector<kth::blockchain::mempool_transaction_summary> block_chain::get_mempo
             "    \"prevout\"  (string) The previous transaction output index (if spending)\n"
 */
 
-    auto const [encoding_p2kh, encoding_p2sh] = get_address_versions(use_testnet_rules);
-
-    std::vector<kth::blockchain::mempool_transaction_summary> ret;
-
-    std::unordered_set<kth::domain::wallet::payment_address> addrs;
+    std::vector<kth::domain::wallet::payment_address> addrs;
     for (auto const& payment_address : payment_addresses) {
         kth::domain::wallet::payment_address address(payment_address);
-        if (address){
-            addrs.insert(address);
+        if (address && std::find(addrs.begin(), addrs.end(), address) == addrs.end()) {
+            addrs.push_back(address);
         }
     }
 
-    auto const result = database_.internal_db().get_all_transaction_unconfirmed();
-
-    for (auto const& tx_res : result) {
-        auto const& tx = tx_res.transaction();
-        //tx.recompute_hash();
-        size_t i = 0;
-        for (auto const& output : tx.outputs()) {
-            auto const tx_addresses = kth::domain::wallet::payment_address::extract(output.script(), encoding_p2kh, encoding_p2sh);
-            for(auto const tx_address : tx_addresses) {
-                if (tx_address && addrs.find(tx_address) != addrs.end()) {
-                    ret.push_back
-                            (kth::blockchain::mempool_transaction_summary
-                                     (tx_address.encoded_cashaddr(false), kth::encode_hash(tx.hash()), "",
-                                      "", std::to_string(output.value()), i, tx_res.arrival_time()));
-                }
-            }
-            ++i;
-        }
-        i = 0;
-        for (auto const& input : tx.inputs()) {
-            // TODO(kth): payment_addrress::extract should use the prev_output script instead of the input script
-            // see https://github.com/k-nuth/core/blob/v0.10.0/src/wallet/payment_address.cpp#L505
-            auto const tx_addresses = kth::domain::wallet::payment_address::extract(input.script(), encoding_p2kh, encoding_p2sh);
-            for(auto const tx_address : tx_addresses)
-            if (tx_address && addrs.find(tx_address) != addrs.end()) {
-                std::latch latch(1);
-                fetch_transaction(input.previous_output().hash(), false,
-                                  [&](const kth::code &ec,
-                                      kth::transaction_const_ptr tx_ptr, size_t index,
-                                      size_t height) {
-                                      if (ec == kth::error::success) {
-                                          ret.push_back(kth::blockchain::mempool_transaction_summary
-                                                                (tx_address.encoded_cashaddr(false),
-                                                                kth::encode_hash(tx.hash()),
-                                                                kth::encode_hash(input.previous_output().hash()),
-                                                                 std::to_string(input.previous_output().index()),
-                                                                "-"+std::to_string(tx_ptr->outputs()[input.previous_output().index()].value()),
-                                                                i,
-                                                                tx_res.arrival_time()));
-                                      }
-                                      latch.count_down();
-                                  });
-                latch.wait();
+    std::vector<kth::blockchain::mempool_transaction_summary> ret;
+    auto const history = database_.internal_db().get_unconfirmed_history(addrs);
+
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        auto const encoded = encode_address(addrs[i], use_testnet_rules);
+        for (auto const& entry : history[i]) {
+            if (entry.input) {
+                ret.emplace_back(encoded, kth::encode_hash(entry.hash),
+                                 kth::encode_hash(entry.previous_output.hash()),
+                                 std::to_string(entry.previous_output.index()),
+                                 std::to_string(entry.delta), entry.index, entry.arrival_time);
+            } else {
+                ret.emplace_back(encoded, kth::encode_hash(entry.hash), "", "",
+                                 std::to_string(entry.delta), entry.index, entry.arrival_time);
             }
-            ++i;
         }
     }
 
@@ -840,73 +827,59 @@ std::vector<kth::blockchain::mempool_transaction_summary> block_chain::get_mempo
 }
 
 // Precondition: valid payment addresses
-std::vector<domain::chain::transaction> block_chain::get_mempool_transactions_from_wallets(std::vector<domain::wallet::payment_address> const& payment_addresses, bool use_testnet_rules) const {
-    auto const [encoding_p2kh, encoding_p2sh] = get_address_versions(use_testnet_rules);
-
+std::vector<domain::chain::transaction> block_chain::get_mempool_transactions_from_wallets(std::vector<domain::wallet::payment_address> const& payment_addresses, bool /*use_testnet_rules*/) const {
     std::vector<domain::chain::transaction> ret;
-
-    auto const result = database_.internal_db().get_all_transaction_unconfirmed();
-
-    for (auto const& tx_res : result) {
-        auto const& tx = tx_res.transaction();
-        //tx.recompute_hash();
-        // Only insert the transaction once. Avoid duplicating the tx if serveral wallets are used in the same tx, and if the same wallet is the input and output addr.
-        bool inserted = false;
-
-        for (auto iter_output = tx.outputs().begin(); (iter_output != tx.outputs().end() && !inserted); ++iter_output) {
-
-            auto const tx_addresses = kth::domain::wallet::payment_address::extract((*iter_output).script(), encoding_p2kh, encoding_p2sh);
-
-            for (auto iter_addr = tx_addresses.begin(); (iter_addr != tx_addresses.end() && !inserted); ++iter_addr) {
-                if (*iter_addr) {
-                    auto it = std::find(payment_addresses.begin(), payment_addresses.end(), *iter_addr);
-                    if (it != payment_addresses.end()) {
-                        ret.push_back(tx);
-                        inserted = true;
-                    }
-                }
+    auto const history = database_.internal_db().get_unconfirmed_history(payment_addresses);
+
+    // Only insert the transaction once. Avoid duplicating the tx if serveral wallets are used in the same tx, and if the same wallet is the input and output addr.
+    std::unordered_set<hash_digest> inserted;
+    for (auto const& entries : history) {
+        for (auto const& entry : entries) {
+            if ( ! inserted.insert(entry.hash).second) {
+                continue;
             }
-        }
 
-        for (auto iter_input = tx.inputs().begin(); (iter_input != tx.inputs().end() && !inserted); ++iter_input) {
-            // TODO(kth): payment_addrress::extract should use the prev_output script instead of the input script
-            // see https://github.com/k-nuth/core/blob/v0.10.0/src/wallet/payment_address.cpp#L505
-            auto const tx_addresses = kth::domain::wallet::payment_address::extract((*iter_input).script(), encoding_p2kh, encoding_p2sh);
-            for (auto iter_addr = tx_addresses.begin(); (iter_addr != tx_addresses.end() && !inserted); ++iter_addr) {
-                if (*iter_addr) {
-                    auto it = std::find(payment_addresses.begin(), payment_addresses.end(), *iter_addr);
-                    if (it != payment_addresses.end()) {
-                        ret.push_back(tx);
-                        inserted = true;
-                    }
-                }
+            auto const tx_res = database_.internal_db().get_transaction_unconfirmed(entry.hash);
+            if (tx_res.is_valid()) {
+                ret.push_back(tx_res.transaction());
             }
         }
-
     }
 
     return ret;
 }
 
 void block_chain::fill_tx_list_from_mempool(domain::message::compact_block const& block, size_t& mempool_count, std::vector<domain::chain::transaction>& txn_available, std::unordered_map<uint64_t, uint16_t> const& shorttxids) const {
-
-    std::vector<bool> have_txn(txn_available.size());
-
     auto header_hash = hash(block);
     auto k0 = from_little_endian_unsafe<uint64_t>(header_hash.begin());
     auto k1 = from_little_endian_unsafe<uint64_t>(header_hash.begin() + sizeof(uint64_t));
 
-    auto const result = database_.internal_db().get_all_transaction_unconfirmed();
+#if defined(KTH_WITH_MEMPOOL)
+    // The pool keeps the transactions and their txids resident.
+    mempool_count += mempool_.fill_compact_block_high(k0, k1, shorttxids, txn_available);
+#else
+    std::vector<bool> have_txn(txn_available.size());
 
-    for (auto const& tx_res : result) {
-        auto const& tx = tx_res.transaction();
+    // The txids are kept in memory by the database, only the transactions
+    // that match a short id are read.
+    auto const txids = database_.internal_db().get_unconfirmed_hashes();
 
-        uint64_t shortid = sip_hash_uint256(k0, k1, tx.hash()) & uint64_t(0xffffffffffff);
+    std::vector<uint64_t> shortids(txids.size());
+    sip_hash_uint256(k0, k1, txids.data(), txids.size(), shortids.data());
+
+    for (size_t i = 0; i < txids.size(); ++i) {
+        uint64_t shortid = shortids[i] & uint64_t(0xffffffffffff);
 
         auto idit = shorttxids.find(shortid);
         if (idit != shorttxids.end()) {
             if ( ! have_txn[idit->second]) {
-                txn_available[idit->second] = tx;
+                auto const tx_res = database_.internal_db().get_transaction_unconfirmed(txids[i]);
+                if ( ! tx_res.is_valid()) {
+                    // Confirmed since the txids were taken.
+                    continue;
+                }
+
+                txn_available[idit->second] = tx_res.transaction();
                 have_txn[idit->second] = true;
                 ++mempool_count;
             } else {
@@ -932,7 +905,7 @@ void block_chain::fill_tx_list_from_mempool(domain::message::compact_block const
             return true;
         }*/
     }
-
+#endif
 }
 
 safe_chain::mempool_mini_hash_map block_chain::get_mempool_mini_hash_map(domain::message::compact_block const& block) const {
@@ -947,24 +920,23 @@ safe_chain::mempool_mini_hash_map block_chain::get_mempool_mini_hash_map(domain:
 
     safe_chain::mempool_mini_hash_map mempool;
 
+    auto const txids = database_.internal_db().get_unconfirmed_hashes();
 
-    auto const result = database_.internal_db().get_all_transaction_unconfirmed();
-
-    for (auto const& tx_res : result) {
-        auto const& tx = tx_res.transaction();
+    std::vector<uint64_t> shortids(txids.size());
+    sip_hash_uint256(k0, k1, txids.data(), txids.size(), shortids.data());
 
-        auto sh = sip_hash_uint256(k0, k1, tx.hash());
-
-       /* to_little_endian()
-        uint64_t pepe = 4564564;
-        uint64_t pepe2 = pepe & 0x0000ffffffffffff;
+    for (size_t i = 0; i < txids.size(); ++i) {
+        auto const tx_res = database_.internal_db().get_transaction_unconfirmed(txids[i]);
+        if ( ! tx_res.is_valid()) {
+            continue;
+        }
 
-        reinterpret_cast<uint8_t*>(pepe2);
-        */
-        //Drop the most significative bytes from the sh
+        // The six least significant bytes of the SipHash, little endian.
         mini_hash short_id;
-        mempool.emplace(short_id,tx);
-
+        for (size_t byte = 0; byte < short_id.size(); ++byte) {
+            short_id[byte] = uint8_t(shortids[i] >> (8 * byte));
+        }
+        mempool.emplace(short_id, tx_res.transaction());
     }
 
     return mempool;
@@ -1243,13 +1215,14 @@ void block_chain::fetch_block_hash_timestamp(size_t height, block_hash_time_fetc
     }
 
     auto const result = database_.internal_db().get_header(height);
+    auto const hash = database_.internal_db().get_block_hash(height);
 
-    if ( ! result.is_valid() ) {
+    if ( ! result.is_valid() || ! hash) {
         handler(error::not_found, null_hash, 0, 0);
         return;
     }
 
-    handler(error::success, result.hash(), result.timestamp(), height);
+    handler(error::success, *hash, result.timestamp(), height);
 
 }
 
@@ -1325,7 +1298,7 @@ void block_chain::fetch_last_height(last_height_fetch_handler handler) const {
     handler(error::success, last_height);
 }
 
-// This may execute over 2000 queries.
+// The headers are read from the header index, not the store.
 void block_chain::fetch_locator_block_headers(get_headers_const_ptr locator, hash_digest const& threshold, size_t limit, locator_block_headers_fetch_handler handler) const {
     if (stopped()) {
         handler(error::service_stopped, nullptr);
@@ -1379,23 +1352,19 @@ void block_chain::fetch_locator_block_headers(get_headers_const_ptr locator, has
     }
 
     auto message = std::make_shared<headers>();
-    message->elements().reserve(floor_subtract(end, begin));
-
-    // Build the hash list until we hit end or the blockchain top.
-    for (auto height = begin; height < end; ++height) {
-        auto const result = database_.internal_db().get_header(height);
 
-        // If not found then we are at our top.
-        if ( ! result.is_valid()) {
-            message->elements().shrink_to_fit();
-            break;
+    // Build the header list until we hit end or the blockchain top.
+    if (begin < end) {
+        auto const found = database_.internal_db().get_headers(uint32_t(begin), uint32_t(end - 1));
+        message->elements().reserve(found.size());
+        for (auto const& header : found) {
+            message->elements().emplace_back(header);
         }
-        message->elements().push_back(result);
     }
     handler(error::success, std::move(message));
 }
 
-// This may generally execute 29+ queries.
+// This may generally execute 29+ header index lookups.
 void block_chain::fetch_block_locator(block::indexes const& heights, block_locator_fetch_handler handler) const {
 
     if (stopped()) {
@@ -1409,12 +1378,12 @@ void block_chain::fetch_block_locator(block::indexes const& heights, block_locat
     hashes.reserve(heights.size());
 
     for (auto const height : heights) {
-        auto const result = database_.internal_db().get_header(height);
-        if ( ! result.is_valid()) {
+        auto const result = database_.internal_db().get_block_hash(height);
+        if ( ! result) {
             handler(error::not_found, nullptr);
             break;
         }
-        hashes.push_back(result.hash());
+        hashes.push_back(*result);
     }
 
     handler(error::success, message);
@@ -1515,36 +1484,48 @@ void block_chain::filter_transactions(get_data_ptr message, result_handler handl
 
 //TODO(fernando): Do we have to use the mempool when both KTH_DB_NEW_FULL and KTH_WITH_MEMPOOL are activated?
 #if defined(KTH_WITH_MEMPOOL)
-    auto validated_txs = mempool_.get_validated_txs_low();
+    hash_list txids;
+    txids.reserve(inventories.size());
+    for (auto const& inventory : inventories) {
+        if (inventory.is_transaction_type()) {
+            txids.push_back(inventory.hash());
+        }
+    }
 
-    if (validated_txs.empty()) {
+    if (txids.empty()) {
         handler(error::success);
         return;
     }
 
-    for (auto it = inventories.begin(); it != inventories.end();) {
-        auto found = validated_txs.find(it->hash());
-        if (it->is_transaction_type() && found != validated_txs.end()) {
-            it = inventories.erase(it);
-        } else {
-            ++it;
+    auto const found = mempool_.contains(txids);
+
+    // Compact in place, found follows the transaction inventories in order.
+    size_t position = 0;
+    size_t write = 0;
+    for (size_t read = 0; read < inventories.size(); ++read) {
+        auto const is_transaction = inventories[read].is_transaction_type();
+        if (is_transaction && found[position++]) {
+            continue;
+        }
+
+        if (write != read) {
+            inventories[write] = std::move(inventories[read]);
         }
+        ++write;
     }
+    inventories.erase(inventories.begin() + write, inventories.end());
 #else
 
     size_t out_height;
     size_t out_position;
 
-    for (auto it = inventories.begin(); it != inventories.end();) {
+    auto const last = std::remove_if(inventories.begin(), inventories.end(), [&](inventory_vector const& inventory) {
         //Knuth: We don't store spent information
-        if (it->is_transaction_type()
-            //&& get_is_unspent_transaction(it->hash(), max_size_t, false))
-            && get_transaction_position(out_height, out_position, it->hash(), false)) {
-            it = inventories.erase(it);
-        } else {
-            ++it;
-        }
-    }
+        return inventory.is_transaction_type()
+            //&& get_is_unspent_transaction(inventory.hash(), max_size_t, false))
+            && get_transaction_position(out_height, out_position, inventory.hash(), false);
+    });
+    inventories.erase(last, inventories.end());
 
 #endif
 
@@ -1668,7 +1649,7 @@ bool block_chain::stopped() const {
 }
 
 #if defined(KTH_WITH_MEMPOOL)
-std::pair<std::vector<kth::mining::transaction_element>, uint64_t> block_chain::get_block_template() const {
+kth::mining::mempool::block_template_ptr block_chain::get_block_template() const {
     return mempool_.get_block_template();
 }
 #endif
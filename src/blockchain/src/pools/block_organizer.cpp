@@ -4,11 +4,16 @@
 
 #include <kth/blockchain/pools/block_organizer.hpp>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include <kth/blockchain/interface/fast_chain.hpp>
 #include <kth/blockchain/pools/block_pool.hpp>
@@ -32,19 +37,20 @@ using namespace std::placeholders;
 // transaction: { exists, height, output }
 
 #if defined(KTH_WITH_MEMPOOL)
-block_organizer::block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, domain::config::network network, bool relay_transactions, mining::mempool& mp)
+block_organizer::block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions, mining::mempool& mp)
 #else
-block_organizer::block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, domain::config::network network, bool relay_transactions)
+block_organizer::block_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions)
 #endif
     : fast_chain_(chain)
     , mutex_(mutex)
     , stopped_(true)
+    , pipeline_slots_(std::max(settings.organize_pipeline_depth, 1u))
     , dispatch_(dispatch)
     , block_pool_(settings.reorganization_limit)
 #if defined(KTH_WITH_MEMPOOL)
-    , validator_(dispatch, fast_chain_, settings, network, relay_transactions, mp)
+    , validator_(dispatch, fast_chain_, settings, scripts, network, relay_transactions, mp)
 #else
-    , validator_(dispatch, fast_chain_, settings, network, relay_transactions)
+    , validator_(dispatch, fast_chain_, settings, scripts, network, relay_transactions)
 #endif
     , subscriber_(std::make_shared<reorganize_subscriber>(thread_pool, NAME))
 
@@ -75,6 +81,10 @@ bool block_organizer::stop() {
     subscriber_->stop();
     subscriber_->invoke(error::service_stopped, 0, {}, {});
     stopped_ = true;
+
+    // Release the blocks waiting for their turn.
+    std::lock_guard lock(turn_mutex_);
+    turn_.notify_all();
     return true;
 }
 
@@ -82,38 +92,154 @@ bool block_organizer::stop() {
 //-----------------------------------------------------------------------------
 
 // This is called from blockchain::organize.
+// Blocks are pipelined: the context free checks and the prevout prefetch run
+// before the critical section, overlapping with the block being organized.
+// organize is synchronous for each channel, so the blocks that overlap come
+// from different peers.
+// The chain state dependent stages (accept, connect and reorganize) remain
+// serialized by the mutex. Each block takes a ticket along with its pipeline
+// slot and enters the critical section in ticket order, so a block is not
+// organized before a block that entered the pipeline earlier (its parent,
+// for instance) and then rejected as an orphan.
 void block_organizer::organize(block_const_ptr block, result_handler handler) {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    mutex_.lock_high_priority();
-
     if (stopped()) {
-        mutex_.unlock_high_priority();
         handler(error::service_stopped);
         return;
     }
 
-    // Reset the reusable promise.
-    resume_ = std::promise<code>();
+    // Bounds the blocks in the pipeline, the one being organized included.
+    pipeline_slots_.acquire();
+    auto const ticket = take_ticket();
 
-    const result_handler complete = std::bind(&block_organizer::signal_completion, this, _1);
-    auto const check_handler = std::bind(&block_organizer::handle_check, this, _1, block, complete);
+    ++checking_;
+    auto ec = check(block);
+    --checking_;
 
-    // Checks that are independent of chain state.
-    validator_.check(block, check_handler);
+    if (ec) {
+        end_turn(ticket);
+        pipeline_slots_.release();
+        handler(ec);
+        return;
+    }
+
+    ++prefetching_;
+    prefetch(block);
+    --prefetching_;
 
-    // Wait on completion signal.
-    // This is necessary in order to continue on a non-priority thread.
-    // If we do not wait on the original thread there may be none left.
-    auto ec = resume_.get_future().get();
+    ++waiting_;
+    auto const turn = wait_turn(ticket);
 
+    // Critical Section
+    ///////////////////////////////////////////////////////////////////////////
+    mutex_.lock_high_priority();
+    --waiting_;
+    ++organizing_;
+
+    if ( ! turn || stopped()) {
+        ec = error::service_stopped;
+    } else {
+        // Reset the reusable promise.
+        resume_ = std::promise<code>();
+
+        const result_handler complete = std::bind(&block_organizer::signal_completion, this, _1);
+
+        // Checks that are dependent on chain state, continue on the priority pool.
+        handle_check(error::success, block, complete);
+
+        // Wait on completion signal.
+        // This is necessary in order to continue on a non-priority thread.
+        // If we do not wait on the original thread there may be none left.
+        ec = resume_.get_future().get();
+    }
+
+    --organizing_;
     mutex_.unlock_high_priority();
     ///////////////////////////////////////////////////////////////////////////
 
+    end_turn(ticket);
+
+    auto const stages = occupancy();
+    LOG_DEBUG(LOG_BLOCKCHAIN, "Organize pipeline [check: ", stages.check, ", prefetch: ", stages.prefetch,
+        ", wait: ", stages.wait, ", organize: ", stages.organize, "]");
+
+    pipeline_slots_.release();
+
     // Invoke caller handler outside of critical section.
     handler(ec);
 }
 
+block_organizer::pipeline_occupancy block_organizer::occupancy() const {
+    return {checking_.load(), prefetching_.load(), waiting_.load(), organizing_.load()};
+}
+
+// private
+code block_organizer::check(block_const_ptr block) const {
+    std::promise<code> checked;
+
+    // Checks that are independent of chain state.
+    validator_.check(block, [&checked](code const& ec) {
+        checked.set_value(ec);
+    });
+
+    return checked.get_future().get();
+}
+
+// private
+// The prevouts are read from the store while the previous block is being
+// organized, so that the population in accept finds the pages in memory.
+// The population itself needs the previous block in the chain.
+void block_organizer::prefetch(block_const_ptr block) const {
+    auto const state = fast_chain_.chain_state();
+
+    // Nothing is populated under the checkpoint.
+    if ( ! state || state->is_under_checkpoint() || block->transactions().size() < 2) {
+        return;
+    }
+
+    std::vector<output_point const*> outpoints;
+    outpoints.reserve(block->non_coinbase_input_count());
+
+    auto const& txs = block->transactions();
+    for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx) {
+        for (auto const& input : tx->inputs()) {
+            outpoints.push_back(&input.previous_output());
+        }
+    }
+
+    fast_chain_.prefetch_utxos(outpoints);
+}
+
+// private
+uint64_t block_organizer::take_ticket() {
+    std::lock_guard lock(turn_mutex_);
+    return next_ticket_++;
+}
+
+// private
+// Returns false if the organizer was stopped while waiting.
+bool block_organizer::wait_turn(uint64_t ticket) {
+    std::unique_lock lock(turn_mutex_);
+    turn_.wait(lock, [this, ticket] {
+        return next_turn_ == ticket || stopped();
+    });
+    return next_turn_ == ticket;
+}
+
+// private
+// A block rejected by its checks ends its turn before the blocks ahead of
+// it, the turn is skipped when it comes.
+void block_organizer::end_turn(uint64_t ticket) {
+    {
+        std::lock_guard lock(turn_mutex_);
+        ended_turns_.insert(ticket);
+        while ( ! ended_turns_.empty() && *ended_turns_.begin() == next_turn_) {
+            ended_turns_.erase(ended_turns_.begin());
+            ++next_turn_;
+        }
+    }
+    turn_.notify_all();
+}
+
 // private
 void block_organizer::signal_completion(code const& ec) {
     // This must be protected so that it is properly cleared.
@@ -379,7 +505,7 @@ void block_organizer::handle_connect(code const& ec, branch::ptr branch, result_
     auto const first_height = branch->height() + 1u;
     top_block.start_notify = asio::steady_clock::now();
 
-    // The chain query will stop if it reaches work level.
+    // The work of the chain above the fork point.
     if ( ! fast_chain_.get_branch_work(threshold, work, first_height)) {
         handler(error::operation_failed_18);
         return;
@@ -429,6 +555,11 @@ void block_organizer::handle_connect(code const& ec, branch::ptr branch, result_
 void block_organizer::handle_reorganized(code const& ec, branch::const_ptr branch, block_const_ptr_list_ptr outgoing, result_handler handler) {
     if (ec) {
         LOG_FATAL(LOG_BLOCKCHAIN, "Failure writing block to store, is now corrupted: ", ec.message());
+
+        // Blocks already reported as pushed may be missing from the store,
+        // the subscribers (the node) stop. Relayed, stopping the chain takes
+        // the critical section held here.
+        subscriber_->relay(ec, 0, {}, {});
         handler(ec);
         return;
     }
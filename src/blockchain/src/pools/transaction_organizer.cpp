@@ -5,6 +5,7 @@
 #include <kth/blockchain/pools/transaction_organizer.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <future>
@@ -27,21 +28,22 @@ using namespace std::placeholders;
 // TODO(legacy): create priority pool at blockchain level and use in both organizers.
 
 #if defined(KTH_WITH_MEMPOOL)
-transaction_organizer::transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, mining::mempool& mp)
+transaction_organizer::transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts, mining::mempool& mp)
 #else
-transaction_organizer::transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings)
+transaction_organizer::transaction_organizer(prioritized_mutex& mutex, dispatcher& dispatch, threadpool& thread_pool, fast_chain& chain, settings const& settings, script_cache& scripts)
 #endif
     : fast_chain_(chain)
     , mutex_(mutex)
     , stopped_(true)
+    , pipeline_slots_(std::max(settings.transaction_pipeline_depth, 1u))
     , settings_(settings)
     , dispatch_(dispatch)
     , transaction_pool_(settings)
 
 #if defined(KTH_WITH_MEMPOOL)
-    , validator_(dispatch, fast_chain_, settings, mp)
+    , validator_(dispatch, fast_chain_, settings, scripts, mp)
 #else
-    , validator_(dispatch, fast_chain_, settings)
+    , validator_(dispatch, fast_chain_, settings, scripts)
 #endif
 
     , subscriber_(std::make_shared<transaction_subscriber>(thread_pool, NAME))
@@ -183,38 +185,82 @@ void transaction_organizer::organize(double_spend_proof_const_ptr ds_proof, resu
 //-----------------------------------------------------------------------------
 
 // This is called from blockchain::organize.
+// Transactions are admitted concurrently: the checks and the script
+// verification run under the shared side of the mutex, overlapping with the
+// other transactions. Storing remains serialized by the exclusive side, which
+// accepts the transaction again against the transactions stored meanwhile.
+// Its connect finds the verified inputs in the script cache.
 void transaction_organizer::organize(transaction_const_ptr tx, result_handler handler) {
-    // Critical Section
-    ///////////////////////////////////////////////////////////////////////////
-    mutex_.lock_low_priority();
+    static auto& accepted = metrics::default_registry().make_counter("kth_mempool_transactions_accepted_total", "Transactions accepted to the memory pool.");
+    static auto& rejected = metrics::default_registry().make_counter("kth_mempool_transactions_rejected_total", "Transactions rejected by the memory pool.");
+    static auto& organize_time = metrics::default_registry().make_histogram("kth_mempool_organize_microseconds", "Time to validate and store a transaction, including the wait for the organizer.");
+
+    auto const start = asio::steady_clock::now();
 
     if (stopped()) {
-        mutex_.unlock_low_priority();
         handler(error::service_stopped);
         return;
     }
 
-    // Reset the reusable promise.
-    resume_ = std::promise<code>();
+    // Bounds the transactions in the pipeline. The caller blocks while it is
+    // full, which stops reading from the peer that sent the transaction.
+    pipeline_slots_.acquire();
 
-    result_handler const complete = std::bind(&transaction_organizer::signal_completion, this, _1);
-    auto const check_handler = std::bind(&transaction_organizer::handle_check, this, _1, tx, complete);
+    auto ec = verify(tx);
 
-    // Checks that are independent of chain state.
-    validator_.check(tx, check_handler);
+    // The missing prevouts may be stored by a transaction admitted meanwhile.
+    if ( ! ec || ec == error::orphan_transaction || ec == error::missing_previous_output) {
+        // Critical Section
+        ///////////////////////////////////////////////////////////////////////
+        mutex_.lock_low_priority();
 
-    // Wait on completion signal.
-    // This is necessary in order to continue on a non-priority thread.
-    // If we do not wait on the original thread there may be none left.
-    auto ec = resume_.get_future().get();
+        if (stopped()) {
+            ec = error::service_stopped;
+        } else {
+            // Reset the reusable promise.
+            resume_ = std::promise<code>();
 
-    mutex_.unlock_low_priority();
-    ///////////////////////////////////////////////////////////////////////////
+            result_handler const complete = std::bind(&transaction_organizer::signal_completion, this, _1);
+
+            // The context free checks are already done.
+            handle_check(error::success, tx, complete);
+
+            // Wait on completion signal.
+            // This is necessary in order to continue on a non-priority thread.
+            // If we do not wait on the original thread there may be none left.
+            ec = resume_.get_future().get();
+        }
+
+        mutex_.unlock_low_priority();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    pipeline_slots_.release();
+
+    (ec ? rejected : accepted).add();
+    organize_time.record(std::chrono::duration_cast<asio::microseconds>(asio::steady_clock::now() - start).count());
 
     // Invoke caller handler outside of critical section.
     handler(ec);
 }
 
+// private
+code transaction_organizer::verify(transaction_const_ptr tx) const {
+    std::promise<code> verified;
+
+    mutex_.lock_low_priority_shared();
+
+    // Checks, accept and connect, without storing.
+    transaction_validate(tx, [&verified](code const& ec) {
+        verified.set_value(ec);
+    });
+
+    auto const ec = verified.get_future().get();
+
+    mutex_.unlock_low_priority_shared();
+    return ec;
+}
+
 // private
 void transaction_organizer::signal_completion(code const& ec) {
     // This must be protected so that it is properly cleared.
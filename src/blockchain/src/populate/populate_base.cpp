@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <vector>
 
 #include <kth/blockchain/interface/fast_chain.hpp>
 #include <kth/domain.hpp>
@@ -85,4 +86,44 @@ void populate_base::populate_prevout(size_t branch_height, output_point const& o
     }
 }
 
+// Same as populate_prevout, but the store is queried once for all the outpoints.
+void populate_base::populate_prevouts(size_t branch_height, std::vector<output_point const*> const& outpoints) const {
+    std::vector<output_point const*> queried;
+    queried.reserve(outpoints.size());
+
+    for (auto const outpoint : outpoints) {
+        auto& prevout = outpoint->validation;
+        prevout.spent = false;
+        prevout.confirmed = false;
+        prevout.cache = domain::chain::output{};
+        prevout.from_mempool = false;
+
+        // If the input is a coinbase there is no prevout to populate.
+        if ( ! outpoint->is_null()) {
+            queried.push_back(outpoint);
+        }
+    }
+
+    if (queried.empty()) {
+        return;
+    }
+
+    fast_chain_.populate_utxos(queried, branch_height);
+
+    for (auto const outpoint : queried) {
+        auto& prevout = outpoint->validation;
+        if ( ! prevout.cache.is_valid()) {
+            continue;
+        }
+
+        // The previous output has already been spent (double spend).
+        auto const spend_height = prevout.cache.validation.spender_height;
+        if ((spend_height <= branch_height) && (spend_height != output::validation::not_spent)) {
+            prevout.spent = true;
+            prevout.confirmed = true;
+            prevout.cache = domain::chain::output{};
+        }
+    }
+}
+
 } // namespace kth::blockchain
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 
 #include <kth/blockchain/interface/fast_chain.hpp>
 #include <kth/blockchain/pools/branch.hpp>
@@ -65,15 +67,26 @@ void populate_block::populate(branch::const_ptr branch, result_handler&& handler
 
     auto branch_utxo = create_branch_utxo_set(branch);
 
+    // The reorg subset is an LMDB scan, build it once and share it read-only.
+    size_t const first_height = branch->height() + 1u;
+    size_t chain_top;
+    block->validation.start_reorg_subset = asio::steady_clock::now();
+    auto const reorg_subset = std::make_shared<utxo_pool_t const>(
+        get_reorg_subset_conditionally(first_height, /*out*/ chain_top));
+    block->validation.end_reorg_subset = asio::steady_clock::now();
+
 #if defined(KTH_WITH_MEMPOOL)
-    auto validated_txs = mempool_.get_validated_txs_high();
+    // Just the block transactions are looked up, the pool is not copied.
+    // The result is shared read-only by all the buckets.
+    auto const validated_txs = std::make_shared<mining::mempool::validated_subset_t const>(
+        mempool_.get_validated_subset_high(block->transactions()));
 #endif
 
     for (size_t bucket = 0; bucket < buckets; ++bucket) {
 #if defined(KTH_WITH_MEMPOOL)
-        dispatch_.concurrent(&populate_block::populate_transactions, this, branch, bucket, buckets, branch_utxo, validated_txs, join_handler);
+        dispatch_.concurrent(&populate_block::populate_transactions, this, branch, bucket, buckets, branch_utxo, chain_top, reorg_subset, validated_txs, join_handler);
 #else
-        dispatch_.concurrent(&populate_block::populate_transactions, this, branch, bucket, buckets, branch_utxo, join_handler);
+        dispatch_.concurrent(&populate_block::populate_transactions, this, branch, bucket, buckets, branch_utxo, chain_top, reorg_subset, join_handler);
 #endif
     }
 }
@@ -133,36 +146,24 @@ populate_block::utxo_pool_t populate_block::get_reorg_subset_conditionally(size_
 }
 
 
-void populate_block::populate_transaction_inputs(branch::const_ptr branch, domain::chain::input::list const& inputs, size_t bucket, size_t buckets, size_t input_position, local_utxo_set_t const& branch_utxo, size_t first_height, size_t chain_top, utxo_pool_t const& reorg_subset) const {
-    auto const branch_height = branch->height();
-
-    for (size_t input_index = 0; input_index < inputs.size(); ++input_index, ++input_position) {
-        if (input_position % buckets != bucket) {
-            continue;
-        }
-
-        auto const& input = inputs[input_index];
-        auto const& prevout = input.previous_output();
-        populate_base::populate_prevout(branch_height, prevout, true);  //Populate from Database
-        populate_prevout(branch, prevout, branch_utxo);                 //Populate from the Blocks in the Branch
-
-        if (first_height <= chain_top) {
-            populate_from_reorg_subset(prevout, reorg_subset);
+void populate_block::collect_prevouts(domain::chain::input::list const& inputs, size_t bucket, size_t buckets, size_t& input_position, prevouts_t& out_prevouts) const {
+    for (auto const& input : inputs) {
+        if (input_position++ % buckets == bucket) {
+            out_prevouts.push_back(&input.previous_output());
         }
     }
 }
 
 #if defined(KTH_WITH_MEMPOOL)
-void populate_block::populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, mining::mempool::hash_index_t const& validated_txs, result_handler handler) const {
+void populate_block::populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, size_t chain_top, utxo_pool_ptr const& reorg_subset, validated_txs_ptr const& validated_txs, result_handler handler) const {
 #else
-void populate_block::populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, result_handler handler) const {
+void populate_block::populate_transactions(branch::const_ptr branch, size_t bucket, size_t buckets, local_utxo_set_t const& branch_utxo, size_t chain_top, utxo_pool_ptr const& reorg_subset, result_handler handler) const {
 #endif
     // TODO(fernando): check how to replace it with UTXO
     KTH_ASSERT(bucket < buckets);
     auto const block = branch->top();
     auto const branch_height = branch->height();
     auto const& txs = block->transactions();
-    size_t input_position = 0;
 
     auto const state = block->validation.state;
     auto const forks = state->enabled_forks();
@@ -198,31 +199,41 @@ void populate_block::populate_transactions(branch::const_ptr branch, size_t buck
         // }
     }
 
-    size_t first_height = branch_height + 1u;
-    size_t chain_top;
-    auto reorg_subset = get_reorg_subset_conditionally(first_height, /*out*/ chain_top);
+    size_t const first_height = branch_height + 1u;
+    size_t input_position = 0;
+    prevouts_t prevouts;
 
     // Must skip coinbase here as it is already accounted for.
     for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx) {
 
 #if defined(KTH_WITH_MEMPOOL)
-        auto it = validated_txs.find(tx->hash());
-        if (it == validated_txs.end()) {
-            auto const& inputs = tx->inputs();
-            populate_transaction_inputs(branch, inputs, bucket, buckets, input_position, branch_utxo, first_height, chain_top, reorg_subset);
-        } else {
+        auto it = validated_txs->find(tx->hash());
+        if (it == validated_txs->end()) {
+            collect_prevouts(tx->inputs(), bucket, buckets, input_position, prevouts);
+        } else if (size_t(std::distance(txs.begin(), tx)) % buckets == bucket) {
+            // Only the owner bucket writes the cached data, avoiding races.
             tx->validation.validated = true;
-            auto const& tx_cached = it->second.second;
-            for (size_t i = 0; i < tx_cached.inputs().size(); ++i) {
-                tx->inputs()[i].previous_output().validation = tx_cached.inputs()[i].previous_output().validation;
+            auto const& cached = it->second;
+            for (size_t i = 0; i < cached.size(); ++i) {
+                tx->inputs()[i].previous_output().validation = cached[i];
             }
         }
 #else
-        auto const& inputs = tx->inputs();
-        populate_transaction_inputs(branch, inputs, bucket, buckets, input_position, branch_utxo, first_height, chain_top, reorg_subset);
+        collect_prevouts(tx->inputs(), bucket, buckets, input_position, prevouts);
 #endif // defined(KTH_WITH_MEMPOOL)
     }
 
+    // Populate from the Database, a single sorted batch per bucket.
+    populate_base::populate_prevouts(branch_height, prevouts);
+
+    for (auto const prevout : prevouts) {
+        populate_prevout(branch, *prevout, branch_utxo);    //Populate from the Blocks in the Branch
+
+        if (first_height <= chain_top) {
+            populate_from_reorg_subset(*prevout, *reorg_subset);
+        }
+    }
+
     handler(error::success);
 }
 
@@ -8,12 +8,21 @@
 
 //TODO(fernando): Avoid this dependency
 #if defined(KTH_WITH_MEMPOOL)
-#include <kth/mining/mempool.hpp>
+#include <kth/blockchain/mining/mempool.hpp>
 #endif
 
 namespace kth::blockchain {
 
-settings::settings(domain::config::network net) {
+settings::settings()
+#if defined(KTH_WITH_MEMPOOL)
+    : mempool_max_template_size(mining::mempool::max_template_size_default)
+    , mempool_size_multiplier(mining::mempool::mempool_size_multiplier_default)
+#endif
+{}
+
+settings::settings(domain::config::network net)
+    : settings()
+{
     namespace abla = kth::domain::chain::abla;
     switch (net) {
         case domain::config::network::mainnet: {
@@ -0,0 +1,92 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/blockchain/validate/script_cache.hpp>
+
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+#include <kth/infrastructure/utility/pseudo_random.hpp>
+
+namespace kth::blockchain {
+
+script_cache::script_cache(size_t max_bytes)
+    : max_shard_entries_(max_bytes / entry_size / shard_count)
+    , hits_(0)
+    , misses_(0)
+{
+    pseudo_random::fill(salt_);
+}
+
+script_cache::key_type script_cache::compute_key(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks) const {
+    auto const index = to_little_endian(input_index);
+    auto const flags = to_little_endian(forks);
+    return sha256_hash(salt_, build_chunk({tx_hash, index, flags}));
+}
+
+script_cache::shard& script_cache::shard_for(key_type const& key) const {
+    return shards_[key[0] % shard_count];
+}
+
+std::optional<size_t> script_cache::find(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks) const {
+    if (max_shard_entries_ == 0) {
+        return std::nullopt;
+    }
+
+    auto const key = compute_key(tx_hash, input_index, forks);
+    auto& shard = shard_for(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto const it = shard.entries.find(key);
+
+    if (it == shard.entries.end()) {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    ++hits_;
+    return it->second;
+}
+
+void script_cache::store(hash_digest const& tx_hash, uint32_t input_index, uint32_t forks, size_t sigchecks) {
+    if (max_shard_entries_ == 0) {
+        return;
+    }
+
+    auto const key = compute_key(tx_hash, input_index, forks);
+    auto& shard = shard_for(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if ( ! shard.entries.emplace(key, uint32_t(sigchecks)).second) {
+        return;
+    }
+
+    shard.order.push_back(key);
+
+    // Evict the oldest entries (FIFO).
+    while (shard.order.size() > max_shard_entries_) {
+        shard.entries.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+uint64_t script_cache::hits() const {
+    return hits_;
+}
+
+uint64_t script_cache::misses() const {
+    return misses_;
+}
+
+size_t script_cache::size() const {
+    size_t result = 0;
+
+    for (auto const& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result += shard.entries.size();
+    }
+    return result;
+}
+
+} // namespace kth::blockchain
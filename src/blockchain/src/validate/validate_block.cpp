@@ -9,6 +9,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 #include <kth/blockchain/interface/fast_chain.hpp>
 #include <kth/blockchain/pools/branch.hpp>
@@ -27,6 +30,11 @@ using namespace std::placeholders;
 
 #define NAME "validate_block"
 
+// Script verification is split in about this many chunks per task, of at
+// most max_connect_chunk inputs each.
+static constexpr size_t connect_chunks_per_task = 8;
+static constexpr size_t max_connect_chunk = 32;
+
 // Database access is limited to: populator:
 // spend: { spender }
 // block: { bits, version, timestamp }
@@ -36,14 +44,15 @@ using namespace std::placeholders;
 // will never be invoked, resulting in a threadpool.join indefinite hang.
 
 #if defined(KTH_WITH_MEMPOOL)
-validate_block::validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, domain::config::network network, bool relay_transactions, mining::mempool const& mp)
+validate_block::validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions, mining::mempool const& mp)
 #else
-validate_block::validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, domain::config::network network, bool relay_transactions)
+validate_block::validate_block(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, domain::config::network network, bool relay_transactions)
 #endif
     : stopped_(true)
     , fast_chain_(chain)
     , network_(network)
     , priority_dispatch_(dispatch)
+    , script_cache_(scripts)
 #if defined(KTH_WITH_MEMPOOL)
     , block_populator_(dispatch, chain, relay_transactions, mp)
 #else
@@ -241,6 +250,58 @@ void validate_block::handle_accepted(code const& ec, block_const_ptr block, atom
 //-----------------------------------------------------------------------------
 // These checks require chain state, block state and perform script validation.
 
+// Inputs of a transaction are spread across tasks, so its verifier is built
+// by the first task that needs it and then shared by the others.
+class validate_block::verifier_list {
+public:
+    verifier_list(transaction::list const& txs, uint32_t forks)
+        : txs_(txs)
+        , forks_(forks)
+        , once_(txs.size())
+        , verifiers_(txs.size())
+    {}
+
+    transaction_verifier const& get(size_t tx_index) {
+        std::call_once(once_[tx_index], [this, tx_index] {
+            verifiers_[tx_index].emplace(txs_[tx_index], forks_);
+        });
+        return *verifiers_[tx_index];
+    }
+
+private:
+    transaction::list const& txs_;
+    uint32_t const forks_;
+    std::vector<std::once_flag> once_;
+    std::vector<std::optional<transaction_verifier>> verifiers_;
+};
+
+// State shared by the connect tasks of a block. The inputs to verify are
+// claimed in chunks from a common cursor, so a task that runs out of work
+// keeps taking the chunks left while the others grind through heavy scripts.
+struct validate_block::connect_job {
+    struct input_ref {
+        uint32_t tx;
+        uint32_t input;
+    };
+
+    connect_job(transaction::list const& txs, uint32_t forks)
+        : verifiers(txs, forks)
+    {}
+
+    verifier_list verifiers;
+    std::vector<input_ref> inputs;
+    size_t chunk = 1;
+
+    atomic_counter next{0};
+    atomic_counter sigchecks{0};            // the limit applies to the whole block
+    std::atomic<bool> failed{false};        // the first failure stops all the tasks
+
+    // Summed over the tasks.
+    asio::time_point dispatched;
+    std::atomic<asio::duration::rep> queue{0};
+    std::atomic<asio::duration::rep> execution{0};
+};
+
 void validate_block::connect(branch::const_ptr branch, result_handler handler) const {
     auto const block = branch->top();
     KTH_ASSERT(block && block->validation.state);
@@ -264,93 +325,139 @@ void validate_block::connect(branch::const_ptr branch, result_handler handler) c
     // Reset statistics for each block (treat coinbase as cached).
     hits_ = 0;
     queries_ = 0;
+    script_hits_ = 0;
+    script_queries_ = 0;
 
-    result_handler complete_handler = std::bind(&validate_block::handle_connected, this, _1, block, handler);
+    auto const& txs = block->transactions();
+    auto const forks = block->validation.state->enabled_forks();
+    auto const job = std::make_shared<connect_job>(txs, forks);
+    job->inputs.reserve(non_coinbase_inputs);
 
+    // Must skip coinbase here as it is already accounted for.
+    for (size_t tx = 1; tx < txs.size(); ++tx) {
+        ++queries_;
+
+        // The tx is pooled with current fork state so outputs are validated.
+        // The tx was validated before its insertion in the mempool.
+        // TODO(fernando): what happend with Blockchain forks?
+        if (txs[tx].validation.current || txs[tx].validation.validated) {
+            ++hits_;
+            continue;
+        }
+
+        auto const count = txs[tx].inputs().size();
+        for (size_t input = 0; input < count; ++input) {
+            job->inputs.push_back({uint32_t(tx), uint32_t(input)});
+        }
+    }
+
+    result_handler complete_handler = std::bind(&validate_block::handle_connected, this, _1, block, job, handler);
+
+    if (job->inputs.empty()) {
+        complete_handler(error::success);
+        return;
+    }
+
+    // Small chunks keep the tail balanced when a few inputs are much more
+    // expensive than the rest, the cursor is cheap enough to hit often.
     auto const threads = priority_dispatch_.size();
-    auto const buckets = std::min(threads, non_coinbase_inputs);
-    KTH_ASSERT(buckets != 0);
+    job->chunk = std::clamp(job->inputs.size() / (threads * connect_chunks_per_task), size_t(1), max_connect_chunk);
+    auto const chunks = (job->inputs.size() + job->chunk - 1) / job->chunk;
+    auto const tasks = std::min(threads, chunks);
+    KTH_ASSERT(tasks != 0);
 
-    auto const join_handler = synchronize(std::move(complete_handler), buckets, NAME "_validate");
+    auto const join_handler = synchronize(std::move(complete_handler), tasks, NAME "_validate");
+    job->dispatched = asio::steady_clock::now();
 
-    for (size_t bucket = 0; bucket < buckets; ++bucket) {
-        priority_dispatch_.concurrent(&validate_block::connect_inputs, this, block, bucket, buckets, join_handler);
+    for (size_t task = 0; task < tasks; ++task) {
+        priority_dispatch_.concurrent(&validate_block::connect_inputs, this, block, job, join_handler);
     }
 }
 
-void validate_block::connect_inputs(block_const_ptr block, size_t bucket, size_t buckets, result_handler handler) const {
-    KTH_ASSERT(bucket < buckets);
+void validate_block::connect_inputs(block_const_ptr block, connect_job_ptr job, result_handler handler) const {
+    auto const start = asio::steady_clock::now();
+    job->queue += (start - job->dispatched).count();
+
     code ec(error::success);
     auto const forks = block->validation.state->enabled_forks();
     auto const& txs = block->transactions();
-    size_t position = 0;
+    auto const size = job->inputs.size();
 
 #if defined(KTH_CURRENCY_BCH)
-    size_t block_sigchecks = 0;
+    auto const max_sigchecks = block->validation.state->dynamic_max_block_sigchecks();
 #endif
 
     //TODO(fernando): count the coinbase sigchecks
 
-    // Must skip coinbase here as it is already accounted for.
-    for (auto tx = txs.begin() + 1; tx != txs.end(); ++tx) {
-        ++queries_;
+    auto const verify = [&](connect_job::input_ref const& ref) -> code {
+        auto const& tx = txs[ref.tx];
+        auto const& prevout = tx.inputs()[ref.input].previous_output();
 
-        // The tx is pooled with current fork state so outputs are validated.
-        if (tx->validation.current) {
-            ++hits_;
-            continue;
+        if ( ! prevout.validation.cache.is_valid()) {
+            return error::missing_previous_output;
         }
 
-        // The tx was validated before its insertion in the mempool
-        // TODO(fernando): what happend with Blockchain forks?
-        if (tx->validation.validated) {
-            ++hits_;
-            continue;
-        }
+        // Scripts already verified on mempool acceptance are not run again.
+        ++script_queries_;
+        size_t input_sigchecks;
+        auto const cached = script_cache_.find(tx.hash(), ref.input, forks);
 
-        size_t input_index;
-        auto const& inputs = tx->inputs();
-
-        for (input_index = 0; input_index < inputs.size(); ++input_index, ++position) {
-            if (position % buckets != bucket) {
-                continue;
+        if (cached) {
+            ++script_hits_;
+            input_sigchecks = *cached;
+        } else {
+            code verified;
+            std::tie(verified, input_sigchecks) = job->verifiers.get(ref.tx).verify(ref.input);
+            if (verified != error::success) {
+                return verified;
             }
+        }
 
-            if (stopped()) {
-                handler(error::service_stopped);
-                return;
-            }
+#if defined(KTH_CURRENCY_BCH)
+        // if (block_sigchecks > get_max_block_sigchecks(network_)) {
+        auto const block_sigchecks = job->sigchecks.fetch_add(input_sigchecks, std::memory_order_relaxed) + input_sigchecks;
+        if (block_sigchecks > max_sigchecks) {
+            return error::block_sigchecks_limit;
+        }
+#endif
+        return error::success;
+    };
+
+    for (auto first = job->next.fetch_add(job->chunk, std::memory_order_relaxed);
+         first < size && ! ec;
+         first = job->next.fetch_add(job->chunk, std::memory_order_relaxed)) {
 
-            auto const& prevout = inputs[input_index].previous_output();
+        auto const last = std::min(first + job->chunk, size);
 
-            if ( ! prevout.validation.cache.is_valid()) {
-                ec = error::missing_previous_output;
+        for (auto index = first; index < last; ++index) {
+            if (stopped()) {
+                ec = error::service_stopped;
                 break;
             }
 
-            size_t sigchecks;
-            std::tie(ec, sigchecks) = validate_input::verify_script(*tx, input_index, forks);
-            if (ec != error::success) {
+            // Another task already failed the block, the join reports
+            // only the first error.
+            if (job->failed.load(std::memory_order_relaxed)) {
                 break;
             }
 
-#if defined(KTH_CURRENCY_BCH)
-            block_sigchecks += sigchecks;
-            // if (block_sigchecks > get_max_block_sigchecks(network_)) {
-            if (block_sigchecks > block->validation.state->dynamic_max_block_sigchecks()) {
-                ec = error::block_sigchecks_limit;
+            auto const& ref = job->inputs[index];
+            ec = verify(ref);
+
+            if (ec) {
+                job->failed.store(true, std::memory_order_relaxed);
+                auto const height = block->validation.state->height();
+                dump(ec, txs[ref.tx], ref.input, forks, height);
                 break;
             }
-#endif
         }
 
-        if (ec) {
-            auto const height = block->validation.state->height();
-            dump(ec, *tx, input_index, forks, height);
+        if (job->failed.load(std::memory_order_relaxed)) {
             break;
         }
     }
 
+    job->execution += (asio::steady_clock::now() - start).count();
     handler(ec);
 }
 
@@ -360,8 +467,16 @@ float validate_block::hit_rate() const {
     return queries_ == 0 ? 0.0f : (hits_ * 1.0f / queries_);
 }
 
-void validate_block::handle_connected(code const& ec, block_const_ptr block, result_handler handler) const {
+// The script cache hit rate (over the inputs actually connected).
+float validate_block::script_hit_rate() const {
+    return script_queries_ == 0 ? 0.0f : (script_hits_ * 1.0f / script_queries_);
+}
+
+void validate_block::handle_connected(code const& ec, block_const_ptr block, connect_job_ptr job, result_handler handler) const {
     block->validation.cache_efficiency = hit_rate();
+    block->validation.script_cache_efficiency = script_hit_rate();
+    block->validation.connect_queue = asio::duration(job->queue.load());
+    block->validation.connect_execution = asio::duration(job->execution.load());
     handler(ec);
 }
 
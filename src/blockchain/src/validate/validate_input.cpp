@@ -210,46 +210,60 @@ coins_t create_context_data(transaction const& tx, bool should_create_context) {
     return coins;
 }
 
-std::pair<code, size_t> validate_input::verify_script(transaction const& tx, uint32_t input_index, uint32_t forks) {
-    constexpr bool prefix = false;
-
-    KTH_ASSERT(input_index < tx.inputs().size());
-    auto const& prevout = tx.inputs()[input_index].previous_output().validation;
-    auto const locking_script_data = prevout.cache.script().to_data(false);
-    auto const token_data = prevout.cache.token_data();
-    auto const amount = prevout.cache.value();
+inline
+consensus::verification_session create_session(transaction const& tx, uint32_t forks) {
     auto const tx_data = tx.to_data(true);
-
-    size_t sig_checks;
     bool const should_create_context = script::is_enabled(forks, domain::machine::rule_fork::bch_gauss);
     auto const coins = create_context_data(tx, should_create_context);
-    auto const unlock_script_data = tx.inputs()[input_index].script().to_data(prefix);
+    return consensus::verification_session(tx_data.data(), tx_data.size(), coins);
+}
+
+transaction_verifier::transaction_verifier(transaction const& tx, uint32_t forks)
+    : tx_(tx)
+    , flags_(validate_input::convert_flags(forks))
+    , session_(create_session(tx, forks))
+{}
+
+std::pair<code, size_t> transaction_verifier::verify(uint32_t input_index) const {
+    KTH_ASSERT(input_index < tx_.inputs().size());
+    auto const& prevout = tx_.inputs()[input_index].previous_output().validation;
+    auto const locking_script_data = prevout.cache.script().to_data(false);
 
-    auto res = consensus::verify_script(
-        tx_data.data(),
-        tx_data.size(),
+    size_t sig_checks;
+    auto const res = session_.verify_script(
         locking_script_data.data(),
         locking_script_data.size(),
-        unlock_script_data.data(),
-        unlock_script_data.size(),
         input_index,
-        convert_flags(forks),
-        sig_checks,
-        amount,
-        coins
+        flags_,
+        sig_checks
     );
 
-    return {convert_result(res), sig_checks};
+    return {validate_input::convert_result(res), sig_checks};
 }
 
 #else //WITH_CONSENSUS
 
 // #error Not supported, build using -o consensus=True
 
-std::pair<code, size_t> validate_input::verify_script(transaction const& tx, uint32_t input_index, uint32_t forks) {
-    return {script::verify(tx, input_index, forks), 0};
+transaction_verifier::transaction_verifier(transaction const& tx, uint32_t forks)
+    : tx_(tx)
+    , forks_(forks)
+{}
+
+std::pair<code, size_t> transaction_verifier::verify(uint32_t input_index) const {
+    return {script::verify(tx_, input_index, forks_), 0};
 }
 
 #endif //WITH_CONSENSUS
 
+std::pair<code, size_t> validate_input::verify_script(transaction const& tx, uint32_t input_index, uint32_t forks) {
+    return transaction_verifier(tx, forks).verify(input_index);
+}
+
+void validate_input::set_signature_cache_size(size_t bytes) {
+#ifdef WITH_CONSENSUS
+    consensus::set_signature_cache_size(bytes);
+#endif
+}
+
 } // namespace kth::blockchain
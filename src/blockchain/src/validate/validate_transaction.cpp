@@ -34,13 +34,14 @@ using namespace std::placeholders;
 
 
 #if defined(KTH_WITH_MEMPOOL)
-validate_transaction::validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, mining::mempool const& mp)
+validate_transaction::validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts, mining::mempool const& mp)
 #else
-validate_transaction::validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings)
+validate_transaction::validate_transaction(dispatcher& dispatch, fast_chain const& chain, settings const& settings, script_cache& scripts)
 #endif
   : stopped_(true),
     retarget_(settings.retarget),
     dispatch_(dispatch),
+    script_cache_(scripts),
 
 #if defined(KTH_WITH_MEMPOOL)
     transaction_populator_(dispatch, chain, mp),
@@ -124,14 +125,18 @@ void validate_transaction::connect(transaction_const_ptr tx, result_handler hand
     auto const join_handler = synchronize(handler, buckets, NAME "_validate");
     KTH_ASSERT(buckets != 0);
 
+    // The prevouts are populated, so the tx is parsed once for all buckets.
+    auto const forks = tx->validation.state->enabled_forks();
+    auto const verifier = std::make_shared<transaction_verifier const>(*tx, forks);
+
     // If the priority threadpool is shut down when this is called the handler
     // will never be invoked, resulting in a threadpool.join indefinite hang.
     for (size_t bucket = 0; bucket < buckets; ++bucket) {
-        dispatch_.concurrent(&validate_transaction::connect_inputs, this, tx, bucket, buckets, join_handler);
+        dispatch_.concurrent(&validate_transaction::connect_inputs, this, tx, verifier, bucket, buckets, join_handler);
     }
 }
 
-void validate_transaction::connect_inputs(transaction_const_ptr tx, size_t bucket, size_t buckets, result_handler handler) const {
+void validate_transaction::connect_inputs(transaction_const_ptr tx, transaction_verifier::const_ptr verifier, size_t bucket, size_t buckets, result_handler handler) const {
     KTH_ASSERT(bucket < buckets);
 
 #if defined(KTH_CURRENCY_BCH)
@@ -154,10 +159,19 @@ void validate_transaction::connect_inputs(transaction_const_ptr tx, size_t bucke
             return;
         }
 
-        auto res = validate_input::verify_script(*tx, input_index, forks);
-        if (res.first != error::success) {
-            handler(res.first);
-            return;
+        auto const tx_hash = tx->hash();
+        auto const cached = script_cache_.find(tx_hash, input_index, forks);
+        std::pair<code, size_t> res {error::success, cached.value_or(0)};
+
+        if ( ! cached) {
+            res = verifier->verify(input_index);
+            if (res.first != error::success) {
+                handler(res.first);
+                return;
+            }
+
+            // Block connect will find it already verified.
+            script_cache_.store(tx_hash, input_index, forks, res.second);
         }
 
 #if defined(KTH_CURRENCY_BCH)
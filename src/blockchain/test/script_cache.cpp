@@ -0,0 +1,55 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/blockchain.hpp>
+
+using namespace kth;
+using namespace kth::blockchain;
+
+// Start Test Suite: script cache tests
+
+TEST_CASE("script cache  find  empty  misses", "[script cache tests]") {
+    script_cache cache;
+    REQUIRE( ! cache.find(null_hash, 0, 0));
+    REQUIRE(cache.hits() == 0);
+    REQUIRE(cache.misses() == 1);
+}
+
+TEST_CASE("script cache  store  same key  hits with sigchecks", "[script cache tests]") {
+    script_cache cache;
+    cache.store(null_hash, 1, 42, 3);
+    auto const result = cache.find(null_hash, 1, 42);
+    REQUIRE(result);
+    REQUIRE(*result == 3);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("script cache  store  different forks or index  misses", "[script cache tests]") {
+    script_cache cache;
+    cache.store(null_hash, 1, 42, 3);
+    REQUIRE( ! cache.find(null_hash, 1, 43));
+    REQUIRE( ! cache.find(null_hash, 2, 42));
+    REQUIRE(cache.misses() == 2);
+}
+
+TEST_CASE("script cache  zero size  does not store", "[script cache tests]") {
+    script_cache cache(0);
+    cache.store(null_hash, 0, 0, 1);
+    REQUIRE( ! cache.find(null_hash, 0, 0));
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("script cache  store  beyond capacity  is bounded", "[script cache tests]") {
+    script_cache cache(64 * 1024);
+    for (uint32_t index = 0; index < 100000; ++index) {
+        cache.store(null_hash, index, 0, 1);
+    }
+    REQUIRE(cache.size() < 100000);
+    REQUIRE(cache.find(null_hash, 99999, 0));
+}
+
+// End Test Suite
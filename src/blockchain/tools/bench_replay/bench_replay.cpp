@@ -0,0 +1,374 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Replays the blocks of a local file through the block organizer against a
+// scratch database, without network, and reports the throughput and the
+// latency percentiles of each validation stage.
+//
+// The file holds consecutive raw (wire) serialized blocks, in chain order,
+// starting at the block following the genesis (a leading genesis is skipped).
+// The blocks already in the scratch database are skipped, so a directory
+// synced by a previous run can be reused as the base of the next one.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#define FMT_HEADER_ONLY 1
+#include <fmt/core.h>
+
+#include <kth/blockchain.hpp>
+#include <kth/database.hpp>
+
+using namespace kth;
+using namespace kth::blockchain;
+using namespace kd::chain;
+using namespace kth::database;
+using namespace std::filesystem;
+
+namespace {
+
+constexpr size_t read_chunk = 16 * 1024 * 1024;
+
+constexpr auto usage =
+    "Usage: kth-bench-replay <blocks-file> <scratch-directory> [options]\n"
+    "\n"
+    "Options:\n"
+    "  --network <name>             mainnet (default), testnet, regtest, testnet4, scalenet or chipnet\n"
+    "  --warmup <blocks>            blocks organized before the measured ones (default 0)\n"
+    "  --count <blocks>             measured blocks, zero for the rest of the file (default 0)\n"
+    "  --threads <count>            validation threads, zero for one per core (default 0)\n"
+    "  --cache-capacity <MB>        UTXO cache size, zero disables it\n"
+    "  --group-commit-blocks <n>    blocks per write transaction under the last checkpoint\n"
+    "  --no-checkpoints             validate every block (scripts included)\n"
+    "  --clean                      remove the scratch directory first\n";
+
+// Reads the blocks of the file, the buffer grows to hold the largest one.
+class block_file {
+public:
+    explicit
+    block_file(std::filesystem::path const& file)
+        : stream_(file, std::ios::binary)
+    {}
+
+    bool is_open() const {
+        return stream_.is_open();
+    }
+
+    // True if the end of the file is not the end of a block.
+    bool malformed() const {
+        return eof_ && begin_ != buffer_.size();
+    }
+
+    // Empty at the end of the file or on a malformed block.
+    std::optional<block> next() {
+        while (true) {
+            byte_reader reader(byte_span(buffer_.data() + begin_, buffer_.size() - begin_));
+            auto result = block::from_data(reader);
+
+            if (result) {
+                begin_ += reader.position();
+                return std::move(*result);
+            }
+
+            if (eof_) {
+                return {};
+            }
+
+            fill();
+        }
+    }
+
+private:
+    // Drops the consumed bytes and doubles the unread ones (at least a chunk),
+    // so a block is parsed a logarithmic number of times.
+    void fill() {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + begin_);
+        begin_ = 0;
+
+        auto const size = buffer_.size();
+        buffer_.resize(size + std::max(read_chunk, size));
+        stream_.read(reinterpret_cast<char*>(buffer_.data() + size), std::streamsize(buffer_.size() - size));
+        buffer_.resize(size + size_t(stream_.gcount()));
+        eof_ = ! stream_;
+    }
+
+    std::ifstream stream_;
+    data_chunk buffer_;
+    size_t begin_ = 0;
+    bool eof_ = false;
+};
+
+std::optional<domain::config::network> parse_network(std::string_view name) {
+    if (name == "mainnet") return domain::config::network::mainnet;
+    if (name == "testnet") return domain::config::network::testnet;
+    if (name == "regtest") return domain::config::network::regtest;
+#if defined(KTH_CURRENCY_BCH)
+    if (name == "testnet4") return domain::config::network::testnet4;
+    if (name == "scalenet") return domain::config::network::scalenet;
+    if (name == "chipnet") return domain::config::network::chipnet;
+#endif
+    return {};
+}
+
+block genesis(domain::config::network network) {
+    switch (network) {
+        case domain::config::network::testnet:
+            return block::genesis_testnet();
+        case domain::config::network::regtest:
+            return block::genesis_regtest();
+#if defined(KTH_CURRENCY_BCH)
+        case domain::config::network::testnet4:
+            return block::genesis_testnet4();
+        case domain::config::network::scalenet:
+            return block::genesis_scalenet();
+        case domain::config::network::chipnet:
+            return block::genesis_chipnet();
+#endif
+        default:
+        case domain::config::network::mainnet:
+            return block::genesis_mainnet();
+    }
+}
+
+uint64_t elapsed_us(kth::asio::time_point start, kth::asio::time_point end) {
+    if (start == kth::asio::time_point{} || end <= start) {
+        return 0;
+    }
+    return uint64_t(std::chrono::duration_cast<kth::asio::microseconds>(end - start).count());
+}
+
+// The stages of protocol_block_in::report.
+struct stages {
+    metrics::histogram deserialize;
+    metrics::histogram check;
+    metrics::histogram populate;
+    metrics::histogram accept;
+    metrics::histogram connect;
+    metrics::histogram push;
+    metrics::histogram validate;
+    metrics::histogram organize;
+
+    void record(block const& block, uint64_t organize_us) {
+        auto const& times = block.validation;
+        deserialize.record(elapsed_us(times.start_deserialize, times.end_deserialize));
+        check.record(elapsed_us(times.start_check, times.start_populate));
+        populate.record(elapsed_us(times.start_populate, times.start_accept));
+        accept.record(elapsed_us(times.start_accept, times.start_connect));
+        connect.record(elapsed_us(times.start_connect, times.start_notify));
+        push.record(elapsed_us(times.start_push, times.end_push));
+        validate.record(elapsed_us(times.start_check, times.start_notify));
+        organize.record(organize_us);
+    }
+};
+
+void print_stage(std::string_view name, metrics::histogram const& values) {
+    auto const count = values.count();
+    std::cout << fmt::format("{:<12} {:>12} {:>12} {:>12} {:>12} {:>12}\n", name,
+        count == 0 ? 0 : values.sum() / count,
+        values.quantile(0.5), values.quantile(0.9), values.quantile(0.99), values.quantile(1.0));
+}
+
+bool parse_number(char const* text, uint64_t& out) {
+    try {
+        size_t end;
+        out = std::stoull(text, &end);
+        return text[end] == '\0';
+    } catch (std::exception const&) {
+        return false;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << usage;
+        return -1;
+    }
+
+    std::filesystem::path const blocks_file(argv[1]);
+    std::filesystem::path const directory(argv[2]);
+
+    auto network = domain::config::network::mainnet;
+    uint64_t warmup = 0;
+    uint64_t count = 0;
+    uint64_t threads = 0;
+    std::optional<uint64_t> cache_capacity;
+    std::optional<uint64_t> group_commit_blocks;
+    bool checkpoints = true;
+    bool clean = false;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string_view const option(argv[i]);
+        auto const value = i + 1 < argc ? argv[i + 1] : nullptr;
+        uint64_t number = 0;
+
+        if (option == "--no-checkpoints") {
+            checkpoints = false;
+        } else if (option == "--clean") {
+            clean = true;
+        } else if (option == "--network" && value != nullptr && parse_network(value)) {
+            network = *parse_network(value);
+            ++i;
+        } else if (value != nullptr && parse_number(value, number) && (
+                option == "--warmup" || option == "--count" || option == "--threads" ||
+                option == "--cache-capacity" || option == "--group-commit-blocks")) {
+            if (option == "--warmup") warmup = number;
+            else if (option == "--count") count = number;
+            else if (option == "--threads") threads = number;
+            else if (option == "--cache-capacity") cache_capacity = number;
+            else group_commit_blocks = number;
+            ++i;
+        } else {
+            std::cerr << fmt::format("Invalid option '{}'.\n\n", option) << usage;
+            return -1;
+        }
+    }
+
+    block_file file(blocks_file);
+    if ( ! file.is_open()) {
+        std::cerr << fmt::format("Failed to open {}.\n", blocks_file.string());
+        return -1;
+    }
+
+    database::settings database_settings(network);
+    database_settings.directory = directory;
+
+    if (cache_capacity) {
+        database_settings.cache_capacity = uint32_t(*cache_capacity);
+    }
+
+    if (group_commit_blocks) {
+        database_settings.group_commit_blocks = uint32_t(*group_commit_blocks);
+    }
+
+    blockchain::settings chain_settings(network);
+    chain_settings.cores = uint32_t(threads);
+
+    if ( ! checkpoints) {
+        chain_settings.checkpoints.clear();
+    }
+
+    std::error_code ec;
+    if (clean) {
+        remove_all(directory, ec);
+    }
+
+    auto const genesis_block = genesis(network);
+
+    if ( ! exists(directory, ec)) {
+        if ( ! create_directories(directory, ec)) {
+            std::cerr << fmt::format("Failed to create directory {} with error, '{}'.\n", directory.string(), ec.message());
+            return -1;
+        }
+
+        if ( ! data_base(database_settings).create(genesis_block)) {
+            std::cerr << "Failed to initialize blockchain files.\n";
+            return -1;
+        }
+    }
+
+    threadpool pool("bench_replay", threads);
+    block_chain chain(pool, chain_settings, database_settings, network);
+
+    if ( ! chain.start()) {
+        std::cerr << "Failed to start the blockchain.\n";
+        return -1;
+    }
+
+    stages times;
+    uint64_t read = 0;
+    uint64_t skipped = 0;
+    uint64_t measured = 0;
+    uint64_t transactions = 0;
+    uint64_t inputs = 0;
+    kth::asio::duration busy{};
+    auto result = 0;
+
+    while (count == 0 || measured < count) {
+        auto const start_deserialize = kth::asio::steady_clock::now();
+        auto next = file.next();
+        auto const end_deserialize = kth::asio::steady_clock::now();
+
+        if ( ! next) {
+            if (file.malformed()) {
+                std::cerr << fmt::format("Malformed block after {} blocks.\n", read);
+                result = -1;
+            }
+            break;
+        }
+
+        if (read++ == 0 && next->hash() == genesis_block.hash()) {
+            continue;
+        }
+
+        auto const message = std::make_shared<domain::message::block const>(std::move(*next));
+        message->validation.start_deserialize = start_deserialize;
+        message->validation.end_deserialize = end_deserialize;
+
+        std::promise<code> organized;
+        auto const start_organize = kth::asio::steady_clock::now();
+        chain.organize(message, [&organized](code const& result) {
+            organized.set_value(result);
+        });
+        auto const organize_result = organized.get_future().get();
+        auto const end_organize = kth::asio::steady_clock::now();
+
+        if (organize_result == error::duplicate_block) {
+            ++skipped;
+            continue;
+        }
+
+        if (organize_result) {
+            std::cerr << fmt::format("Failed to organize block {}: {}.\n", encode_hash(message->hash()), organize_result.message());
+            result = -1;
+            break;
+        }
+
+        if (warmup != 0) {
+            --warmup;
+            continue;
+        }
+
+        ++measured;
+        transactions += message->transactions().size();
+        inputs += message->total_inputs();
+        busy += end_organize - start_organize + (end_deserialize - start_deserialize);
+        times.record(*message, elapsed_us(start_organize, end_organize));
+    }
+
+    size_t height = 0;
+    chain.get_last_height(height);
+    chain.close();
+
+    auto const seconds = std::chrono::duration<double>(busy).count();
+    auto const rate = [seconds](uint64_t value) {
+        return seconds > 0 ? double(value) / seconds : 0.0;
+    };
+
+    std::cout << fmt::format("Replayed {} blocks ({} skipped), top height {}.\n", measured, skipped, height);
+    std::cout << fmt::format("Measured {:.3f} s: {:.2f} blocks/s, {:.1f} txs/s, {:.1f} inputs/s.\n",
+        seconds, rate(measured), rate(transactions), rate(inputs));
+    std::cout << fmt::format("\n{:<12} {:>12} {:>12} {:>12} {:>12} {:>12}\n", "stage (us)", "mean", "p50", "p90", "p99", "max");
+
+    print_stage("deserialize", times.deserialize);
+    print_stage("check", times.check);
+    print_stage("populate", times.populate);
+    print_stage("accept", times.accept);
+    print_stage("connect", times.connect);
+    print_stage("push", times.push);
+    print_stage("validate", times.validate);
+    print_stage("organize", times.organize);
+
+    return result;
+}
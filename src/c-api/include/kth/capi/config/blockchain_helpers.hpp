@@ -72,6 +72,11 @@ Target blockchain_settings_to_common(Source const& x) {
     res.mempool_size_multiplier = x.mempool_size_multiplier;
 #endif
 
+    res.signature_cache_mb = x.signature_cache_mb;
+    res.script_cache_mb = x.script_cache_mb;
+    res.organize_pipeline_depth = x.organize_pipeline_depth;
+    res.transaction_pipeline_depth = x.transaction_pipeline_depth;
+
     return res;
 }
 
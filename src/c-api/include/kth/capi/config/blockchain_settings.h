@@ -89,6 +89,11 @@ typedef struct {
     kth_size_t mempool_max_template_size;
     kth_size_t mempool_size_multiplier;
 #endif
+
+    uint32_t signature_cache_mb;
+    uint32_t script_cache_mb;
+    uint32_t organize_pipeline_depth;
+    uint32_t transaction_pipeline_depth;
 } kth_blockchain_settings;
 
 KTH_EXPORT
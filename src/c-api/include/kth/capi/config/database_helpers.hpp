@@ -34,6 +34,8 @@ Target database_settings_to_common(Source const& x) {
     res.db_max_size = x.db_max_size;
     res.safe_mode = x.safe_mode;
     res.cache_capacity = x.cache_capacity;
+    res.group_commit_blocks = x.group_commit_blocks;
+    res.group_commit_size = x.group_commit_size;
     return res;
 }
 
@@ -20,6 +20,8 @@ typedef struct {
     uint64_t db_max_size;
     kth_bool_t safe_mode;
     uint32_t cache_capacity;
+    uint32_t group_commit_blocks;
+    uint32_t group_commit_size;
 
 } kth_database_settings;
 
@@ -82,6 +82,7 @@ kth::network::settings network_settings_to_cpp(kth_network_settings const& x) {
     res.peers = kth::capi::helpers::endpoint_list_to_cpp(x.peers, x.peer_count);
     res.seeds = kth::capi::helpers::endpoint_list_to_cpp(x.seeds, x.seed_count);
     res.statistics_server = kth::capi::helpers::authority_to_cpp(x.statistics_server);
+    res.metrics_server = kth::capi::helpers::authority_to_cpp(x.metrics_server);
     res.user_agent_blacklist = string_list_to_cpp(x.user_agent_blacklist, x.user_agent_blacklist_count);
     return res;
 }
@@ -98,6 +99,7 @@ kth_network_settings network_settings_to_c(kth::network::settings const& x) {
     res.peers = kth::capi::helpers::endpoint_list_to_c(x.peers, res.peer_count);
     res.seeds = kth::capi::helpers::endpoint_list_to_c(x.seeds, res.seed_count);
     res.statistics_server = kth::capi::helpers::authority_to_c(x.statistics_server);
+    res.metrics_server = kth::capi::helpers::authority_to_c(x.metrics_server);
     res.user_agent_blacklist = string_list_to_c(x.user_agent_blacklist, res.user_agent_blacklist_count);
     return res;
 }
@@ -113,6 +115,7 @@ void network_settings_delete(kth_network_settings* x) {
     kth::capi::helpers::endpoint_list_delete(x->peers, x->peer_count);
     kth::capi::helpers::endpoint_list_delete(x->seeds, x->seed_count);
     kth::capi::helpers::authority_delete(x->statistics_server);
+    kth::capi::helpers::authority_delete(x->metrics_server);
     string_list_delete(x->user_agent_blacklist, x->user_agent_blacklist_count);
 }
 
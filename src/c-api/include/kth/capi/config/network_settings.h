@@ -59,6 +59,7 @@ typedef struct {
     size_t maximum_archive_size;
     size_t maximum_archive_files;
     kth_authority statistics_server;
+    kth_authority metrics_server;
 
     kth_bool_t verbose;
     kth_bool_t use_ipv6;
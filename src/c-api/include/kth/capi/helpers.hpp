@@ -234,7 +234,7 @@ std::basic_string<CharT> create_cpp_str(CharT const* str) {
 
 template <typename N>
 inline
-uint8_t* create_c_array(kth::data_chunk const& arr, N& out_size) {
+uint8_t* create_c_array(kth::byte_span arr, N& out_size) {
     auto* ret = mnew<uint8_t>(arr.size());
     out_size = arr.size();
     std::copy_n(arr.begin(), arr.size(), ret);
@@ -10,43 +10,67 @@
 #include <kth/capi/error.h>
 #include <kth/capi/visibility.h>
 
+#ifdef __cplusplus
+#include <concepts>
+#include <vector>
+
+namespace kth::capi {
+
+// The C++ list behind a list handle, the element's own list type if it has one.
+template <typename T>
+struct cpp_list {
+    using type = std::vector<T>;
+};
+
+template <typename T>
+    requires std::same_as<typename T::list::value_type, T>
+struct cpp_list<T> {
+    using type = typename T::list;
+};
+
+template <typename T>
+using cpp_list_t = typename cpp_list<T>::type;
+
+} // namespace kth::capi
+#endif
+
 #define KTH_LIST_DECLARE_CONVERTERS(api, list_t, cpp_elem_t, list_name)  \
-std::vector<cpp_elem_t> const& kth_##api##_##list_name##_const_cpp(list_t l);      \
-std::vector<cpp_elem_t>& kth_##api##_##list_name##_cpp(list_t l);                  \
+kth::capi::cpp_list_t<cpp_elem_t> const& kth_##api##_##list_name##_const_cpp(list_t l);      \
+kth::capi::cpp_list_t<cpp_elem_t>& kth_##api##_##list_name##_cpp(list_t l);                  \
 
 #define KTH_LIST_DEFINE_CONVERTERS(api, list_t, cpp_elem_t, list_name)  \
-std::vector<cpp_elem_t> const& kth_##api##_##list_name##_const_cpp(list_t l) {    \
-    return *static_cast<std::vector<cpp_elem_t> const*>(l);                 \
+kth::capi::cpp_list_t<cpp_elem_t> const& kth_##api##_##list_name##_const_cpp(list_t l) {    \
+    return *static_cast<kth::capi::cpp_list_t<cpp_elem_t> const*>(l);                 \
 }                                                                           \
-std::vector<cpp_elem_t>& kth_##api##_##list_name##_cpp(list_t l) {                \
-    return *static_cast<std::vector<cpp_elem_t>*>(l);                       \
+kth::capi::cpp_list_t<cpp_elem_t>& kth_##api##_##list_name##_cpp(list_t l) {                \
+    return *static_cast<kth::capi::cpp_list_t<cpp_elem_t>*>(l);                       \
 }
 
 #define KTH_LIST_DECLARE_CONSTRUCT_FROM_CPP(api, list_t, cpp_elem_t, list_name)  \
-list_t kth_##api##_##list_name##_construct_from_cpp(std::vector<cpp_elem_t>& l);
+list_t kth_##api##_##list_name##_construct_from_cpp(kth::capi::cpp_list_t<cpp_elem_t>& l);
 
 #define KTH_LIST_DEFINE_CONSTRUCT_FROM_CPP(api, list_t, cpp_elem_t, list_name)     \
-list_t kth_##api##_##list_name##_construct_from_cpp(std::vector<cpp_elem_t>& l) {  \
+list_t kth_##api##_##list_name##_construct_from_cpp(kth::capi::cpp_list_t<cpp_elem_t>& l) {  \
     return &l;                                                                     \
 }
 
 #define KTH_LIST_DECLARE_CONSTRUCT_FROM_CPP_CONST(api, list_t, cpp_elem_t, list_name)  \
-void const* kth_##api##_##list_name##_construct_from_cpp(std::vector<cpp_elem_t> const& l);
+void const* kth_##api##_##list_name##_construct_from_cpp(kth::capi::cpp_list_t<cpp_elem_t> const& l);
 
 #define KTH_LIST_DEFINE_CONSTRUCT_FROM_CPP_CONST(api, list_t, cpp_elem_t, list_name)    \
-void const* kth_##api##_##list_name##_construct_from_cpp(std::vector<cpp_elem_t> const& l) { \
+void const* kth_##api##_##list_name##_construct_from_cpp(kth::capi::cpp_list_t<cpp_elem_t> const& l) { \
     return &l;                                                                          \
 }
 
 #define KTH_LIST_DECLARE_CONSTRUCT_FROM_CPP_BOTH(api, list_t, cpp_elem_t, list_name)  \
 KTH_LIST_DECLARE_CONSTRUCT_FROM_CPP(api, list_t, cpp_elem_t, list_name) \
 KTH_LIST_DECLARE_CONSTRUCT_FROM_CPP_CONST(api, list_t, cpp_elem_t, list_name) \
-void const* kth_##api##_##list_name##_construct_from_cpp_const(std::vector<cpp_elem_t> const& l);
+void const* kth_##api##_##list_name##_construct_from_cpp_const(kth::capi::cpp_list_t<cpp_elem_t> const& l);
 
 #define KTH_LIST_DEFINE_CONSTRUCT_FROM_CPP_BOTH(api, list_t, cpp_elem_t, list_name)    \
 KTH_LIST_DEFINE_CONSTRUCT_FROM_CPP(api, list_t, cpp_elem_t, list_name) \
 KTH_LIST_DEFINE_CONSTRUCT_FROM_CPP_CONST(api, list_t, cpp_elem_t, list_name) \
-void const* kth_##api##_##list_name##_construct_from_cpp_const(std::vector<cpp_elem_t> const& l) { \
+void const* kth_##api##_##list_name##_construct_from_cpp_const(kth::capi::cpp_list_t<cpp_elem_t> const& l) { \
     return &l;                                                                          \
 }
 
@@ -64,7 +88,7 @@ void const* kth_##api##_##list_name##_construct_from_cpp_const(std::vector<cpp_e
 
 #define KTH_LIST_DEFINE(api, list_t, elem_t, list_name, cpp_elem_t, value_converter)    \
 list_t kth_##api##_##list_name##_construct_default() {                                            \
-    return new std::vector<cpp_elem_t>();                                                   \
+    return new kth::capi::cpp_list_t<cpp_elem_t>();                                                   \
 }                                                                                           \
 void kth_##api##_##list_name##_push_back(list_t l, elem_t e) {                                    \
     kth_##api##_##list_name##_cpp(l).push_back(value_converter(e));                               \
@@ -82,7 +106,7 @@ elem_t kth_##api##_##list_name##_nth(list_t l, kth_size_t n) {
 
 #define KTH_LIST_DEFINE_VALUE(api, list_t, elem_t, list_name, cpp_elem_t, value_converter)  \
 list_t kth_##api##_##list_name##_construct_default() {                                                \
-    return new std::vector<cpp_elem_t>();                                                       \
+    return new kth::capi::cpp_list_t<cpp_elem_t>();                                                       \
 }                                                                                               \
 void kth_##api##_##list_name##_push_back(list_t l, elem_t e) {                                        \
     kth_##api##_##list_name##_cpp(l).push_back(value_converter(e));                                   \
@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <kth/consensus/define.hpp>
@@ -366,6 +367,85 @@ typedef enum verify_flags_type {
     int64_t amount,
     std::vector<std::vector<uint8_t>> coins);
 
+/**
+ * Signature cache counters, cumulative since process start.
+ */
+struct signature_cache_stats {
+    uint64_t hits;
+    uint64_t misses;
+    size_t entries;
+};
+
+/**
+ * Bound the memory of the process-wide signature cache consulted by
+ * verification sessions. A size of zero disables the cache.
+ * @param[in]  bytes  The approximate maximum memory used by the cache.
+ */
+BCK_API void set_signature_cache_size(size_t bytes);
+
+/**
+ * Get the signature cache hit/miss counters and current number of entries.
+ */
+BCK_API signature_cache_stats get_signature_cache_stats();
+
+/**
+ * Script verification state shared by all the inputs of a transaction.
+ * The transaction is deserialized, its coin contexts are created and its
+ * signature hash midstates are precomputed once, at construction. Inputs may
+ * then be verified in any order and concurrently through a const instance.
+ * Signature checks are served from (and recorded in) the signature cache.
+ */
+class BCK_API verification_session {
+public:
+    /**
+     * @param[in]  transaction       The transaction with the scripts to verify.
+     * @param[in]  transaction_size  The byte length of the transaction.
+     * @param[in]  coins             The serialized outputs spent by each input
+     *                               (same order as the inputs), or empty to
+     *                               verify without introspection context.
+     */
+    verification_session(
+        unsigned char const* transaction,
+        size_t transaction_size,
+        std::vector<std::vector<uint8_t>> const& coins);
+
+    ~verification_session();
+
+    verification_session(verification_session&& x) noexcept;
+    verification_session& operator=(verification_session&& x) noexcept;
+
+    verification_session(verification_session const&) = delete;
+    verification_session& operator=(verification_session const&) = delete;
+
+    /**
+     * verify_result_eval_true if the session is usable, otherwise the
+     * deserialization or context creation error, which is also returned
+     * by every call to verify_script.
+     */
+    verify_result_type status() const;
+
+    /**
+     * Verify that the input correctly spends the previous output. The
+     * unlocking script is taken from the session transaction.
+     * @param[in]  locking_script_data  The bytes of the locking script.
+     * @param[in]  locking_script_size  The byte length of the locking script.
+     * @param[in]  tx_input_index       The zero-based index of the input.
+     * @param[in]  flags                Verification constraint flags.
+     * @param[out] sig_checks           The sigchecks counted for the input.
+     * @returns                         A script verification result code.
+     */
+    verify_result_type verify_script(
+        unsigned char const* locking_script_data,
+        size_t locking_script_size,
+        unsigned int tx_input_index,
+        unsigned int flags,
+        size_t& sig_checks) const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+};
+
 } // namespace kth::consensus
 
 #endif
@@ -16,6 +16,7 @@
 #include <kth/consensus/export.hpp>
 #include <kth/consensus/version.hpp>
 
+#include "consensus/signature_cache.hpp"
 #include "primitives/transaction.h"
 #include "pubkey.h"
 #include "script/interpreter.h"
@@ -291,6 +292,135 @@ verify_result_type verify_script(
     return script_error_to_verify_result(error);
 }
 
+// verification_session
+//-----------------------------------------------------------------------------
+
+struct verification_session::impl {
+    impl(transaction_istream& stream)
+        : tx(deserialize, stream)
+    {}
+
+    CTransaction const tx;
+    std::vector<ScriptExecutionContext> contexts;
+    PrecomputedTransactionData txdata;
+    verify_result_type status = verify_result_eval_true;
+};
+
+verification_session::verification_session(
+    unsigned char const* transaction,
+    size_t transaction_size,
+    std::vector<std::vector<uint8_t>> const& coins) {
+
+    if (transaction_size > 0 && transaction == nullptr) {
+        throw std::invalid_argument("transaction");
+    }
+
+    try {
+        transaction_istream stream(transaction, transaction_size);
+        impl_ = std::make_unique<impl>(stream);
+    }
+    catch (const std::exception&) {
+        impl_.reset();
+        return;
+    }
+
+    if (GetSerializeSize(impl_->tx, PROTOCOL_VERSION) != transaction_size) {
+        impl_->status = verify_result_tx_size_invalid;
+        return;
+    }
+
+    if (coins.empty()) {
+        return;
+    }
+
+    if (coins.size() != impl_->tx.vin.size()) {
+        impl_->status = verify_result_tx_input_invalid;
+        return;
+    }
+
+    auto const output_getter = [&coins](size_t i) {
+        auto const& data = coins[i];
+        CDataStream stream(data, SER_NETWORK, PROTOCOL_VERSION);
+        CTxOut ret;
+        ::Unserialize(stream, ret);
+        return ret;
+    };
+
+    try {
+        impl_->contexts = ScriptExecutionContext::createForAllInputs(impl_->tx, output_getter);
+    }
+    catch (const std::exception&) {
+        impl_->status = verify_result_tx_input_invalid;
+        return;
+    }
+
+    // The sighash midstates are shared by all the inputs of the transaction.
+    if ( ! impl_->contexts.empty()) {
+        impl_->txdata.PopulateFromContext(impl_->contexts.front());
+    }
+}
+
+verification_session::~verification_session() = default;
+verification_session::verification_session(verification_session&& x) noexcept = default;
+verification_session& verification_session::operator=(verification_session&& x) noexcept = default;
+
+verify_result_type verification_session::status() const {
+    return impl_ ? impl_->status : verify_result_tx_invalid;
+}
+
+verify_result_type verification_session::verify_script(
+    unsigned char const* locking_script_data,
+    size_t locking_script_size,
+    unsigned int tx_input_index,
+    unsigned int flags,
+    size_t& sig_checks) const {
+
+    sig_checks = 0;
+
+    if (locking_script_size > 0 && locking_script_data == nullptr) {
+        throw std::invalid_argument("locking_script_data");
+    }
+
+    auto const result = status();
+    if (result != verify_result_eval_true) {
+        return result;
+    }
+
+    auto const& tx = impl_->tx;
+
+    if (tx_input_index >= tx.vin.size()) {
+        return verify_result_tx_input_invalid;
+    }
+
+    ScriptError error;
+    const unsigned int script_flags = verify_flags_to_script_flags(flags);
+
+    CScript const locking_script(locking_script_data, locking_script_data + locking_script_size);
+    auto const& unlocking_script = tx.vin[tx_input_index].scriptSig;
+
+    ScriptExecutionMetrics metrics = {};
+
+    if ( ! impl_->contexts.empty()) {
+        caching_signature_checker checker(impl_->contexts[tx_input_index], impl_->txdata);
+        VerifyScript(unlocking_script, locking_script, script_flags, checker, metrics, &error);
+    } else {
+        ScriptExecutionContextOpt context = std::nullopt;
+        ContextOptSignatureChecker checker(context);
+        VerifyScript(unlocking_script, locking_script, script_flags, checker, metrics, &error);
+    }
+
+    sig_checks = metrics.nSigChecks;
+    return script_error_to_verify_result(error);
+}
+
+void set_signature_cache_size(size_t bytes) {
+    signature_cache::instance().set_max_size(bytes);
+}
+
+signature_cache_stats get_signature_cache_stats() {
+    return signature_cache::instance().stats();
+}
+
 char const* version() {
     return KTH_CONSENSUS_VERSION;
 }
@@ -0,0 +1,125 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "consensus/signature_cache.hpp"
+
+#include <algorithm>
+
+#include "random.h"
+
+namespace kth::consensus {
+
+signature_cache& signature_cache::instance() {
+    static signature_cache cache;
+    return cache;
+}
+
+signature_cache::signature_cache()
+    : max_shard_entries_(default_size / entry_size / shard_count)
+    , hits_(0)
+    , misses_(0)
+{
+    std::array<uint8_t, 32> salt;
+    GetRandBytes(salt.data(), int(salt.size()));
+    salted_hasher_.Write(salt.data(), salt.size());
+}
+
+void signature_cache::set_max_size(size_t bytes) {
+    auto const entries = bytes / entry_size / shard_count;
+    max_shard_entries_ = entries;
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (shard.order.size() > entries) {
+            shard.keys.erase(shard.order.front());
+            shard.order.pop_front();
+        }
+    }
+}
+
+uint256 signature_cache::compute_key(std::vector<uint8_t> const& signature, CPubKey const& pubkey, uint256 const& sighash) const {
+    uint256 key{uint256::Uninitialized};
+
+    // Copy of the salted midstate.
+    CSHA256 hasher = salted_hasher_;
+    hasher
+        .Write(sighash.begin(), sighash.size())
+        .Write(pubkey.data(), pubkey.size())
+        .Write(signature.data(), signature.size())
+        .Finalize(key.begin());
+    return key;
+}
+
+signature_cache::shard& signature_cache::shard_for(uint256 const& key) {
+    return shards_[key.GetUint64(1) % shard_count];
+}
+
+bool signature_cache::contains(uint256 const& key) {
+    auto& shard = shard_for(key);
+    bool found;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        found = shard.keys.contains(key);
+    }
+
+    ++(found ? hits_ : misses_);
+    return found;
+}
+
+void signature_cache::insert(uint256 const& key) {
+    auto const max_entries = max_shard_entries_.load();
+    if (max_entries == 0) {
+        return;
+    }
+
+    auto& shard = shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if ( ! shard.keys.insert(key).second) {
+        return;
+    }
+
+    shard.order.push_back(key);
+
+    // Evict the oldest entries (FIFO).
+    while (shard.order.size() > max_entries) {
+        shard.keys.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+signature_cache_stats signature_cache::stats() const {
+    signature_cache_stats result {hits_.load(), misses_.load(), 0};
+
+    for (auto const& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result.entries += shard.keys.size();
+    }
+    return result;
+}
+
+// caching_signature_checker
+//-----------------------------------------------------------------------------
+
+bool caching_signature_checker::VerifySignature(std::vector<uint8_t> const& signature, CPubKey const& pubkey, uint256 const& sighash) const {
+    auto& cache = signature_cache::instance();
+    if ( ! cache.enabled()) {
+        return TransactionSignatureChecker::VerifySignature(signature, pubkey, sighash);
+    }
+
+    auto const key = cache.compute_key(signature, pubkey, sighash);
+
+    if (cache.contains(key)) {
+        return true;
+    }
+
+    if ( ! TransactionSignatureChecker::VerifySignature(signature, pubkey, sighash)) {
+        return false;
+    }
+
+    cache.insert(key);
+    return true;
+}
+
+} // namespace kth::consensus
@@ -0,0 +1,93 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_CONSENSUS_SIGNATURE_CACHE_HPP
+#define KTH_CONSENSUS_SIGNATURE_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <kth/consensus/define.hpp>
+#include <kth/consensus/export.hpp>
+
+#include "crypto/sha256.h"
+#include "pubkey.h"
+#include "script/interpreter.h"
+#include "uint256.h"
+
+namespace kth::consensus {
+
+// Bounded set of (sighash, pubkey, signature) triples known to be valid.
+// Entries are keyed by a salted hash so that the bucket layout cannot be
+// predicted by peers. This class is thread safe.
+class signature_cache {
+public:
+    static constexpr size_t default_size = 32 * 1024 * 1024;
+
+    static
+    signature_cache& instance();
+
+    signature_cache();
+
+    void set_max_size(size_t bytes);
+
+    bool enabled() const {
+        return max_shard_entries_ != 0;
+    }
+
+    uint256 compute_key(std::vector<uint8_t> const& signature, CPubKey const& pubkey, uint256 const& sighash) const;
+
+    bool contains(uint256 const& key);
+    void insert(uint256 const& key);
+
+    signature_cache_stats stats() const;
+
+private:
+    // Stored keys are already uniformly distributed.
+    struct key_hasher {
+        size_t operator()(uint256 const& key) const {
+            return size_t(key.GetUint64(0));
+        }
+    };
+
+    struct shard {
+        mutable std::mutex mutex;
+        std::unordered_set<uint256, key_hasher> keys;
+        std::deque<uint256> order;
+    };
+
+    static constexpr size_t shard_count = 16;
+
+    // Approximate memory used by an entry (key, node and eviction order).
+    static constexpr size_t entry_size = 3 * sizeof(uint256) + 2 * sizeof(void*);
+
+    shard& shard_for(uint256 const& key);
+
+    CSHA256 salted_hasher_;
+    std::array<shard, shard_count> shards_;
+    std::atomic<size_t> max_shard_entries_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+};
+
+// Transaction signature checker that consults the signature cache before
+// running the elliptic curve verification and records successful ones.
+class caching_signature_checker : public TransactionSignatureChecker {
+public:
+    caching_signature_checker(ScriptExecutionContext const& context, PrecomputedTransactionData const& txdata)
+        : TransactionSignatureChecker(context, txdata)
+    {}
+
+    bool VerifySignature(std::vector<uint8_t> const& signature, CPubKey const& pubkey, uint256 const& sighash) const override;
+};
+
+} // namespace kth::consensus
+
+#endif
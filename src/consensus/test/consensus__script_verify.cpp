@@ -235,6 +235,86 @@ TEST_CASE("consensus script verify valid nested p2wpkh true", "[consensus script
 }
 #endif
 
+#if defined(KTH_CURRENCY_BCH)
+static
+verify_result test_session_verify(std::string const& transaction, std::string const& prevout_script, std::vector<std::string> const& coins,
+    size_t& sig_checks, uint32_t tx_input_index=0, const uint32_t flags=verify_flags_p2sh) {
+    data_chunk tx_data, prevout_script_data;
+    std::vector<std::vector<uint8_t>> coins_data(coins.size());
+    REQUIRE(decode_base16(tx_data, transaction));
+    REQUIRE(decode_base16(prevout_script_data, prevout_script));
+
+    for (size_t i = 0; i < coins.size(); ++i) {
+        REQUIRE(decode_base16(coins_data[i], coins[i]));
+    }
+
+    verification_session const session(tx_data.data(), tx_data.size(), coins_data);
+    return session.verify_script(prevout_script_data.data(), prevout_script_data.size(), tx_input_index, flags, sig_checks);
+}
+
+// Serialized output: zero amount followed by the size-prefixed prevout script.
+#define CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN "000000000000000019" CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT
+
+TEST_CASE("consensus verification session null tx throws invalid argument", "[consensus script verify]") {
+    std::vector<std::vector<uint8_t>> coins;
+    REQUIRE_THROWS_AS(verification_session(NULL, 1, coins), std::invalid_argument);
+}
+
+TEST_CASE("consensus verification session invalid tx tx invalid", "[consensus script verify]") {
+    data_chunk tx_data;
+    std::vector<std::vector<uint8_t>> coins;
+    REQUIRE(decode_base16(tx_data, "42"));
+    verification_session const session(tx_data.data(), tx_data.size(), coins);
+    REQUIRE(session.status() == verify_result_tx_invalid);
+}
+
+TEST_CASE("consensus verification session coins mismatch tx input invalid", "[consensus script verify]") {
+    size_t sig_checks;
+    const verify_result result = test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT,
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN, CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks);
+    REQUIRE(result == verify_result_tx_input_invalid);
+}
+
+TEST_CASE("consensus verification session invalid input tx input invalid", "[consensus script verify]") {
+    size_t sig_checks;
+    const verify_result result = test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT,
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks, 1);
+    REQUIRE(result == verify_result_tx_input_invalid);
+}
+
+TEST_CASE("consensus verification session incorrect pubkey hash equalverify", "[consensus script verify]") {
+    size_t sig_checks;
+    const verify_result result = test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, "76a914c564c740c6900b93afc9f1bdaef0a9d466adf6ef88ac",
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks);
+    REQUIRE(result == verify_result_equalverify);
+}
+
+TEST_CASE("consensus verification session valid true", "[consensus script verify]") {
+    size_t sig_checks;
+    const verify_result result = test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT,
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks);
+    REQUIRE(result == verify_result_eval_true);
+    REQUIRE(sig_checks == 1);
+}
+
+TEST_CASE("consensus verification session repeated signature hits cache", "[consensus script verify]") {
+    size_t sig_checks;
+    REQUIRE(test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT,
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks) == verify_result_eval_true);
+
+    auto const before = get_signature_cache_stats();
+    REQUIRE(before.entries > 0);
+
+    REQUIRE(test_session_verify(CONSENSUS_SCRIPT_VERIFY_TX, CONSENSUS_SCRIPT_VERIFY_PREVOUT_SCRIPT,
+        {CONSENSUS_SCRIPT_VERIFY_PREVOUT_COIN}, sig_checks) == verify_result_eval_true);
+
+    auto const after = get_signature_cache_stats();
+    REQUIRE(after.hits == before.hits + 1);
+    REQUIRE(after.misses == before.misses);
+    REQUIRE(sig_checks == 1);
+}
+#endif
+
 // TODO: create negative test vector.
 //TEST_CASE("consensus script verify invalid false", "[consensus script verify]")
 //{
@@ -77,6 +77,11 @@ public:
 
     code prune_reorg();
 
+    /// The blocks below this height are written in groups by reorganize,
+    /// see settings::group_commit_blocks. They must not be populated from
+    /// the store, set it to the height of the last checkpoint.
+    void set_group_commit_height(size_t height);
+
     //bool set_database_flags(bool fast);
 
     // Asynchronous writers.
@@ -133,6 +138,7 @@ private:
 #endif // ! defined(KTH_DB_READONLY)
 
     std::atomic<bool> closed_;
+    std::atomic<size_t> group_commit_height_{0};
     settings const& settings_;
 };
 
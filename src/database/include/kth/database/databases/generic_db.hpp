@@ -32,6 +32,7 @@
 #define KTH_DB_LAST MDB_LAST
 #define KTH_DB_FIRST MDB_FIRST
 #define KTH_DB_DUPFIXED MDB_DUPFIXED
+#define KTH_DB_CURRENT MDB_CURRENT
 
 
 
@@ -39,6 +40,7 @@
 #define kth_db_cursor_close mdb_cursor_close
 #define kth_db_cursor_get mdb_cursor_get
 #define kth_db_cursor_del mdb_cursor_del
+#define kth_db_cursor_put mdb_cursor_put
 #define kth_db_txn_abort mdb_txn_abort
 #define kth_db_dbi_close mdb_dbi_close
 #define kth_db_env_sync mdb_env_sync
@@ -45,6 +45,77 @@ result_code internal_database_basis<Clock>::push_block_header(domain::chain::blo
 
     return result_code::success;
 }
+
+// The hash of each header is the previous block hash of the next one, only
+// the headers followed by a gap (insert) are hashed.
+template <typename Clock>
+bool internal_database_basis<Clock>::load_header_index() {
+    header_index_.clear();
+
+    uint32_t last_height;
+    auto const res = get_last_stored_height(last_height);
+    if (res == result_code::db_empty) {
+        return true;
+    }
+    if (res != result_code::success) {
+        return false;
+    }
+    header_index_.reserve(size_t(last_height) + 1);
+
+    KTH_DB_txn* db_txn;
+    if (kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn) != KTH_DB_SUCCESS) {
+        return false;
+    }
+
+    KTH_DB_cursor* cursor;
+    if (kth_db_cursor_open(db_txn, dbi_block_header_, &cursor) != KTH_DB_SUCCESS) {
+        kth_db_txn_commit(db_txn);
+        return false;
+    }
+
+    std::optional<header_with_abla_state_t> previous;
+    uint32_t previous_height = 0;
+    auto valid = true;
+
+    KTH_DB_val key;
+    KTH_DB_val value;
+    auto rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_FIRST);
+    while (rc == KTH_DB_SUCCESS) {
+        auto const height = *static_cast<uint32_t*>(kth_db_get_data(key));
+        auto data = db_value_to_data_chunk(value);
+        byte_reader reader(data);
+        auto entry = get_header_and_abla_state_from_data(reader);
+        if ( ! entry) {
+            LOG_ERROR(LOG_DATABASE, "Invalid block header at height ", height, " [load_header_index]");
+            valid = false;
+            break;
+        }
+
+        if (previous) {
+            auto const hash = height == previous_height + 1 ? std::get<0>(*entry).previous_block_hash() : std::get<0>(*previous).hash();
+            header_index_.push(*previous, hash, previous_height);
+        }
+
+        previous = std::move(*entry);
+        previous_height = height;
+        rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_NEXT);
+    }
+
+    kth_db_cursor_close(cursor);
+    kth_db_txn_commit(db_txn);
+
+    if ( ! valid) {
+        header_index_.clear();
+        return false;
+    }
+
+    if (previous) {
+        header_index_.push(*previous, std::get<0>(*previous).hash(), previous_height);
+    }
+
+    LOG_INFO(LOG_DATABASE, "Header index loaded, ", header_index_.size(), " headers.");
+    return true;
+}
 #endif // ! defined(KTH_DB_READONLY)
 
 template <typename Clock>
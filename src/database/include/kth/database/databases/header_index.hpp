@@ -0,0 +1,98 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DATABASE_HEADER_INDEX_HPP_
+#define KTH_DATABASE_HEADER_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <kth/domain.hpp>
+#include <kth/database/define.hpp>
+#include <kth/database/databases/header_abla_entry.hpp>
+
+namespace kth::database {
+
+/// In memory copy of the header chain, one entry per height.
+/// The fields are kept in contiguous arrays so that the chain state and the
+/// header and locator queries do not open a store transaction, deserialize
+/// or hash a header. The previous block hash of a header is the hash at the
+/// previous height, it is only kept for the headers after a gap (insert).
+/// This class is thread safe.
+class KD_API header_index {
+public:
+    /// The number of headers.
+    size_t size() const;
+
+    /// The last height, std::nullopt if empty.
+    std::optional<uint32_t> top() const;
+
+    void reserve(size_t count);
+
+    /// Sets the header at the given height, usually the next one.
+    /// A height above the next one leaves a gap, a height already set is
+    /// ignored.
+    void push(domain::chain::block const& block, uint32_t height);
+    void push(header_with_abla_state_t const& header, hash_digest const& hash, uint32_t height);
+
+    /// Removes the headers from the given height, inclusive.
+    void truncate(uint32_t height);
+
+    void clear();
+
+    std::optional<uint32_t> height(hash_digest const& hash) const;
+    std::optional<hash_digest> hash(uint32_t height) const;
+    std::optional<header_with_abla_state_t> header(uint32_t height) const;
+
+    /// The headers in [from, to], truncated at the top or the first gap.
+    domain::chain::header::list headers(uint32_t from, uint32_t to) const;
+
+    /// The sum of the proof of the headers in [from, to], truncated at the
+    /// top. std::nullopt if from is above the top.
+    std::optional<uint256_t> work(uint32_t from, uint32_t to) const;
+
+private:
+    struct abla_state {
+        uint64_t block_size;
+        uint64_t control_block_size;
+        uint64_t elastic_buffer_size;
+    };
+
+    // Block hashes are uniformly distributed, any 8 bytes will do.
+    struct hash_prefix {
+        size_t operator()(hash_digest const& hash) const {
+            uint64_t value;
+            std::memcpy(&value, hash.data(), sizeof(value));
+            return size_t(value);
+        }
+    };
+
+    // precondition: mutex_ is held
+    void set(domain::chain::header const& header, hash_digest const& hash, abla_state const& abla, uint32_t height);
+    void accumulate_work(size_t from);
+    domain::chain::header make_header(size_t height) const;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<bool> present_;
+    std::vector<hash_digest> hashes_;
+    std::vector<hash_digest> merkles_;
+    std::vector<uint32_t> versions_;
+    std::vector<uint32_t> timestamps_;
+    std::vector<uint32_t> bits_;
+    std::vector<uint32_t> nonces_;
+    std::vector<uint256_t> work_;               // cumulative, through the height
+    std::vector<abla_state> abla_;
+    boost::unordered_flat_map<hash_digest, uint32_t, hash_prefix> heights_;
+    boost::unordered_flat_map<uint32_t, hash_digest> previous_;    // after a gap
+};
+
+} // namespace kth::database
+
+#endif // KTH_DATABASE_HEADER_INDEX_HPP_
@@ -5,7 +5,10 @@
 #ifndef KTH_DATABASE_INTERNAL_DATABASE_HPP_
 #define KTH_DATABASE_INTERNAL_DATABASE_HPP_
 
+#include <algorithm>
 #include <filesystem>
+#include <mutex>
+#include <shared_mutex>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/interprocess/mapped_region.hpp>
@@ -20,13 +23,16 @@
 #include <kth/database/define.hpp>
 
 #include <kth/database/databases/header_abla_entry.hpp>
+#include <kth/database/databases/header_index.hpp>
 #include <kth/database/databases/result_code.hpp>
 #include <kth/database/databases/property_code.hpp>
 #include <kth/database/databases/tools.hpp>
+#include <kth/database/databases/utxo_cache.hpp>
 #include <kth/database/databases/utxo_entry.hpp>
 #include <kth/database/databases/history_entry.hpp>
 #include <kth/database/databases/transaction_entry.hpp>
 #include <kth/database/databases/transaction_unconfirmed_entry.hpp>
+#include <kth/database/databases/unconfirmed_address_index.hpp>
 
 // #include <kth/infrastructure.hpp>
 
@@ -57,6 +63,9 @@ constexpr size_t max_dbs_pruned_ = 7;       // KTH_DB_NEW_PRUNED
 constexpr size_t env_open_mode_ = 0664;
 constexpr int directory_exists = 0;
 
+// Values re-encoded per write transaction by the utxo_format migration.
+constexpr size_t utxo_migration_batch_size = 100'000;
+
 template <typename Clock = std::chrono::system_clock>
 class KD_API internal_database_basis {
 public:
@@ -81,7 +90,7 @@ public:
     constexpr static char spend_db_name[] = "spend";
     constexpr static char transaction_unconfirmed_db_name[] = "transaction_unconfirmed";
 
-    internal_database_basis(path const& db_dir, db_mode_type mode, uint32_t reorg_pool_limit, uint64_t db_max_size, bool safe_mode);
+    internal_database_basis(path const& db_dir, db_mode_type mode, uint32_t reorg_pool_limit, uint64_t db_max_size, bool safe_mode, uint32_t cache_capacity = 0, uint32_t group_commit_blocks = 0, uint32_t group_commit_size = 0);
     ~internal_database_basis();
 
     // Non-copyable, non-movable
@@ -101,16 +110,39 @@ public:
     //TODO(fernando): optimization: consider passing a list of outputs to insert and a list of inputs to delete instead of an entire Block.
     //                  avoiding inserting and erasing internal spenders
     result_code push_block(domain::chain::block const& block, uint32_t height, uint32_t median_time_past);
+
+    /// The block is kept in memory and written together with the following
+    /// ones in a single transaction, every group_commit_blocks blocks or
+    /// group_commit_size MB. Only for blocks that are not populated from the
+    /// store (under the last checkpoint): until written, the header queries
+    /// see the pending blocks but the block, transaction and UTXO ones do not.
+    /// If writing them fails they stay pending, since they were reported as
+    /// pushed, and every other block write fails until a commit succeeds.
+    result_code push_block_deferred(std::shared_ptr<domain::chain::block const> const& block, uint32_t height, uint32_t median_time_past);
+
+    /// Writes the blocks accumulated by push_block_deferred, if any. Also
+    /// retries them after a failed write.
+    result_code commit_pending_blocks();
 #endif
 
     utxo_entry get_utxo(domain::chain::output_point const& point) const;
 
+    /// Batch lookup, the entries are returned in the order of the points.
+    /// The misses are sorted by key and resolved with a single read
+    /// transaction and a forward cursor walk.
+    std::vector<utxo_entry> get_utxos(std::vector<domain::chain::output_point const*> const& points) const;
+
     result_code get_last_height(uint32_t& out_height) const;
 
     std::pair<domain::chain::header, uint32_t> get_header(hash_digest const& hash) const;
     domain::chain::header get_header(uint32_t height) const;
     domain::chain::header::list get_headers(uint32_t from, uint32_t to) const;
     std::optional<header_with_abla_state_t> get_header_and_abla_state(uint32_t height) const;
+    std::optional<hash_digest> get_block_hash(uint32_t height) const;
+
+    /// The sum of the proof of the headers in [from, to], truncated at the
+    /// last height. std::nullopt if from is above the last height.
+    std::optional<uint256_t> get_work(uint32_t from, uint32_t to) const;
 
 #if ! defined(KTH_DB_READONLY)
     result_code pop_block(domain::chain::block& out_block);
@@ -136,6 +168,13 @@ public:
 
     transaction_unconfirmed_entry get_transaction_unconfirmed(hash_digest const& hash) const;
 
+    /// The hashes of the unconfirmed transactions, none is deserialized.
+    hash_list get_unconfirmed_hashes() const;
+
+    /// The payments of the unconfirmed transactions to and from each address,
+    /// in the order of the addresses.
+    std::vector<std::vector<unconfirmed_address_index::entry>> get_unconfirmed_history(std::vector<domain::wallet::payment_address> const& addresses) const;
+
 #if ! defined(KTH_DB_READONLY)
     result_code push_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height);
 #endif // ! defined(KTH_DB_READONLY)
@@ -144,10 +183,42 @@ private:
 
 #if ! defined(KTH_DB_READONLY)
     bool create_db_mode_property();
+
+    bool create_utxo_format_property(KTH_DB_txn* db_txn);
+
+    bool migrate_utxo_format();
+
+    bool migrate_utxo_values(KTH_DB_dbi dbi, uint8_t table, data_chunk& last_key, size_t& migrated);
+
+    bool save_utxo_migration_cursor(KTH_DB_txn* db_txn, uint8_t table, data_chunk const& last_key);
+
+    bool get_utxo_migration_cursor(uint8_t& table, data_chunk& last_key) const;
 #endif
 
     bool verify_db_mode_property() const;
 
+    bool verify_durable_height_property() const;
+
+    result_code get_last_stored_height(uint32_t& out_height) const;
+
+    uint32_t get_utxo_format_property() const;
+
+#if ! defined(KTH_DB_READONLY)
+    result_code flush_utxo_cache(KTH_DB_txn* db_txn);
+
+    result_code drop_utxo_cache();
+
+    result_code recover_utxo_cache();
+
+    result_code truncate_block(uint32_t height, KTH_DB_txn* db_txn);
+
+    result_code write_blocks(domain::chain::block const* block, uint32_t height, uint32_t median_time_past);
+
+    void fail_pending_blocks();
+
+    bool load_header_index();
+#endif
+
     bool open_internal();
 
     bool is_old_block(domain::chain::block const& block) const;
@@ -163,6 +234,8 @@ private:
     utxo_entry get_utxo(domain::chain::output_point const& point, KTH_DB_txn* db_txn) const;
 
 #if ! defined(KTH_DB_READONLY)
+    utxo_entry get_utxo_unflushed(domain::chain::output_point const& point, KTH_DB_txn* db_txn) const;
+
     result_code insert_reorg_pool(uint32_t height, KTH_DB_val& key, KTH_DB_txn* db_txn);
 
     result_code remove_utxo(uint32_t height, domain::chain::output_point const& point, bool insert_reorg, KTH_DB_txn* db_txn);
@@ -279,13 +352,17 @@ private:
 
     result_code remove_transaction_spend_db(domain::chain::transaction const& tx, KTH_DB_txn* db_txn);
 
-    result_code insert_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height, KTH_DB_txn* db_txn);
+    result_code insert_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height, uint32_t arrival_time, KTH_DB_txn* db_txn);
 
     result_code remove_transaction_unconfirmed(hash_digest const& tx_id,  KTH_DB_txn* db_txn);
 #endif
 
     transaction_unconfirmed_entry get_transaction_unconfirmed(hash_digest const& hash, KTH_DB_txn* db_txn) const;
 
+    std::vector<domain::chain::output> get_unconfirmed_prevouts(domain::chain::transaction const& tx) const;
+
+    void index_unconfirmed(unconfirmed_address_index& index) const;
+
 
 #if ! defined(KTH_DB_READONLY)
     result_code update_transaction(domain::chain::transaction const& tx, uint32_t height, uint32_t median_time_past, uint32_t position, KTH_DB_txn* db_txn);
@@ -343,6 +420,40 @@ private:
     KTH_DB_dbi dbi_history_db_;
     KTH_DB_dbi dbi_spend_db_;
     KTH_DB_dbi dbi_transaction_unconfirmed_db_;
+
+    // UTXO write-back cache
+    // Readers take the mutex shared, the writer takes it exclusive only to
+    // commit a block and publish its UTXO changes in the cache atomically.
+    mutable std::shared_mutex utxo_cache_mutex_;
+    utxo_cache utxo_cache_;
+    utxo_cache_batch utxo_batch_;           // changes of the block being pushed
+    bool utxo_write_back_ = false;          // the block being pushed does not write utxo_db
+    bool utxo_unflushed_ = false;           // utxo_db is behind the last block
+
+    // Header chain, the pending blocks included (not in read-only builds,
+    // the store is written by another process).
+    header_index header_index_;
+
+    // Address index of transaction_unconfirmed (full mode, not in read-only
+    // builds). The transactions confirmed by a block are removed from it
+    // once the block is committed.
+    unconfirmed_address_index unconfirmed_index_;
+    std::vector<hash_digest> unconfirmed_removed_;
+
+    // IBD group commit
+    // Only accessed by the writer, the readers see the pending blocks
+    // through the header index.
+    struct pending_block {
+        std::shared_ptr<domain::chain::block const> block;
+        uint32_t height;
+        uint32_t median_time_past;
+    };
+
+    std::vector<pending_block> pending_blocks_;                 // contiguous heights
+    size_t pending_size_ = 0;
+    bool pending_failed_ = false;                               // refuses the block writes
+    uint32_t const group_commit_blocks_;
+    size_t const group_commit_size_;
 };
 
 template <typename Clock>
@@ -7,19 +7,23 @@
 
 // #include <kth/infrastructure.hpp>
 #include <kth/infrastructure/log/source.hpp>
+#include <kth/infrastructure/utility/metrics.hpp>
 
 namespace kth::database {
 
 using utxo_pool_t = std::unordered_map<domain::chain::point, utxo_entry>;
 
 template <typename Clock>
-internal_database_basis<Clock>::internal_database_basis(path const& db_dir, db_mode_type mode, uint32_t reorg_pool_limit, uint64_t db_max_size, bool safe_mode)
+internal_database_basis<Clock>::internal_database_basis(path const& db_dir, db_mode_type mode, uint32_t reorg_pool_limit, uint64_t db_max_size, bool safe_mode, uint32_t cache_capacity, uint32_t group_commit_blocks, uint32_t group_commit_size)
     : db_dir_(db_dir)
     , db_mode_(mode)
     , reorg_pool_limit_(reorg_pool_limit)
     , limit_(blocks_to_seconds(reorg_pool_limit))
     , db_max_size_(db_max_size)
     , safe_mode_(safe_mode)
+    , utxo_cache_(size_t(cache_capacity) * 1024 * 1024)     // cache_capacity is expressed in MB
+    , group_commit_blocks_(group_commit_blocks)
+    , group_commit_size_(size_t(group_commit_size) * 1024 * 1024)   // group_commit_size is expressed in MB
 {}
 
 template <typename Clock>
@@ -53,9 +57,214 @@ bool internal_database_basis<Clock>::create() {
         return false;
     }
 
+    header_index_.clear();
     return true;
 }
 
+template <typename Clock>
+bool internal_database_basis<Clock>::create_utxo_format_property(KTH_DB_txn* db_txn) {
+    property_code property = property_code::utxo_format;
+    auto format = utxo_format_compact;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    auto value = kth_db_make_value(sizeof(format), &format);
+
+    auto res = kth_db_put(db_txn, dbi_properties_, &key, &value, 0);
+    if (res != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Failed saving in DB Properties [create_utxo_format_property] ", static_cast<int32_t>(res));
+        return false;
+    }
+    return true;
+}
+
+// Re-encodes every utxo_db and reorg_pool value in the compact format.
+// Each batch of utxo_migration_batch_size values is committed in its own
+// write transaction along with the last key migrated, so the dirty pages
+// stay bounded and an interrupted migration resumes where it stopped.
+template <typename Clock>
+bool internal_database_basis<Clock>::migrate_utxo_format() {
+    LOG_INFO(LOG_DATABASE, "Migrating the UTXO set to the compact format, this may take a while...");
+
+    uint8_t table;
+    data_chunk last_key;
+    if ( ! get_utxo_migration_cursor(table, last_key)) {
+        return false;
+    }
+
+    if ( ! last_key.empty() || table != utxo_migration_utxo_db) {
+        LOG_INFO(LOG_DATABASE, "Resuming an interrupted UTXO set migration.");
+    }
+
+    size_t migrated = 0;
+    if (table == utxo_migration_utxo_db) {
+        if ( ! migrate_utxo_values(dbi_utxo_, utxo_migration_utxo_db, last_key, migrated)) {
+            return false;
+        }
+        last_key.clear();
+    }
+
+    if ( ! migrate_utxo_values(dbi_reorg_pool_, utxo_migration_reorg_pool, last_key, migrated)) {
+        return false;
+    }
+
+    KTH_DB_txn* db_txn;
+    auto res = kth_db_txn_begin(env_, NULL, 0, &db_txn);
+    if (res != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [migrate_utxo_format] ", res);
+        return false;
+    }
+
+    property_code property = property_code::utxo_migration_cursor;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    res = kth_db_del(db_txn, dbi_properties_, &key, NULL);
+    if ((res != KTH_DB_SUCCESS && res != KTH_DB_NOTFOUND) || ! create_utxo_format_property(db_txn)) {
+        LOG_ERROR(LOG_DATABASE, "Error finishing the UTXO set migration [migrate_utxo_format] ", res);
+        kth_db_txn_abort(db_txn);
+        return false;
+    }
+
+    res = kth_db_txn_commit(db_txn);
+    if (res != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [migrate_utxo_format] ", res);
+        return false;
+    }
+
+    LOG_INFO(LOG_DATABASE, "UTXO set migrated to the compact format, ", migrated, " values re-encoded.");
+    return true;
+}
+
+// Migrates the values of dbi after last_key, one batch per write transaction.
+// last_key is updated to the last key migrated.
+template <typename Clock>
+bool internal_database_basis<Clock>::migrate_utxo_values(KTH_DB_dbi dbi, uint8_t table, data_chunk& last_key, size_t& migrated) {
+    while (true) {
+        KTH_DB_txn* db_txn;
+        auto res = kth_db_txn_begin(env_, NULL, 0, &db_txn);
+        if (res != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [migrate_utxo_values] ", res);
+            return false;
+        }
+
+        KTH_DB_cursor* cursor;
+        if (kth_db_cursor_open(db_txn, dbi, &cursor) != KTH_DB_SUCCESS) {
+            kth_db_txn_abort(db_txn);
+            return false;
+        }
+
+        KTH_DB_val key;
+        KTH_DB_val value;
+        int rc;
+        if (last_key.empty()) {
+            rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_FIRST);
+        } else {
+            key = kth_db_make_value(last_key.size(), last_key.data());
+            rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_SET_RANGE);
+            if (rc == KTH_DB_SUCCESS && db_value_to_data_chunk(key) == last_key) {
+                rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_NEXT);
+            }
+        }
+
+        size_t count = 0;
+        while (rc == KTH_DB_SUCCESS && count < utxo_migration_batch_size) {
+            auto data = db_value_to_data_chunk(value);
+            byte_reader reader(data);
+            auto entry = utxo_entry::from_data_legacy(reader);
+            if ( ! entry) {
+                LOG_ERROR(LOG_DATABASE, "Error decoding a legacy UTXO [migrate_utxo_values]");
+                kth_db_cursor_close(cursor);
+                kth_db_txn_abort(db_txn);
+                return false;
+            }
+
+            auto current_key = db_value_to_data_chunk(key);
+            auto valuearr = entry->to_data();
+            auto new_value = kth_db_make_value(valuearr.size(), valuearr.data());
+            rc = kth_db_cursor_put(cursor, &key, &new_value, KTH_DB_CURRENT);
+            if (rc != KTH_DB_SUCCESS) {
+                LOG_ERROR(LOG_DATABASE, "Error replacing a UTXO [migrate_utxo_values] ", rc);
+                kth_db_cursor_close(cursor);
+                kth_db_txn_abort(db_txn);
+                return false;
+            }
+
+            last_key = std::move(current_key);
+            ++count;
+            rc = kth_db_cursor_get(cursor, &key, &value, KTH_DB_NEXT);
+        }
+        kth_db_cursor_close(cursor);
+
+        if (rc != KTH_DB_SUCCESS && rc != KTH_DB_NOTFOUND) {
+            LOG_ERROR(LOG_DATABASE, "Error reading the UTXO set [migrate_utxo_values] ", rc);
+            kth_db_txn_abort(db_txn);
+            return false;
+        }
+
+        if ( ! save_utxo_migration_cursor(db_txn, table, last_key)) {
+            kth_db_txn_abort(db_txn);
+            return false;
+        }
+
+        res = kth_db_txn_commit(db_txn);
+        if (res != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [migrate_utxo_values] ", res);
+            return false;
+        }
+
+        migrated += count;
+        if (rc == KTH_DB_NOTFOUND) {
+            return true;
+        }
+        LOG_INFO(LOG_DATABASE, "UTXO set migration: ", migrated, " values re-encoded...");
+    }
+}
+
+template <typename Clock>
+bool internal_database_basis<Clock>::save_utxo_migration_cursor(KTH_DB_txn* db_txn, uint8_t table, data_chunk const& last_key) {
+    data_chunk cursor;
+    cursor.reserve(1 + last_key.size());
+    cursor.push_back(table);
+    cursor.insert(cursor.end(), last_key.begin(), last_key.end());
+
+    property_code property = property_code::utxo_migration_cursor;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    auto value = kth_db_make_value(cursor.size(), cursor.data());
+
+    auto res = kth_db_put(db_txn, dbi_properties_, &key, &value, 0);
+    if (res != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Failed saving in DB Properties [save_utxo_migration_cursor] ", static_cast<int32_t>(res));
+        return false;
+    }
+    return true;
+}
+
+// A missing cursor means the migration starts from the first utxo_db value.
+template <typename Clock>
+bool internal_database_basis<Clock>::get_utxo_migration_cursor(uint8_t& table, data_chunk& last_key) const {
+    table = utxo_migration_utxo_db;
+    last_key.clear();
+
+    KTH_DB_txn* db_txn;
+    auto res = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
+    if (res != KTH_DB_SUCCESS) {
+        return false;
+    }
+
+    property_code property = property_code::utxo_migration_cursor;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    KTH_DB_val value;
+
+    res = kth_db_get(db_txn, dbi_properties_, &key, &value);
+    if (res == KTH_DB_SUCCESS) {
+        auto const cursor = db_value_to_data_chunk(value);
+        if ( ! cursor.empty()) {
+            table = cursor.front();
+            last_key.assign(cursor.begin() + 1, cursor.end());
+        }
+    }
+
+    kth_db_txn_commit(db_txn);
+    return res == KTH_DB_SUCCESS || res == KTH_DB_NOTFOUND;
+}
+
 template <typename Clock>
 bool internal_database_basis<Clock>::create_db_mode_property() {
 
@@ -76,6 +285,11 @@ bool internal_database_basis<Clock>::create_db_mode_property() {
         return false;
     }
 
+    if ( ! create_utxo_format_property(db_txn)) {
+        kth_db_txn_abort(db_txn);
+        return false;
+    }
+
     res = kth_db_txn_commit(db_txn);
     if (res != KTH_DB_SUCCESS) {
         return false;
@@ -100,6 +314,43 @@ bool internal_database_basis<Clock>::open() {
         return false;
     }
 
+    auto const utxo_format = get_utxo_format_property();
+    if (utxo_format != utxo_format_compact) {
+        if (utxo_format != utxo_format_legacy) {
+            LOG_ERROR(LOG_DATABASE, "Unknown UTXO set format: ", utxo_format);
+            return false;
+        }
+
+#if defined(KTH_DB_READONLY)
+        LOG_ERROR(LOG_DATABASE, "The UTXO set uses the legacy format, open the database once in read-write mode to migrate it.");
+        return false;
+#else
+        if ( ! migrate_utxo_format()) {
+            LOG_ERROR(LOG_DATABASE, "Error migrating the UTXO set to the compact format.");
+            return false;
+        }
+#endif
+    }
+
+    ret = verify_durable_height_property();
+    if ( ! ret ) {
+        return false;
+    }
+
+#if ! defined(KTH_DB_READONLY)
+    if (recover_utxo_cache() != result_code::success) {
+        LOG_ERROR(LOG_DATABASE, "Error recovering the UTXO set after an unclean shutdown.");
+        return false;
+    }
+
+    if ( ! load_header_index()) {
+        LOG_ERROR(LOG_DATABASE, "Error loading the header index.");
+        return false;
+    }
+
+    index_unconfirmed(unconfirmed_index_);
+#endif
+
     return true;
 }
 
@@ -154,10 +405,78 @@ bool internal_database_basis<Clock>::verify_db_mode_property() const {
     return true;
 }
 
+template <typename Clock>
+uint32_t internal_database_basis<Clock>::get_utxo_format_property() const {
+    KTH_DB_txn* db_txn;
+    auto res = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
+    if (res != KTH_DB_SUCCESS) {
+        return max_uint32;
+    }
+
+    property_code property = property_code::utxo_format;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    KTH_DB_val value;
+
+    res = kth_db_get(db_txn, dbi_properties_, &key, &value);
+    if (res != KTH_DB_SUCCESS) {
+        kth_db_txn_commit(db_txn);
+        return res == KTH_DB_NOTFOUND ? utxo_format_legacy : max_uint32;
+    }
+
+    auto const format = *static_cast<uint32_t*>(kth_db_get_data(value));
+    kth_db_txn_commit(db_txn);
+    return format;
+}
+
+// The group commits are synced to disk, a store below the last of them lost
+// data that was durable.
+template <typename Clock>
+bool internal_database_basis<Clock>::verify_durable_height_property() const {
+    KTH_DB_txn* db_txn;
+    auto res = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
+    if (res != KTH_DB_SUCCESS) {
+        return false;
+    }
+
+    property_code property = property_code::durable_height;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    KTH_DB_val value;
+
+    res = kth_db_get(db_txn, dbi_properties_, &key, &value);
+    if (res != KTH_DB_SUCCESS) {
+        kth_db_txn_abort(db_txn);
+        return res == KTH_DB_NOTFOUND;
+    }
+    auto const durable_height = *static_cast<uint32_t*>(kth_db_get_data(value));
+    kth_db_txn_commit(db_txn);
+
+    uint32_t last_height;
+    if (get_last_stored_height(last_height) != result_code::success || last_height < durable_height) {
+        LOG_ERROR(LOG_DATABASE, "The database lost blocks below the last durable height ", durable_height, ", it is corrupted.");
+        return false;
+    }
+
+    LOG_INFO(LOG_DATABASE, "Last durable height ", durable_height, ", last height ", last_height, ".");
+    return true;
+}
+
 template <typename Clock>
 bool internal_database_basis<Clock>::close() {
     if (db_opened_) {
 
+#if ! defined(KTH_DB_READONLY)
+        if ( ! succeed(commit_pending_blocks())) {
+            LOG_ERROR(LOG_DATABASE, "Error writing the pending blocks, they will be downloaded again.");
+        }
+
+        if (drop_utxo_cache() != result_code::success) {
+            LOG_ERROR(LOG_DATABASE, "Error flushing the UTXO cache, it will be recovered on the next start.");
+        }
+
+        header_index_.clear();
+        unconfirmed_index_.clear();
+#endif
+
         //TODO(fernando): check sync
         //Force synchronous flush (use with KTH_DB_NOSYNC or MDB_NOMETASYNC, with other flags do nothing)
         kth_db_env_sync(env_, true);
@@ -212,6 +531,8 @@ result_code internal_database_basis<Clock>::push_genesis(domain::chain::block co
     if (res2 != KTH_DB_SUCCESS) {
         return result_code::other;
     }
+
+    header_index_.push(block, 0);
     return res;
 }
 
@@ -220,27 +541,207 @@ result_code internal_database_basis<Clock>::push_genesis(domain::chain::block co
 
 template <typename Clock>
 result_code internal_database_basis<Clock>::push_block(domain::chain::block const& block, uint32_t height, uint32_t median_time_past) {
+    if (pending_failed_) {
+        return result_code::other;
+    }
+
+    // The pending blocks go first, in the same transaction.
+    return write_blocks(&block, height, median_time_past);
+}
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::push_block_deferred(std::shared_ptr<domain::chain::block const> const& block, uint32_t height, uint32_t median_time_past) {
+    if (pending_failed_) {
+        return result_code::other;
+    }
+
+    if (group_commit_blocks_ == 0) {
+        return push_block(*block, height, median_time_past);
+    }
+
+    if ( ! pending_blocks_.empty() && height != pending_blocks_.back().height + 1) {
+        auto res = commit_pending_blocks();
+        if ( ! succeed(res)) {
+            return res;
+        }
+    }
+
+    if (header_index_.height(block->hash())) {
+        LOG_INFO(LOG_DATABASE, "Duplicate block pending to be written [push_block_deferred]");
+        return result_code::duplicated_key;
+    }
+
+    pending_blocks_.push_back({block, height, median_time_past});
+    pending_size_ += block->serialized_size();
+    header_index_.push(*block, height);
+
+    auto const full = pending_blocks_.size() >= group_commit_blocks_ ||
+                      (group_commit_size_ != 0 && pending_size_ >= group_commit_size_);
+
+    return full ? commit_pending_blocks() : result_code::success;
+}
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::commit_pending_blocks() {
+    if (pending_blocks_.empty()) {
+        return result_code::success;
+    }
+    return write_blocks(nullptr, 0, 0);
+}
+
+// The pending blocks were reported as pushed, they stay visible and the
+// writes that would build on them are refused. The store stays at the last
+// commit, which is where it recovers from.
+template <typename Clock>
+void internal_database_basis<Clock>::fail_pending_blocks() {
+    if (pending_blocks_.empty()) {
+        return;
+    }
+
+    LOG_ERROR(LOG_DATABASE, "Error writing the pending blocks from height ", pending_blocks_.front().height, ", no other block is written.");
+    pending_failed_ = true;
+}
+
+// Writes the pending blocks followed by the given one, if any, in a single
+// transaction. On a failure the store stays at the last commit.
+template <typename Clock>
+result_code internal_database_basis<Clock>::write_blocks(domain::chain::block const* block, uint32_t height, uint32_t median_time_past) {
+    static auto& written = metrics::default_registry().make_counter("kth_database_blocks_written_total", "Blocks committed to the store.");
+    static auto& write_time = metrics::default_registry().make_histogram("kth_database_write_microseconds", "Time to write and commit a group of blocks.");
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const grouped = ! pending_blocks_.empty();
+    auto const count = pending_blocks_.size() + (block != nullptr ? 1 : 0);
+    unconfirmed_removed_.clear();
 
     KTH_DB_txn* db_txn;
     auto res0 = kth_db_txn_begin(env_, NULL, 0, &db_txn);
     if (res0 != KTH_DB_SUCCESS) {
-        LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [push_block] ", res0);
+        LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [write_blocks] ", res0);
+        fail_pending_blocks();
         return result_code::other;
     }
 
     //TODO: save reorg blocks after the last checkpoint
-    auto res = push_block(block, height, median_time_past, ! is_old_block(block), db_txn);
+    auto const insert_reorg = block != nullptr && ! is_old_block(*block);
+    auto const any_reorg = insert_reorg || std::any_of(pending_blocks_.begin(), pending_blocks_.end(), [this](auto const& entry) {
+        return ! is_old_block(*entry.block);
+    });
+
+    // UTXO writes are deferred to the cache only for blocks out of the reorg
+    // window, the reorg pool is always filled from a complete utxo_db.
+    auto const write_back = utxo_cache_.enabled() && ! any_reorg;
+    auto const pending = utxo_cache_.dirty() != 0 || utxo_unflushed_;
+    auto const flush = pending && (any_reorg || utxo_cache_.full());
+
+    if (flush) {
+        auto res = flush_utxo_cache(db_txn);
+        if (res != result_code::success) {
+            kth_db_txn_abort(db_txn);
+            fail_pending_blocks();
+            return res;
+        }
+    }
+
+    auto first_height = grouped ? pending_blocks_.front().height : height;
+    auto last_height = block != nullptr ? height : pending_blocks_.back().height;
+
+    if (write_back && (flush || ! utxo_unflushed_)) {
+        property_code property = property_code::utxo_unflushed_height;
+        auto key = kth_db_make_value(sizeof(property), &property);
+        auto value = kth_db_make_value(sizeof(first_height), &first_height);
+        auto res = kth_db_put(db_txn, dbi_properties_, &key, &value, 0);
+        if (res != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error saving the UTXO cache height [write_blocks] ", res);
+            kth_db_txn_abort(db_txn);
+            fail_pending_blocks();
+            return result_code::other;
+        }
+    }
+
+    utxo_write_back_ = write_back;
+    auto res = result_code::success;
+    for (auto const& entry : pending_blocks_) {
+        res = push_block(*entry.block, entry.height, entry.median_time_past, ! is_old_block(*entry.block), db_txn);
+        if ( ! succeed(res)) {
+            break;
+        }
+    }
+
+    if (succeed(res) && block != nullptr) {
+        res = push_block(*block, height, median_time_past, insert_reorg, db_txn);
+    }
+    utxo_write_back_ = false;
+
     if ( !  succeed(res)) {
         kth_db_txn_abort(db_txn);
+        utxo_batch_.clear();
+        fail_pending_blocks();
         return res;
     }
 
-    auto res2 = kth_db_txn_commit(db_txn);
-    if (res2 != KTH_DB_SUCCESS) {
-        LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [push_block] ", res2);
-        return result_code::other;
+    if (grouped) {
+        property_code property = property_code::durable_height;
+        auto key = kth_db_make_value(sizeof(property), &property);
+        auto value = kth_db_make_value(sizeof(last_height), &last_height);
+        auto res1 = kth_db_put(db_txn, dbi_properties_, &key, &value, 0);
+        if (res1 != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error saving the durable height [write_blocks] ", res1);
+            kth_db_txn_abort(db_txn);
+            utxo_batch_.clear();
+            fail_pending_blocks();
+            return result_code::other;
+        }
+    }
+
+    {
+        std::unique_lock lock(utxo_cache_mutex_);
+
+        auto res2 = kth_db_txn_commit(db_txn);
+        if (res2 != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [write_blocks] ", res2);
+            utxo_batch_.clear();
+            fail_pending_blocks();
+            return result_code::other;
+        }
+
+        if (utxo_cache_.enabled()) {
+            if (flush) {
+                utxo_cache_.mark_flushed();
+                utxo_unflushed_ = false;
+            }
+
+            utxo_cache_.apply(utxo_batch_, write_back);
+            utxo_batch_.clear();
+            utxo_unflushed_ = utxo_unflushed_ || write_back;
+
+            if (utxo_cache_.full()) {
+                utxo_cache_.evict();
+            }
+        }
+    }
+
+    pending_blocks_.clear();
+    pending_size_ = 0;
+    pending_failed_ = false;
+
+    if (block != nullptr) {
+        header_index_.push(*block, height);
+    }
+
+    for (auto const& hash : unconfirmed_removed_) {
+        unconfirmed_index_.remove(hash);
+    }
+    unconfirmed_removed_.clear();
+
+    // The environment is opened with NOSYNC, the group commits are the
+    // points the store can always be recovered to.
+    if (grouped) {
+        kth_db_env_sync(env_, true);
     }
 
+    written.add(count);
+    write_time.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
     return res;
 }
 
@@ -268,9 +769,59 @@ utxo_entry internal_database_basis<Clock>::get_utxo(domain::chain::output_point
     return *res;
 }
 
+#if ! defined(KTH_DB_READONLY)
+
+// Writer-side lookup, also sees the UTXO changes not yet written to utxo_db.
+template <typename Clock>
+utxo_entry internal_database_basis<Clock>::get_utxo_unflushed(domain::chain::output_point const& point, KTH_DB_txn* db_txn) const {
+    data_chunk const* data = nullptr;
+
+    auto const pending = utxo_batch_.find(point);
+    if (pending != utxo_batch_.end()) {
+        if ( ! pending->second) {
+            return utxo_entry{};
+        }
+        data = &*pending->second;
+    } else {
+        auto const cached = utxo_cache_.find(point);
+        if ( ! cached.cached) {
+            return get_utxo(point, db_txn);
+        }
+        data = cached.value;
+    }
+
+    if (data == nullptr) {
+        return utxo_entry{};
+    }
+
+    byte_reader reader(*data);
+    auto res = utxo_entry::from_data(reader);
+    if ( ! res) {
+        return utxo_entry{};
+    }
+    return *res;
+}
+
+#endif // ! defined(KTH_DB_READONLY)
+
 template <typename Clock>
 utxo_entry internal_database_basis<Clock>::get_utxo(domain::chain::output_point const& point) const {
 
+    std::shared_lock lock(utxo_cache_mutex_);
+    auto const cached = utxo_cache_.find(point);
+    if (cached.cached) {
+        if (cached.value == nullptr) {
+            return utxo_entry{};
+        }
+
+        byte_reader reader(*cached.value);
+        auto res = utxo_entry::from_data(reader);
+        if ( ! res) {
+            return utxo_entry{};
+        }
+        return *res;
+    }
+
     KTH_DB_txn* db_txn;
     auto res0 = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
     if (res0 != KTH_DB_SUCCESS) {
@@ -289,8 +840,95 @@ utxo_entry internal_database_basis<Clock>::get_utxo(domain::chain::output_point
     return ret;
 }
 
+template <typename Clock>
+std::vector<utxo_entry> internal_database_basis<Clock>::get_utxos(std::vector<domain::chain::output_point const*> const& points) const {
+    std::vector<utxo_entry> result(points.size());
+
+    // Serialized keys of the points not in the cache, with their position.
+    std::vector<std::pair<data_chunk, size_t>> misses;
+    misses.reserve(points.size());
+
+    std::shared_lock lock(utxo_cache_mutex_);
+    for (size_t i = 0; i < points.size(); ++i) {
+        auto const cached = utxo_cache_.find(*points[i]);
+        if ( ! cached.cached) {
+            misses.emplace_back(points[i]->to_data(KTH_INTERNAL_DB_WIRE), i);
+            continue;
+        }
+
+        if (cached.value == nullptr) {
+            continue;
+        }
+
+        byte_reader reader(*cached.value);
+        auto res = utxo_entry::from_data(reader);
+        if (res) {
+            result[i] = std::move(*res);
+        }
+    }
+
+    if (misses.empty()) {
+        return result;
+    }
+
+    // LMDB key order (memcmp), consecutive keys usually share the leaf page
+    // so the cursor does not descend from the root for every lookup.
+    std::sort(misses.begin(), misses.end());
+
+    KTH_DB_txn* db_txn;
+    auto res0 = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
+    if (res0 != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [get_utxos] ", res0);
+        return result;
+    }
+
+    KTH_DB_cursor* cursor;
+    if (kth_db_cursor_open(db_txn, dbi_utxo_, &cursor) != KTH_DB_SUCCESS) {
+        kth_db_txn_commit(db_txn);
+        return result;
+    }
+
+    for (auto& [keyarr, position] : misses) {
+        auto key = kth_db_make_value(keyarr.size(), keyarr.data());
+        KTH_DB_val value;
+        if (kth_db_cursor_get(cursor, &key, &value, MDB_SET) != KTH_DB_SUCCESS) {
+            continue;
+        }
+
+        auto data = db_value_to_data_chunk(value);
+        byte_reader reader(data);
+        auto res = utxo_entry::from_data(reader);
+        if (res) {
+            result[position] = std::move(*res);
+        }
+    }
+
+    kth_db_cursor_close(cursor);
+
+    res0 = kth_db_txn_commit(db_txn);
+    if (res0 != KTH_DB_SUCCESS) {
+        LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [get_utxos] ", res0);
+    }
+
+    return result;
+}
+
 template <typename Clock>
 result_code internal_database_basis<Clock>::get_last_height(uint32_t& out_height) const {
+#if ! defined(KTH_DB_READONLY)
+    auto const top = header_index_.top();
+    if ( ! top) {
+        return result_code::db_empty;
+    }
+    out_height = *top;
+    return result_code::success;
+#else
+    return get_last_stored_height(out_height);
+#endif
+}
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::get_last_stored_height(uint32_t& out_height) const {
     KTH_DB_txn* db_txn;
     auto res = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
     if (res != KTH_DB_SUCCESS) {
@@ -306,6 +944,8 @@ result_code internal_database_basis<Clock>::get_last_height(uint32_t& out_height
     KTH_DB_val key;
     int rc;
     if ((rc = kth_db_cursor_get(cursor, &key, nullptr, KTH_DB_LAST)) != KTH_DB_SUCCESS) {
+        kth_db_cursor_close(cursor);
+        kth_db_txn_commit(db_txn);
         return result_code::db_empty;
     }
 
@@ -324,6 +964,18 @@ result_code internal_database_basis<Clock>::get_last_height(uint32_t& out_height
 
 template <typename Clock>
 std::pair<domain::chain::header, uint32_t> internal_database_basis<Clock>::get_header(hash_digest const& hash) const {
+#if ! defined(KTH_DB_READONLY)
+    auto const height = header_index_.height(hash);
+    if ( ! height) {
+        return {};
+    }
+
+    auto const entry = header_index_.header(*height);
+    if ( ! entry) {
+        return {};
+    }
+    return {std::get<0>(*entry), *height};
+#else
     auto key  = kth_db_make_value(hash.size(), const_cast<hash_digest&>(hash).data());
 
     KTH_DB_txn* db_txn;
@@ -349,10 +1001,18 @@ std::pair<domain::chain::header, uint32_t> internal_database_basis<Clock>::get_h
     }
 
     return {header, height};
+#endif
 }
 
 template <typename Clock>
 domain::chain::header internal_database_basis<Clock>::get_header(uint32_t height) const {
+#if ! defined(KTH_DB_READONLY)
+    auto const entry = header_index_.header(height);
+    if ( ! entry) {
+        return {};
+    }
+    return std::get<0>(*entry);
+#else
     KTH_DB_txn* db_txn;
     auto ret1 = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
     if (ret1 != KTH_DB_SUCCESS) {
@@ -366,10 +1026,14 @@ domain::chain::header internal_database_basis<Clock>::get_header(uint32_t height
     }
 
     return ret2;
+#endif
 }
 
 template <typename Clock>
 std::optional<header_with_abla_state_t> internal_database_basis<Clock>::get_header_and_abla_state(uint32_t height) const {
+#if ! defined(KTH_DB_READONLY)
+    return header_index_.header(height);
+#else
     KTH_DB_txn* db_txn;
     auto zzz = kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn);
     if (zzz != KTH_DB_SUCCESS) {
@@ -383,11 +1047,15 @@ std::optional<header_with_abla_state_t> internal_database_basis<Clock>::get_head
     }
 
     return res;
+#endif
 }
 
 template <typename Clock>
 domain::chain::header::list internal_database_basis<Clock>::get_headers(uint32_t from, uint32_t to) const {
     // precondition: from <= to
+#if ! defined(KTH_DB_READONLY)
+    return header_index_.headers(from, to);
+#else
     domain::chain::header::list list;
 
     KTH_DB_txn* db_txn;
@@ -433,6 +1101,40 @@ domain::chain::header::list internal_database_basis<Clock>::get_headers(uint32_t
     kth_db_cursor_close(cursor);
     kth_db_txn_commit(db_txn);
     return list;
+#endif
+}
+
+template <typename Clock>
+std::optional<hash_digest> internal_database_basis<Clock>::get_block_hash(uint32_t height) const {
+#if ! defined(KTH_DB_READONLY)
+    return header_index_.hash(height);
+#else
+    auto const header = get_header(height);
+    if ( ! header.is_valid()) {
+        return {};
+    }
+    return header.hash();
+#endif
+}
+
+template <typename Clock>
+std::optional<uint256_t> internal_database_basis<Clock>::get_work(uint32_t from, uint32_t to) const {
+#if ! defined(KTH_DB_READONLY)
+    return header_index_.work(from, to);
+#else
+    uint256_t work = 0;
+    for (auto height = from; height <= to; ++height) {
+        auto const header = get_header(height);
+        if ( ! header.is_valid()) {
+            if (height == from) {
+                return {};
+            }
+            break;
+        }
+        work += header.proof();
+    }
+    return work;
+#endif
 }
 
 #if ! defined(KTH_DB_READONLY)
@@ -441,6 +1143,11 @@ template <typename Clock>
 result_code internal_database_basis<Clock>::pop_block(domain::chain::block& out_block) {
     uint32_t height;
 
+    auto res0 = commit_pending_blocks();
+    if ( ! succeed(res0)) {
+        return res0;
+    }
+
     //TODO: (Mario) use only one transaction ?
 
     //TODO: (Mario) add overload with tx
@@ -451,6 +1158,12 @@ result_code internal_database_basis<Clock>::pop_block(domain::chain::block& out_
     }
 
     //TODO: (Mario) add overload with tx
+    // The reorg pool and utxo_db must be complete before undoing the block.
+    res = drop_utxo_cache();
+    if (res != result_code::success) {
+        return res;
+    }
+
     // This should never become invalid if this call is protected.
     out_block = get_block_reorg(height);
     if ( ! out_block.is_valid()) {
@@ -462,6 +1175,7 @@ result_code internal_database_basis<Clock>::pop_block(domain::chain::block& out_
         return res;
     }
 
+    header_index_.truncate(height);
     return result_code::success;
 }
 
@@ -633,13 +1347,15 @@ std::pair<result_code, utxo_pool_t> internal_database_basis<Clock>::get_utxo_poo
 
 template <typename Clock>
 result_code internal_database_basis<Clock>::push_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height) {
+    auto const arrival_time = get_clock_now();
+    auto const prevouts = get_unconfirmed_prevouts(tx);
 
     KTH_DB_txn* db_txn;
     if (kth_db_txn_begin(env_, NULL, 0, &db_txn) != KTH_DB_SUCCESS) {
         return result_code::other;
     }
 
-    auto res = insert_transaction_unconfirmed(tx, height, db_txn);
+    auto res = insert_transaction_unconfirmed(tx, height, arrival_time, db_txn);
     if (res != result_code::success) {
         kth_db_txn_abort(db_txn);
         return res;
@@ -649,6 +1365,7 @@ result_code internal_database_basis<Clock>::push_transaction_unconfirmed(domain:
         return result_code::other;
     }
 
+    unconfirmed_index_.add(tx, arrival_time, prevouts);
     return result_code::success;
 }
 
@@ -975,7 +1692,7 @@ result_code internal_database_basis<Clock>::push_block(domain::chain::block cons
         return res0;
     }
 
-    fixed.back() = 0;
+    fixed = utxo_entry::to_data_fixed(height, median_time_past, false);
     res = push_transactions_non_coinbase(height, fixed, txs.begin() + 1, txs.end(), insert_reorg, db_txn);
     if (res != result_code::success) {
         return res;
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <istream>
 
 #include <boost/program_options.hpp>
@@ -17,8 +18,21 @@ namespace kth::database {
 
 enum class property_code {
     db_mode = 0,
+    utxo_unflushed_height = 1,      // first height whose UTXO changes are only in the cache
+    utxo_format = 2,                // encoding of the utxo_db and reorg_pool values
+    durable_height = 3,             // last height synced to disk by a group commit
+    utxo_migration_cursor = 4,      // table and last key re-encoded by an unfinished utxo_format migration
 };
 
+// The utxo_format property is absent in databases created before the
+// compact UTXO encoding, those are read as legacy.
+constexpr uint32_t utxo_format_legacy = 0;
+constexpr uint32_t utxo_format_compact = 1;
+
+// Tables of the utxo_migration_cursor, migrated in this order.
+constexpr uint8_t utxo_migration_utxo_db = 0;
+constexpr uint8_t utxo_migration_reorg_pool = 1;
+
 enum class db_mode_type {
     pruned,
     blocks,
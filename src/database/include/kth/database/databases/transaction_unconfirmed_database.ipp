@@ -96,6 +96,97 @@ std::vector<transaction_unconfirmed_entry> internal_database_basis<Clock>::get_a
     return result;
 }
 
+template <typename Clock>
+hash_list internal_database_basis<Clock>::get_unconfirmed_hashes() const {
+#if ! defined(KTH_DB_READONLY)
+    return unconfirmed_index_.transactions();
+#else
+    // The store is written by another process, only the keys are read.
+    hash_list result;
+
+    KTH_DB_txn* db_txn;
+    if (kth_db_txn_begin(env_, NULL, KTH_DB_RDONLY, &db_txn) != KTH_DB_SUCCESS) {
+        return result;
+    }
+
+    KTH_DB_cursor* cursor;
+    if (kth_db_cursor_open(db_txn, dbi_transaction_unconfirmed_db_, &cursor) != KTH_DB_SUCCESS) {
+        kth_db_txn_commit(db_txn);
+        return result;
+    }
+
+    KTH_DB_val key;
+    KTH_DB_val value;
+    while (kth_db_cursor_get(cursor, &key, &value, KTH_DB_NEXT) == KTH_DB_SUCCESS) {
+        if (kth_db_get_size(key) == hash_size) {
+            result.push_back(hash_digest{});
+            std::copy_n(static_cast<uint8_t const*>(kth_db_get_data(key)), hash_size, result.back().begin());
+        }
+    }
+
+    kth_db_cursor_close(cursor);
+    kth_db_txn_commit(db_txn);
+    return result;
+#endif
+}
+
+template <typename Clock>
+std::vector<std::vector<unconfirmed_address_index::entry>> internal_database_basis<Clock>::get_unconfirmed_history(std::vector<domain::wallet::payment_address> const& addresses) const {
+    std::vector<std::vector<unconfirmed_address_index::entry>> result;
+    result.reserve(addresses.size());
+
+#if ! defined(KTH_DB_READONLY)
+    auto const& index = unconfirmed_index_;
+#else
+    // The store is written by another process, the index is built per query.
+    unconfirmed_address_index index;
+    index_unconfirmed(index);
+#endif
+
+    for (auto const& address : addresses) {
+        result.push_back(index.find(address));
+    }
+    return result;
+}
+
+// The prevouts cached by the validation, otherwise those of the unconfirmed
+// parents or the UTXO set. Invalid if not found.
+template <typename Clock>
+std::vector<domain::chain::output> internal_database_basis<Clock>::get_unconfirmed_prevouts(domain::chain::transaction const& tx) const {
+    std::vector<domain::chain::output> prevouts;
+    prevouts.reserve(tx.inputs().size());
+
+    for (auto const& input : tx.inputs()) {
+        auto const& point = input.previous_output();
+        if (point.validation.cache.is_valid()) {
+            prevouts.push_back(point.validation.cache);
+            continue;
+        }
+
+        auto const parent = get_transaction_unconfirmed(point.hash());
+        if (parent.is_valid() && point.index() < parent.transaction().outputs().size()) {
+            prevouts.push_back(parent.transaction().outputs()[point.index()]);
+            continue;
+        }
+
+        prevouts.push_back(get_utxo(point).output());
+    }
+
+    return prevouts;
+}
+
+template <typename Clock>
+void internal_database_basis<Clock>::index_unconfirmed(unconfirmed_address_index& index) const {
+    if (db_mode_ != db_mode_type::full) {
+        return;
+    }
+
+    for (auto const& entry : get_all_transaction_unconfirmed()) {
+        auto const& tx = entry.transaction();
+        index.add(tx, entry.arrival_time(), get_unconfirmed_prevouts(tx));
+    }
+}
+
 #if ! defined(KTH_DB_READONLY)
 
 template <typename Clock>
@@ -128,9 +219,7 @@ uint32_t internal_database_basis<Clock>::get_clock_now() const {
 #if ! defined(KTH_DB_READONLY)
 
 template <typename Clock>
-result_code internal_database_basis<Clock>::insert_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height, KTH_DB_txn* db_txn) {
-
-    uint32_t arrival_time = get_clock_now();
+result_code internal_database_basis<Clock>::insert_transaction_unconfirmed(domain::chain::transaction const& tx, uint32_t height, uint32_t arrival_time, KTH_DB_txn* db_txn) {
 
     auto key_arr = tx.hash();                                    //TODO(fernando): podría estar afuera de la DBTx
     auto key = kth_db_make_value(key_arr.size(), key_arr.data());
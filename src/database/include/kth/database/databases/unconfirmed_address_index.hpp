@@ -0,0 +1,92 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DATABASE_UNCONFIRMED_ADDRESS_INDEX_HPP_
+#define KTH_DATABASE_UNCONFIRMED_ADDRESS_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <shared_mutex>
+#include <vector>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <kth/domain.hpp>
+#include <kth/database/define.hpp>
+
+namespace kth::database {
+
+/// Payments to and from addresses of the unconfirmed transactions.
+/// An output is indexed by the address of its script, an input by the
+/// address of the output it spends. The addresses are network independent,
+/// only the hash and the kind (key or script hash) are compared.
+/// This class is thread safe.
+class KD_API unconfirmed_address_index {
+public:
+    struct entry {
+        hash_digest hash;                               // transaction
+        uint32_t index;                                 // input or output
+        bool input;
+        int64_t delta;                                  // satoshis, negative if spent
+        domain::chain::output_point previous_output;    // spent output, inputs only
+        uint32_t arrival_time;
+    };
+
+    /// The number of transactions.
+    size_t size() const;
+
+    /// The prevouts are the outputs spent by the inputs, in order. An invalid
+    /// output (unknown) leaves its input out of the index.
+    void add(domain::chain::transaction const& tx, uint32_t arrival_time, std::vector<domain::chain::output> const& prevouts);
+
+    void remove(hash_digest const& hash);
+
+    void clear();
+
+    /// The hashes of the transactions, in no particular order.
+    hash_list transactions() const;
+
+    /// The entries of the address, in the order they were added.
+    std::vector<entry> find(domain::wallet::payment_address const& address) const;
+
+private:
+    struct address_key {
+        hash_digest hash;
+        uint8_t size;
+        bool script;
+
+        friend
+        bool operator==(address_key const& x, address_key const& y) {
+            return x.size == y.size && x.script == y.script && x.hash == y.hash;
+        }
+    };
+
+    // Address and transaction hashes are uniformly distributed.
+    struct hash_prefix {
+        size_t operator()(hash_digest const& hash) const {
+            uint64_t value;
+            std::memcpy(&value, hash.data(), sizeof(value));
+            return size_t(value);
+        }
+
+        size_t operator()(address_key const& key) const {
+            return (*this)(key.hash) ^ size_t(key.script);
+        }
+    };
+
+    static
+    address_key make_key(domain::wallet::payment_address const& address);
+
+    // precondition: mutex_ is held
+    void insert(domain::chain::script const& script, entry const& value, std::vector<address_key>& keys);
+
+    mutable std::shared_mutex mutex_;
+    boost::unordered_flat_map<address_key, std::vector<entry>, hash_prefix> entries_;
+    boost::unordered_flat_map<hash_digest, std::vector<address_key>, hash_prefix> keys_;     // by transaction
+};
+
+} // namespace kth::database
+
+#endif // KTH_DATABASE_UNCONFIRMED_ADDRESS_INDEX_HPP_
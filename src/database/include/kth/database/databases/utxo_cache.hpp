@@ -0,0 +1,110 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DATABASE_UTXO_CACHE_HPP_
+#define KTH_DATABASE_UTXO_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <kth/domain.hpp>
+#include <kth/database/define.hpp>
+
+namespace kth::database {
+
+/// UTXO changes made by a single block while its LMDB transaction is open.
+/// A value is a serialized utxo_entry (created), std::nullopt is a spend.
+using utxo_cache_batch = std::unordered_map<domain::chain::point, std::optional<data_chunk>>;
+
+/// Write-back cache in front of the LMDB utxo_db.
+/// Flat open-addressing table (linear probing, backward-shift deletion) keyed
+/// by outpoint. Outputs created and spent while cached never reach the disk.
+/// This class is not thread safe, the owner serializes access.
+class KD_API utxo_cache {
+public:
+    /// A cache probe: not cached, cached as spent, or cached as unspent.
+    struct lookup {
+        bool cached = false;
+        data_chunk const* value = nullptr;
+    };
+
+    /// A pending utxo_db write, a null value deletes the key.
+    struct write {
+        data_chunk key;
+        data_chunk const* value;
+    };
+
+    explicit
+    utxo_cache(size_t capacity_bytes);
+
+    /// A zero capacity disables the cache.
+    bool enabled() const;
+
+    /// The memory budget has been reached, the owner should flush.
+    bool full() const;
+
+    size_t size() const;
+    size_t dirty() const;
+    size_t bytes() const;
+
+    lookup find(domain::chain::point const& point) const;
+
+    /// Apply the changes of a committed block.
+    /// If dirty, the changes are pending to be written to utxo_db,
+    /// otherwise they have already been written.
+    void apply(utxo_cache_batch& batch, bool dirty);
+
+    /// Pending writes sorted by the serialized key (LMDB key order).
+    std::vector<write> dirty_entries(bool wire) const;
+
+    /// The pending writes have been committed to utxo_db.
+    void mark_flushed();
+
+    /// Drop every clean entry.
+    void evict();
+
+    void clear();
+
+private:
+    enum class entry_state : uint8_t {
+        empty,
+        clean,          // equal to utxo_db
+        created,        // not in utxo_db
+        modified,       // in utxo_db with a different value
+        spent           // in utxo_db, pending to be deleted
+    };
+
+    struct slot {
+        hash_digest hash;
+        uint32_t index;
+        entry_state state = entry_state::empty;
+        data_chunk value;
+    };
+
+    static
+    bool is_dirty(entry_state state);
+
+    size_t bucket(hash_digest const& hash, uint32_t index) const;
+    size_t find_slot(hash_digest const& hash, uint32_t index) const;
+
+    void add(domain::chain::point const& point, data_chunk&& value, bool dirty);
+    void spend(domain::chain::point const& point, bool dirty);
+    void erase(size_t position);
+    void reserve_one();
+    void rebuild(size_t slot_count, bool keep_clean);
+
+    size_t const capacity_;
+    uint64_t const salt_;
+    std::vector<slot> slots_;
+    size_t size_ = 0;
+    size_t dirty_ = 0;
+    size_t value_bytes_ = 0;
+};
+
+} // namespace kth::database
+
+#endif // KTH_DATABASE_UTXO_CACHE_HPP_
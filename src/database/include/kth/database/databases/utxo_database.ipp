@@ -13,6 +13,18 @@ namespace kth::database {
 
 template <typename Clock>
 result_code internal_database_basis<Clock>::remove_utxo(uint32_t height, domain::chain::output_point const& point, bool insert_reorg, KTH_DB_txn* db_txn) {
+    if (utxo_write_back_) {
+        // precondition: ! insert_reorg
+        auto const pending = utxo_batch_.find(point);
+        if (pending != utxo_batch_.end() && pending->second) {
+            // Created and spent in the same block.
+            utxo_batch_.erase(pending);
+        } else {
+            utxo_batch_[point] = std::nullopt;
+        }
+        return result_code::success;
+    }
+
     auto keyarr = point.to_data(KTH_INTERNAL_DB_WIRE);      //TODO(fernando): podría estar afuera de la DBTx
     auto key = kth_db_make_value(keyarr.size(), keyarr.data());                 //TODO(fernando): podría estar afuera de la DBTx
 
@@ -30,6 +42,10 @@ result_code internal_database_basis<Clock>::remove_utxo(uint32_t height, domain:
         LOG_INFO(LOG_DATABASE, "Error deleting UTXO [remove_utxo] ", res);
         return result_code::other;
     }
+
+    if (utxo_cache_.enabled()) {
+        utxo_batch_[point] = std::nullopt;
+    }
     return result_code::success;
 }
 
@@ -38,6 +54,19 @@ result_code internal_database_basis<Clock>::insert_utxo(domain::chain::output_po
     auto keyarr = point.to_data(KTH_INTERNAL_DB_WIRE);                  //TODO(fernando): podría estar afuera de la DBTx
     auto valuearr = utxo_entry::to_data_with_fixed(output, fixed_data);     //TODO(fernando): podría estar afuera de la DBTx
 
+    if (utxo_write_back_) {
+        // Only coinbase outputs could be duplicated (BIP30), so only them
+        // are looked up in utxo_db.
+        auto const coinbase = utxo_entry::coinbase_fixed(fixed_data);
+        auto const duplicated = coinbase && get_utxo_unflushed(point, db_txn).is_valid();
+        if (duplicated) {
+            LOG_DEBUG(LOG_DATABASE, "Duplicate Key inserting UTXO [insert_utxo]");
+            return result_code::duplicated_key;
+        }
+        utxo_batch_[point] = std::move(valuearr);
+        return result_code::success;
+    }
+
     auto key = kth_db_make_value(keyarr.size(), keyarr.data());                           //TODO(fernando): podría estar afuera de la DBTx
     auto value = kth_db_make_value(valuearr.size(), valuearr.data());                       //TODO(fernando): podría estar afuera de la DBTx
     auto res = kth_db_put(db_txn, dbi_utxo_, &key, &value, KTH_DB_NOOVERWRITE);
@@ -50,9 +79,191 @@ result_code internal_database_basis<Clock>::insert_utxo(domain::chain::output_po
         LOG_INFO(LOG_DATABASE, "Error inserting UTXO [insert_utxo] ", res);
         return result_code::other;
     }
+
+    if (utxo_cache_.enabled()) {
+        utxo_batch_[point] = std::move(valuearr);
+    }
+    return result_code::success;
+}
+
+// UTXO cache
+//-----------------------------------------------------------------------------
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::flush_utxo_cache(KTH_DB_txn* db_txn) {
+    // Sorted writes touch each utxo_db page once per flush.
+    for (auto const& entry : utxo_cache_.dirty_entries(KTH_INTERNAL_DB_WIRE)) {
+        auto key = kth_db_make_value(entry.key.size(), const_cast<uint8_t*>(entry.key.data()));
+
+        if (entry.value == nullptr) {
+            auto res = kth_db_del(db_txn, dbi_utxo_, &key, NULL);
+            if (res == KTH_DB_NOTFOUND) {
+                // The spend was accepted by validation, failing here would block every later flush.
+                LOG_INFO(LOG_DATABASE, "Key not found deleting UTXO [flush_utxo_cache] ", res);
+                continue;
+            }
+            if (res != KTH_DB_SUCCESS) {
+                LOG_INFO(LOG_DATABASE, "Error deleting UTXO [flush_utxo_cache] ", res);
+                return result_code::other;
+            }
+            continue;
+        }
+
+        auto value = kth_db_make_value(entry.value->size(), const_cast<uint8_t*>(entry.value->data()));
+        auto res = kth_db_put(db_txn, dbi_utxo_, &key, &value, 0);
+        if (res != KTH_DB_SUCCESS) {
+            LOG_INFO(LOG_DATABASE, "Error inserting UTXO [flush_utxo_cache] ", res);
+            return result_code::other;
+        }
+    }
+
+    property_code property = property_code::utxo_unflushed_height;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    auto res = kth_db_del(db_txn, dbi_properties_, &key, NULL);
+    if (res != KTH_DB_SUCCESS && res != KTH_DB_NOTFOUND) {
+        LOG_INFO(LOG_DATABASE, "Error deleting the UTXO cache height [flush_utxo_cache] ", res);
+        return result_code::other;
+    }
+
+    return result_code::success;
+}
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::drop_utxo_cache() {
+    if ( ! utxo_cache_.enabled()) {
+        return result_code::success;
+    }
+
+    std::unique_lock lock(utxo_cache_mutex_);
+
+    if (utxo_cache_.dirty() != 0 || utxo_unflushed_) {
+        KTH_DB_txn* db_txn;
+        auto res0 = kth_db_txn_begin(env_, NULL, 0, &db_txn);
+        if (res0 != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error begining LMDB Transaction [drop_utxo_cache] ", res0);
+            return result_code::other;
+        }
+
+        auto res = flush_utxo_cache(db_txn);
+        if (res != result_code::success) {
+            kth_db_txn_abort(db_txn);
+            return res;
+        }
+
+        res0 = kth_db_txn_commit(db_txn);
+        if (res0 != KTH_DB_SUCCESS) {
+            LOG_ERROR(LOG_DATABASE, "Error commiting LMDB Transaction [drop_utxo_cache] ", res0);
+            return result_code::other;
+        }
+        utxo_unflushed_ = false;
+    }
+
+    utxo_cache_.clear();
     return result_code::success;
 }
 
+// The UTXO changes of the blocks pushed after the last flush were lost, those
+// blocks are removed so they are downloaded and connected again.
+// They are out of the reorg window, so there is no reorg data to undo.
+template <typename Clock>
+result_code internal_database_basis<Clock>::recover_utxo_cache() {
+    KTH_DB_txn* db_txn;
+    auto res0 = kth_db_txn_begin(env_, NULL, 0, &db_txn);
+    if (res0 != KTH_DB_SUCCESS) {
+        return result_code::other;
+    }
+
+    property_code property = property_code::utxo_unflushed_height;
+    auto key = kth_db_make_value(sizeof(property), &property);
+    KTH_DB_val value;
+
+    res0 = kth_db_get(db_txn, dbi_properties_, &key, &value);
+    if (res0 == KTH_DB_NOTFOUND) {
+        kth_db_txn_abort(db_txn);
+        return result_code::success;
+    }
+    if (res0 != KTH_DB_SUCCESS) {
+        kth_db_txn_abort(db_txn);
+        return result_code::other;
+    }
+
+    auto const from = *static_cast<uint32_t*>(kth_db_get_data(value));
+
+    KTH_DB_cursor* cursor;
+    if (kth_db_cursor_open(db_txn, dbi_block_header_, &cursor) != KTH_DB_SUCCESS) {
+        kth_db_txn_abort(db_txn);
+        return result_code::other;
+    }
+
+    KTH_DB_val last_key;
+    if (kth_db_cursor_get(cursor, &last_key, nullptr, KTH_DB_LAST) != KTH_DB_SUCCESS) {
+        kth_db_cursor_close(cursor);
+        kth_db_txn_abort(db_txn);
+        return result_code::db_corrupt;
+    }
+    auto const last_height = *static_cast<uint32_t*>(kth_db_get_data(last_key));
+    kth_db_cursor_close(cursor);
+
+    LOG_INFO(LOG_DATABASE, "The UTXO cache was not flushed, removing blocks from ", from, " to ", last_height, ".");
+
+    for (auto height = last_height + 1; height-- > from; ) {
+        auto res = truncate_block(height, db_txn);
+        if (res != result_code::success) {
+            kth_db_txn_abort(db_txn);
+            return res;
+        }
+    }
+
+    res0 = kth_db_del(db_txn, dbi_properties_, &key, NULL);
+    if (res0 != KTH_DB_SUCCESS) {
+        kth_db_txn_abort(db_txn);
+        return result_code::other;
+    }
+
+    // The truncated blocks could be under the last durable height.
+    property_code durable = property_code::durable_height;
+    auto durable_key = kth_db_make_value(sizeof(durable), &durable);
+    res0 = kth_db_del(db_txn, dbi_properties_, &durable_key, NULL);
+    if (res0 != KTH_DB_SUCCESS && res0 != KTH_DB_NOTFOUND) {
+        kth_db_txn_abort(db_txn);
+        return result_code::other;
+    }
+
+    if (kth_db_txn_commit(db_txn) != KTH_DB_SUCCESS) {
+        return result_code::other;
+    }
+    return result_code::success;
+}
+
+template <typename Clock>
+result_code internal_database_basis<Clock>::truncate_block(uint32_t height, KTH_DB_txn* db_txn) {
+    auto const header = get_header(height, db_txn);
+    if ( ! header.is_valid()) {
+        return result_code::key_not_found;
+    }
+
+    if (db_mode_ == db_mode_type::full) {
+        auto const block = get_block(height, db_txn);
+        if ( ! block.is_valid()) {
+            return result_code::key_not_found;
+        }
+
+        auto res = remove_transactions(block, height, db_txn);
+        if (res != result_code::success) {
+            return res;
+        }
+    }
+
+    if (db_mode_ == db_mode_type::full || db_mode_ == db_mode_type::blocks) {
+        auto res = remove_blocks_db(height, db_txn);
+        if (res != result_code::success) {
+            return res;
+        }
+    }
+
+    return remove_block_header(header.hash(), height, db_txn);
+}
+
 #endif // ! defined(KTH_DB_READONLY)
 
 } // namespace kth::database
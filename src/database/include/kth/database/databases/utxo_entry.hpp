@@ -5,6 +5,9 @@
 #ifndef KTH_DATABASE_UTXO_ENTRY_HPP_
 #define KTH_DATABASE_UTXO_ENTRY_HPP_
 
+#include <cstddef>
+#include <cstdint>
+
 #include <kth/domain.hpp>
 #include <kth/database/define.hpp>
 
@@ -32,27 +35,35 @@ public:
 
     template <typename W, KTH_IS_WRITER(W)>
     void to_data(W& sink) const {
-        output_.to_data(sink, false);
         to_data_fixed(sink, height_, median_time_past_, coinbase_);
+        to_data_output(sink, output_);
     }
 
     static
     expect<utxo_entry> from_data(byte_reader& reader);
 
+    /// Format used before compression, kept to migrate old databases.
+    static
+    expect<utxo_entry> from_data_legacy(byte_reader& reader);
+
     static
     data_chunk to_data_fixed(uint32_t height, uint32_t median_time_past, bool coinbase);
 
     static
     void to_data_fixed(std::ostream& stream, uint32_t height, uint32_t median_time_past, bool coinbase);
 
+    // Height and coinbase flag packed in one varint, then the MTP.
     template <typename W, KTH_IS_WRITER(W)>
     static
     void to_data_fixed(W& sink, uint32_t height, uint32_t median_time_past, bool coinbase) {
-        sink.write_4_bytes_little_endian(height);
+        write_varint(sink, (uint64_t(height) << 1) | uint64_t(coinbase));
         sink.write_4_bytes_little_endian(median_time_past);
-        sink.write_byte(coinbase);
     }
 
+    /// The coinbase flag of a to_data_fixed() result.
+    static
+    bool coinbase_fixed(data_chunk const& fixed);
+
     static
     data_chunk to_data_with_fixed(domain::chain::output const& output, data_chunk const& fixed);
 
@@ -62,15 +73,78 @@ public:
     template <typename W, KTH_IS_WRITER(W)>
     static
     void to_data_with_fixed(W& sink, domain::chain::output const& output, data_chunk const& fixed) {
-        output.to_data(sink, false);
         sink.write_bytes(fixed);
+        to_data_output(sink, output);
     }
 
+    // Amount compression, see Bitcoin Core compressor.cpp.
+    static
+    uint64_t compress_amount(uint64_t value);
+
+    static
+    uint64_t decompress_amount(uint64_t value);
+
 private:
-    void reset();
+    // Script templates, the rest are stored raw with code = size + script_raw.
+    enum script_code : uint64_t {
+        script_p2pkh = 0,           // 20 bytes, the key hash
+        script_p2sh = 1,            // 20 bytes, the script hash
+        script_p2pk_even = 2,       // 32 bytes, x of a compressed key
+        script_p2pk_odd = 3,        // 32 bytes, x of a compressed key
+        script_p2sh32 = 4,          // 32 bytes, the script hash
+        script_raw = 6              // 5 is reserved
+    };
+
+    struct script_template {
+        uint64_t code;
+        size_t offset;
+        size_t size;
+    };
+
+    static
+    script_template compress_script(data_chunk const& script);
 
-    constexpr static
-    size_t serialized_size_fixed();
+    static
+    expect<domain::chain::script> decompress_script(byte_reader& reader, uint64_t code);
+
+    // Variable length integer, MSB base-128 as Bitcoin Core VARINT.
+    template <typename W>
+    static
+    void write_varint(W& sink, uint64_t value) {
+        uint8_t tmp[10];
+        size_t len = 0;
+        while (true) {
+            tmp[len] = (value & 0x7f) | (len != 0 ? 0x80 : 0x00);
+            if (value <= 0x7f) break;
+            value = (value >> 7) - 1;
+            ++len;
+        }
+        do {
+            sink.write_byte(tmp[len]);
+        } while (len-- != 0);
+    }
+
+    static
+    expect<uint64_t> read_varint(byte_reader& reader);
+
+    // Value, then the script template code with the token flag in its low
+    // bit, the token data only when present, and the script payload.
+    template <typename W>
+    static
+    void to_data_output(W& sink, domain::chain::output const& output) {
+        auto const& token_data = output.token_data();
+        auto const script = output.script().to_data(false);
+        auto const tmpl = compress_script(script);
+
+        write_varint(sink, compress_amount(output.value()));
+        write_varint(sink, (tmpl.code << 1) | uint64_t(token_data.has_value()));
+        if (token_data.has_value()) {
+            domain::chain::token::encoding::to_data(sink, token_data.value());
+        }
+        sink.write_bytes(script.data() + tmpl.offset, tmpl.size);
+    }
+
+    void reset();
 
     domain::chain::output output_;
     uint32_t height_ = max_uint32;
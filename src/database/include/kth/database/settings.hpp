@@ -25,7 +25,9 @@ public:
     uint32_t reorg_pool_limit;
     uint64_t db_max_size;
     bool safe_mode;
-    uint32_t cache_capacity;
+    uint32_t cache_capacity;        // UTXO cache size in MB, zero disables it
+    uint32_t group_commit_blocks;   // blocks per write transaction under the last checkpoint, zero disables grouping
+    uint32_t group_commit_size;     // MB of blocks per write transaction under the last checkpoint
 };
 
 } // namespace kth::database
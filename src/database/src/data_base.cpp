@@ -105,7 +105,10 @@ void data_base::start() {
         internal_db_dir,
         settings_.db_mode,
         settings_.reorg_pool_limit,
-        settings_.db_max_size, settings_.safe_mode);
+        settings_.db_max_size, settings_.safe_mode,
+        settings_.cache_capacity,
+        settings_.group_commit_blocks,
+        settings_.group_commit_size);
 }
 
 // Readers.
@@ -208,6 +211,10 @@ code data_base::push(domain::chain::transaction const& tx, uint32_t forks) {
 #endif // ! defined(KTH_DB_READONLY)
 
 #if ! defined(KTH_DB_READONLY)
+void data_base::set_group_commit_height(size_t height) {
+    group_commit_height_ = height;
+}
+
 // Add a block in order (creates no gaps, must be at top).
 // This is designed for write exclusivity and read concurrency.
 code data_base::push(block const& block, size_t height) {
@@ -320,7 +327,9 @@ void data_base::push_next(code const& ec, block_const_ptr_list_const_ptr blocks,
 
 void data_base::do_push(block_const_ptr block, size_t height, uint32_t median_time_past, dispatcher& dispatch, result_handler handler) {
     // LOG_DEBUG(LOG_DATABASE, "Write flushed to disk: ", ec.message());
-    auto res = internal_db_->push_block(*block, height, median_time_past);
+    auto res = height < group_commit_height_
+        ? internal_db_->push_block_deferred(block, height, median_time_past)
+        : internal_db_->push_block(*block, height, median_time_past);
     if ( ! succeed(res)) {
         handler(error::operation_failed_7); //TODO(fernando): create a new operation_failed
         return;
@@ -0,0 +1,223 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/database/databases/header_index.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <tuple>
+
+namespace kth::database {
+
+size_t header_index::size() const {
+    std::shared_lock lock(mutex_);
+    return heights_.size();
+}
+
+std::optional<uint32_t> header_index::top() const {
+    std::shared_lock lock(mutex_);
+    if (hashes_.empty()) {
+        return {};
+    }
+    return uint32_t(hashes_.size() - 1);
+}
+
+void header_index::reserve(size_t count) {
+    std::unique_lock lock(mutex_);
+    present_.reserve(count);
+    hashes_.reserve(count);
+    merkles_.reserve(count);
+    versions_.reserve(count);
+    timestamps_.reserve(count);
+    bits_.reserve(count);
+    nonces_.reserve(count);
+    work_.reserve(count);
+    abla_.reserve(count);
+    heights_.reserve(count);
+}
+
+void header_index::push(domain::chain::block const& block, uint32_t height) {
+    abla_state abla{0, 0, 0};
+    if (block.validation.state) {
+        auto const& state = block.validation.state->abla_state();
+        abla = {state.block_size, state.control_block_size, state.elastic_buffer_size};
+    }
+
+    auto const hash = block.hash();
+
+    std::unique_lock lock(mutex_);
+    set(block.header(), hash, abla, height);
+}
+
+void header_index::push(header_with_abla_state_t const& header, hash_digest const& hash, uint32_t height) {
+    abla_state const abla{std::get<1>(header), std::get<2>(header), std::get<3>(header)};
+
+    std::unique_lock lock(mutex_);
+    set(std::get<0>(header), hash, abla, height);
+}
+
+void header_index::truncate(uint32_t height) {
+    std::unique_lock lock(mutex_);
+    auto count = std::min(size_t(height), hashes_.size());
+
+    for (auto position = count; position < hashes_.size(); ++position) {
+        if (present_[position]) {
+            heights_.erase(hashes_[position]);
+        }
+        previous_.erase(uint32_t(position));
+    }
+
+    // The top is always a header.
+    while (count != 0 && ! present_[count - 1]) {
+        previous_.erase(uint32_t(--count));
+    }
+
+    present_.resize(count);
+    hashes_.resize(count);
+    merkles_.resize(count);
+    versions_.resize(count);
+    timestamps_.resize(count);
+    bits_.resize(count);
+    nonces_.resize(count);
+    work_.resize(count);
+    abla_.resize(count);
+}
+
+void header_index::clear() {
+    std::unique_lock lock(mutex_);
+    present_.clear();
+    hashes_.clear();
+    merkles_.clear();
+    versions_.clear();
+    timestamps_.clear();
+    bits_.clear();
+    nonces_.clear();
+    work_.clear();
+    abla_.clear();
+    heights_.clear();
+    previous_.clear();
+}
+
+std::optional<uint32_t> header_index::height(hash_digest const& hash) const {
+    std::shared_lock lock(mutex_);
+    auto const it = heights_.find(hash);
+    if (it == heights_.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+std::optional<hash_digest> header_index::hash(uint32_t height) const {
+    std::shared_lock lock(mutex_);
+    if (height >= hashes_.size() || ! present_[height]) {
+        return {};
+    }
+    return hashes_[height];
+}
+
+std::optional<header_with_abla_state_t> header_index::header(uint32_t height) const {
+    std::shared_lock lock(mutex_);
+    if (height >= hashes_.size() || ! present_[height]) {
+        return {};
+    }
+
+    auto const& abla = abla_[height];
+    return std::make_tuple(make_header(height), abla.block_size, abla.control_block_size, abla.elastic_buffer_size);
+}
+
+domain::chain::header::list header_index::headers(uint32_t from, uint32_t to) const {
+    domain::chain::header::list list;
+
+    std::shared_lock lock(mutex_);
+    if (from > to || from >= hashes_.size()) {
+        return list;
+    }
+
+    auto const last = std::min(size_t(to), hashes_.size() - 1);
+    list.reserve(last - from + 1);
+    for (auto height = size_t(from); height <= last && present_[height]; ++height) {
+        list.push_back(make_header(height));
+    }
+    return list;
+}
+
+std::optional<uint256_t> header_index::work(uint32_t from, uint32_t to) const {
+    std::shared_lock lock(mutex_);
+    if (from >= hashes_.size()) {
+        return {};
+    }
+
+    if (from > to) {
+        return uint256_t{0};
+    }
+
+    auto const last = std::min(size_t(to), hashes_.size() - 1);
+    return from == 0 ? work_[last] : uint256_t(work_[last] - work_[from - 1]);
+}
+
+// private
+void header_index::set(domain::chain::header const& header, hash_digest const& hash, abla_state const& abla, uint32_t height) {
+    auto const position = size_t(height);
+    if (position < hashes_.size() && present_[position]) {
+        return;
+    }
+
+    if (position >= hashes_.size()) {
+        auto const count = position + 1;
+        present_.resize(count, false);
+        hashes_.resize(count, null_hash);
+        merkles_.resize(count, null_hash);
+        versions_.resize(count, 0);
+        timestamps_.resize(count, 0);
+        bits_.resize(count, 0);
+        nonces_.resize(count, 0);
+        work_.resize(count, uint256_t{0});
+        abla_.resize(count, abla_state{0, 0, 0});
+    }
+
+    present_[position] = true;
+    hashes_[position] = hash;
+    merkles_[position] = header.merkle();
+    versions_[position] = header.version();
+    timestamps_[position] = header.timestamp();
+    bits_[position] = header.bits();
+    nonces_[position] = header.nonce();
+    abla_[position] = abla;
+    heights_.insert_or_assign(hash, height);
+
+    if (position != 0 && ! present_[position - 1]) {
+        previous_.insert_or_assign(height, header.previous_block_hash());
+    }
+
+    // The next header is no longer after a gap.
+    previous_.erase(height + 1);
+
+    accumulate_work(position);
+}
+
+// private
+// Gaps add no work, filling one updates the headers above it.
+void header_index::accumulate_work(size_t from) {
+    for (auto position = from; position < hashes_.size(); ++position) {
+        auto const proof = present_[position] ? domain::chain::header::proof(bits_[position]) : uint256_t{0};
+        work_[position] = position == 0 ? proof : uint256_t(work_[position - 1] + proof);
+    }
+}
+
+// private
+domain::chain::header header_index::make_header(size_t height) const {
+    auto const& previous = height == 0 ? null_hash :
+        present_[height - 1] ? hashes_[height - 1] : previous_.at(uint32_t(height));
+
+    return domain::chain::header{
+        versions_[height],
+        previous,
+        merkles_[height],
+        timestamps_[height],
+        bits_[height],
+        nonces_[height]
+    };
+}
+
+} // namespace kth::database
@@ -0,0 +1,131 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/database/databases/unconfirmed_address_index.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace kth::database {
+
+using domain::wallet::payment_address;
+
+size_t unconfirmed_address_index::size() const {
+    std::shared_lock lock(mutex_);
+    return keys_.size();
+}
+
+void unconfirmed_address_index::add(domain::chain::transaction const& tx, uint32_t arrival_time, std::vector<domain::chain::output> const& prevouts) {
+    auto const hash = tx.hash();
+
+    std::unique_lock lock(mutex_);
+    if (keys_.contains(hash)) {
+        return;
+    }
+
+    std::vector<address_key> keys;
+
+    uint32_t index = 0;
+    for (auto const& output : tx.outputs()) {
+        insert(output.script(), {hash, index++, false, int64_t(output.value()), {}, arrival_time}, keys);
+    }
+
+    index = 0;
+    for (auto const& input : tx.inputs()) {
+        auto const position = index++;
+        if (position >= prevouts.size() || ! prevouts[position].is_valid()) {
+            continue;
+        }
+
+        auto const& prevout = prevouts[position];
+        insert(prevout.script(), {hash, position, true, -int64_t(prevout.value()), input.previous_output(), arrival_time}, keys);
+    }
+
+    keys_.emplace(hash, std::move(keys));
+}
+
+void unconfirmed_address_index::remove(hash_digest const& hash) {
+    std::unique_lock lock(mutex_);
+    auto const found = keys_.find(hash);
+    if (found == keys_.end()) {
+        return;
+    }
+
+    for (auto const& key : found->second) {
+        auto const it = entries_.find(key);
+        if (it == entries_.end()) {
+            continue;
+        }
+
+        std::erase_if(it->second, [&hash](entry const& value) {
+            return value.hash == hash;
+        });
+
+        if (it->second.empty()) {
+            entries_.erase(it);
+        }
+    }
+
+    keys_.erase(found);
+}
+
+void unconfirmed_address_index::clear() {
+    std::unique_lock lock(mutex_);
+    entries_.clear();
+    keys_.clear();
+}
+
+hash_list unconfirmed_address_index::transactions() const {
+    std::shared_lock lock(mutex_);
+    hash_list result;
+    result.reserve(keys_.size());
+    for (auto const& value : keys_) {
+        result.push_back(value.first);
+    }
+    return result;
+}
+
+std::vector<unconfirmed_address_index::entry> unconfirmed_address_index::find(payment_address const& address) const {
+    if ( ! address) {
+        return {};
+    }
+
+    auto const key = make_key(address);
+
+    std::shared_lock lock(mutex_);
+    auto const it = entries_.find(key);
+    if (it == entries_.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+// private
+unconfirmed_address_index::address_key unconfirmed_address_index::make_key(payment_address const& address) {
+    auto const version = address.version();
+    auto const span = address.hash_span();
+
+    address_key result{null_hash, uint8_t(span.size()), version == payment_address::mainnet_p2sh || version == payment_address::testnet_p2sh};
+    std::copy_n(span.begin(), std::min(span.size(), result.hash.size()), result.hash.begin());
+    return result;
+}
+
+// private
+void unconfirmed_address_index::insert(domain::chain::script const& script, entry const& value, std::vector<address_key>& keys) {
+    auto const addresses = payment_address::extract_output(script, payment_address::mainnet_p2kh, payment_address::mainnet_p2sh);
+    for (auto const& address : addresses) {
+        if ( ! address) {
+            continue;
+        }
+
+        auto const key = make_key(address);
+        entries_[key].push_back(value);
+
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            keys.push_back(key);
+        }
+    }
+}
+
+} // namespace kth::database
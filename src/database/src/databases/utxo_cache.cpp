@@ -0,0 +1,313 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/database/databases/utxo_cache.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <kth/infrastructure/utility/pseudo_random.hpp>
+
+namespace kth::database {
+
+namespace {
+
+constexpr size_t min_slots = 1024;
+
+uint64_t random_salt() {
+    uint64_t salt;
+    pseudo_random::fill(reinterpret_cast<uint8_t*>(&salt), sizeof(salt));
+    return salt;
+}
+
+size_t slots_for(size_t entries) {
+    // Keep the load factor under 3/4.
+    size_t count = min_slots;
+    while (count * 3 < entries * 4) {
+        count *= 2;
+    }
+    return count;
+}
+
+} // namespace
+
+utxo_cache::utxo_cache(size_t capacity_bytes)
+    : capacity_(capacity_bytes)
+    , salt_(capacity_bytes == 0 ? 0 : random_salt())
+{}
+
+bool utxo_cache::enabled() const {
+    return capacity_ != 0;
+}
+
+bool utxo_cache::full() const {
+    return bytes() >= capacity_;
+}
+
+size_t utxo_cache::size() const {
+    return size_;
+}
+
+size_t utxo_cache::dirty() const {
+    return dirty_;
+}
+
+size_t utxo_cache::bytes() const {
+    return slots_.capacity() * sizeof(slot) + value_bytes_;
+}
+
+utxo_cache::lookup utxo_cache::find(domain::chain::point const& point) const {
+    auto const position = find_slot(point.hash(), point.index());
+    if (position == slots_.size()) {
+        return {};
+    }
+
+    auto const& entry = slots_[position];
+    if (entry.state == entry_state::spent) {
+        return {true, nullptr};
+    }
+    return {true, &entry.value};
+}
+
+void utxo_cache::apply(utxo_cache_batch& batch, bool dirty) {
+    for (auto& [point, value] : batch) {
+        if (value) {
+            add(point, std::move(*value), dirty);
+        } else {
+            spend(point, dirty);
+        }
+    }
+}
+
+std::vector<utxo_cache::write> utxo_cache::dirty_entries(bool wire) const {
+    std::vector<write> writes;
+    writes.reserve(dirty_);
+
+    for (auto const& entry : slots_) {
+        if ( ! is_dirty(entry.state)) {
+            continue;
+        }
+
+        auto const* value = entry.state == entry_state::spent ? nullptr : &entry.value;
+        writes.push_back({domain::chain::point{entry.hash, entry.index}.to_data(wire), value});
+    }
+
+    std::sort(writes.begin(), writes.end(), [](write const& x, write const& y) {
+        return x.key < y.key;
+    });
+    return writes;
+}
+
+void utxo_cache::mark_flushed() {
+    for (auto& entry : slots_) {
+        if (entry.state == entry_state::created || entry.state == entry_state::modified) {
+            entry.state = entry_state::clean;
+        } else if (entry.state == entry_state::spent) {
+            // Dropped by the rebuild below.
+            entry.state = entry_state::empty;
+        }
+    }
+    rebuild(slots_.size(), true);
+}
+
+void utxo_cache::evict() {
+    rebuild(slots_for(dirty_), false);
+}
+
+void utxo_cache::clear() {
+    std::vector<slot>().swap(slots_);
+    size_ = 0;
+    dirty_ = 0;
+    value_bytes_ = 0;
+}
+
+// private
+//-----------------------------------------------------------------------------
+
+// static
+bool utxo_cache::is_dirty(entry_state state) {
+    return state == entry_state::created
+        || state == entry_state::modified
+        || state == entry_state::spent;
+}
+
+size_t utxo_cache::bucket(hash_digest const& hash, uint32_t index) const {
+    // Transaction hashes are uniformly distributed, the salt prevents
+    // crafted collisions on the probing sequence.
+    uint64_t key;
+    std::memcpy(&key, hash.data(), sizeof(key));
+    key ^= salt_ + index * 0x9e3779b97f4a7c15ULL;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return size_t(key) & (slots_.size() - 1);
+}
+
+size_t utxo_cache::find_slot(hash_digest const& hash, uint32_t index) const {
+    if (slots_.empty()) {
+        return 0;
+    }
+
+    auto const mask = slots_.size() - 1;
+    auto position = bucket(hash, index);
+    while (slots_[position].state != entry_state::empty) {
+        auto const& entry = slots_[position];
+        if (entry.index == index && entry.hash == hash) {
+            return position;
+        }
+        position = (position + 1) & mask;
+    }
+    return slots_.size();
+}
+
+void utxo_cache::add(domain::chain::point const& point, data_chunk&& value, bool dirty) {
+    reserve_one();
+
+    auto const mask = slots_.size() - 1;
+    auto position = bucket(point.hash(), point.index());
+    while (slots_[position].state != entry_state::empty) {
+        auto const& entry = slots_[position];
+        if (entry.index == point.index() && entry.hash == point.hash()) {
+            break;
+        }
+        position = (position + 1) & mask;
+    }
+
+    auto& entry = slots_[position];
+    if (entry.state == entry_state::empty) {
+        entry.hash = point.hash();
+        entry.index = point.index();
+        entry.state = dirty ? entry_state::created : entry_state::clean;
+        ++size_;
+    } else {
+        if (is_dirty(entry.state)) {
+            --dirty_;
+        }
+        value_bytes_ -= entry.value.size();
+
+        if ( ! dirty) {
+            entry.state = entry_state::clean;
+        } else if (entry.state != entry_state::created) {
+            // The previous value is still in utxo_db.
+            entry.state = entry_state::modified;
+        }
+    }
+
+    if (is_dirty(entry.state)) {
+        ++dirty_;
+    }
+    value_bytes_ += value.size();
+    entry.value = std::move(value);
+}
+
+void utxo_cache::spend(domain::chain::point const& point, bool dirty) {
+    auto const position = find_slot(point.hash(), point.index());
+    auto const found = position != slots_.size();
+
+    if ( ! dirty) {
+        if (found) {
+            erase(position);
+        }
+        return;
+    }
+
+    if (found) {
+        auto& entry = slots_[position];
+        if (entry.state == entry_state::created) {
+            // Created and spent while cached, utxo_db never sees it.
+            erase(position);
+            return;
+        }
+
+        if (entry.state == entry_state::clean) {
+            ++dirty_;
+        }
+        value_bytes_ -= entry.value.size();
+        data_chunk().swap(entry.value);
+        entry.state = entry_state::spent;
+        return;
+    }
+
+    // Not cached, so it is in utxo_db: keep a tombstone until the flush.
+    reserve_one();
+    auto const mask = slots_.size() - 1;
+    auto free = bucket(point.hash(), point.index());
+    while (slots_[free].state != entry_state::empty) {
+        free = (free + 1) & mask;
+    }
+
+    auto& entry = slots_[free];
+    entry.hash = point.hash();
+    entry.index = point.index();
+    entry.state = entry_state::spent;
+    ++size_;
+    ++dirty_;
+}
+
+void utxo_cache::erase(size_t position) {
+    auto& removed = slots_[position];
+    if (is_dirty(removed.state)) {
+        --dirty_;
+    }
+    value_bytes_ -= removed.value.size();
+    --size_;
+
+    // Backward-shift deletion, no tombstones are left in the probing sequences.
+    auto const mask = slots_.size() - 1;
+    auto hole = position;
+    auto next = (position + 1) & mask;
+    while (slots_[next].state != entry_state::empty) {
+        auto const home = bucket(slots_[next].hash, slots_[next].index);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots_[hole] = std::move(slots_[next]);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots_[hole] = slot{};
+}
+
+void utxo_cache::reserve_one() {
+    if (slots_.empty()) {
+        rebuild(min_slots, true);
+        return;
+    }
+
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        rebuild(slots_.size() * 2, true);
+    }
+}
+
+void utxo_cache::rebuild(size_t slot_count, bool keep_clean) {
+    auto previous = std::move(slots_);
+    slots_ = std::vector<slot>(slot_count);
+    size_ = 0;
+    dirty_ = 0;
+    value_bytes_ = 0;
+
+    auto const mask = slot_count - 1;
+    for (auto& entry : previous) {
+        if (entry.state == entry_state::empty) {
+            continue;
+        }
+
+        if ( ! keep_clean && ! is_dirty(entry.state)) {
+            continue;
+        }
+
+        auto position = bucket(entry.hash, entry.index);
+        while (slots_[position].state != entry_state::empty) {
+            position = (position + 1) & mask;
+        }
+
+        if (is_dirty(entry.state)) {
+            ++dirty_;
+        }
+        value_bytes_ += entry.value.size();
+        ++size_;
+        slots_[position] = std::move(entry);
+    }
+}
+
+} // namespace kth::database
@@ -49,14 +49,176 @@ bool utxo_entry::is_valid() const {
 // Size.
 //-----------------------------------------------------------------------------
 
+size_t utxo_entry::serialized_size() const {
+    return to_data().size();
+}
+
+// Compression.
+//-----------------------------------------------------------------------------
+
+// static
+uint64_t utxo_entry::compress_amount(uint64_t value) {
+    if (value == 0) {
+        return 0;
+    }
+
+    uint64_t exponent = 0;
+    while ((value % 10) == 0 && exponent < 9) {
+        value /= 10;
+        ++exponent;
+    }
+
+    if (exponent < 9) {
+        auto const digit = value % 10;
+        value /= 10;
+        return 1 + (value * 9 + digit - 1) * 10 + exponent;
+    }
+
+    return 1 + (value - 1) * 10 + 9;
+}
+
+// static
+uint64_t utxo_entry::decompress_amount(uint64_t value) {
+    if (value == 0) {
+        return 0;
+    }
+
+    --value;
+    auto exponent = value % 10;
+    value /= 10;
+
+    uint64_t result;
+    if (exponent < 9) {
+        auto const digit = (value % 9) + 1;
+        value /= 9;
+        result = value * 10 + digit;
+    } else {
+        result = value + 1;
+    }
+
+    while (exponent != 0) {
+        result *= 10;
+        --exponent;
+    }
+    return result;
+}
+
 // private static
-constexpr
-size_t utxo_entry::serialized_size_fixed() {
-    return sizeof(uint32_t) + sizeof(uint32_t) + sizeof(bool);
+utxo_entry::script_template utxo_entry::compress_script(data_chunk const& script) {
+    using domain::machine::opcode;
+    auto const op = [](opcode x) { return static_cast<uint8_t>(x); };
+    auto const size = script.size();
+
+    if (size == 25 && script[0] == op(opcode::dup) && script[1] == op(opcode::hash160)
+        && script[2] == 20 && script[23] == op(opcode::equalverify) && script[24] == op(opcode::checksig)) {
+        return {script_p2pkh, 3, 20};
+    }
+
+    if (size == 23 && script[0] == op(opcode::hash160) && script[1] == 20
+        && script[22] == op(opcode::equal)) {
+        return {script_p2sh, 2, 20};
+    }
+
+    if (size == 35 && script[0] == op(opcode::hash256) && script[1] == 32
+        && script[34] == op(opcode::equal)) {
+        return {script_p2sh32, 2, 32};
+    }
+
+    if (size == 35 && script[0] == 33 && (script[1] == 0x02 || script[1] == 0x03)
+        && script[34] == op(opcode::checksig)) {
+        return {script[1] == 0x02 ? script_p2pk_even : script_p2pk_odd, 2, 32};
+    }
+
+    return {script_raw + size, 0, size};
 }
 
-size_t utxo_entry::serialized_size() const {
-    return output_.serialized_size(false) + serialized_size_fixed();
+// private static
+expect<domain::chain::script> utxo_entry::decompress_script(byte_reader& reader, uint64_t code) {
+    using domain::machine::opcode;
+    auto const op = [](opcode x) { return static_cast<uint8_t>(x); };
+
+    auto const payload_size = [&]() -> size_t {
+        switch (code) {
+            case script_p2pkh:
+            case script_p2sh:
+                return 20;
+            case script_p2pk_even:
+            case script_p2pk_odd:
+            case script_p2sh32:
+                return 32;
+            default:
+                return code >= script_raw ? code - script_raw : 0;
+        }
+    }();
+
+    // Reserved.
+    if (code == script_raw - 1) {
+        return make_unexpected(error::invalid_script_type);
+    }
+
+    auto const payload = reader.read_bytes(payload_size);
+    if ( ! payload) {
+        return make_unexpected(payload.error());
+    }
+
+    data_chunk script;
+    switch (code) {
+        case script_p2pkh:
+            script.reserve(25);
+            script.insert(script.end(), {op(opcode::dup), op(opcode::hash160), 20});
+            script.insert(script.end(), payload->begin(), payload->end());
+            script.insert(script.end(), {op(opcode::equalverify), op(opcode::checksig)});
+            break;
+        case script_p2sh:
+            script.reserve(23);
+            script.insert(script.end(), {op(opcode::hash160), 20});
+            script.insert(script.end(), payload->begin(), payload->end());
+            script.push_back(op(opcode::equal));
+            break;
+        case script_p2sh32:
+            script.reserve(35);
+            script.insert(script.end(), {op(opcode::hash256), 32});
+            script.insert(script.end(), payload->begin(), payload->end());
+            script.push_back(op(opcode::equal));
+            break;
+        case script_p2pk_even:
+        case script_p2pk_odd:
+            script.reserve(35);
+            script.insert(script.end(), {33, uint8_t(code == script_p2pk_even ? 0x02 : 0x03)});
+            script.insert(script.end(), payload->begin(), payload->end());
+            script.push_back(op(opcode::checksig));
+            break;
+        default:
+            script.assign(payload->begin(), payload->end());
+            break;
+    }
+
+    return domain::chain::script(std::move(script), false);
+}
+
+// private static
+expect<uint64_t> utxo_entry::read_varint(byte_reader& reader) {
+    uint64_t value = 0;
+    while (true) {
+        auto const byte = reader.read_byte();
+        if ( ! byte) {
+            return make_unexpected(byte.error());
+        }
+
+        if (value > (max_uint64 >> 7)) {
+            return make_unexpected(error::invalid_size);
+        }
+
+        value = (value << 7) | (*byte & 0x7f);
+        if ((*byte & 0x80) == 0) {
+            return value;
+        }
+
+        if (value == max_uint64) {
+            return make_unexpected(error::invalid_size);
+        }
+        ++value;
+    }
 }
 
 // Serialization.
@@ -65,12 +227,9 @@ size_t utxo_entry::serialized_size() const {
 // static
 data_chunk utxo_entry::to_data_fixed(uint32_t height, uint32_t median_time_past, bool coinbase) {
     data_chunk data;
-    auto const size = serialized_size_fixed();
-    data.reserve(size);
     data_sink ostream(data);
     to_data_fixed(ostream, height, median_time_past, coinbase);
     ostream.flush();
-    KTH_ASSERT(data.size() == size);
     return data;
 }
 
@@ -80,16 +239,20 @@ void utxo_entry::to_data_fixed(std::ostream& stream, uint32_t height, uint32_t m
     to_data_fixed(sink, height, median_time_past, coinbase);
 }
 
+// static
+bool utxo_entry::coinbase_fixed(data_chunk const& fixed) {
+    byte_reader reader(fixed);
+    auto const code = read_varint(reader);
+    return code && (*code & 1) != 0;
+}
+
 // static
 data_chunk utxo_entry::to_data_with_fixed(domain::chain::output const& output, data_chunk const& fixed) {
-    //TODO(fernando):  reuse fixed vector (do not create a new one)
     data_chunk data;
-    auto const size = output.serialized_size(false) + fixed.size();
-    data.reserve(size);
+    data.reserve(fixed.size() + output.serialized_size(true));
     data_sink ostream(data);
     to_data_with_fixed(ostream, output, fixed);
     ostream.flush();
-    KTH_ASSERT(data.size() == size);
     return data;
 }
 
@@ -105,6 +268,46 @@ void utxo_entry::to_data_with_fixed(std::ostream& stream, domain::chain::output
 
 // static
 expect<utxo_entry> utxo_entry::from_data(byte_reader& reader) {
+    auto const height_code = read_varint(reader);
+    if ( ! height_code) {
+        return make_unexpected(height_code.error());
+    }
+
+    auto const median_time_past = reader.read_little_endian<uint32_t>();
+    if ( ! median_time_past) {
+        return make_unexpected(median_time_past.error());
+    }
+
+    auto const amount = read_varint(reader);
+    if ( ! amount) {
+        return make_unexpected(amount.error());
+    }
+
+    auto const script_code = read_varint(reader);
+    if ( ! script_code) {
+        return make_unexpected(script_code.error());
+    }
+
+    domain::chain::token_data_opt token_data;
+    if ((*script_code & 1) != 0) {
+        auto token = domain::chain::token::encoding::from_data(reader);
+        if ( ! token) {
+            return make_unexpected(token.error());
+        }
+        token_data.emplace(std::move(*token));
+    }
+
+    auto script = decompress_script(reader, *script_code >> 1);
+    if ( ! script) {
+        return make_unexpected(script.error());
+    }
+
+    domain::chain::output output(decompress_amount(*amount), std::move(*script), std::move(token_data));
+    return utxo_entry(std::move(output), uint32_t(*height_code >> 1), *median_time_past, (*height_code & 1) != 0);
+}
+
+// static
+expect<utxo_entry> utxo_entry::from_data_legacy(byte_reader& reader) {
     auto output = domain::chain::output::from_data(reader, false);
     if ( ! output) {
         return make_unexpected(output.error());
@@ -134,12 +337,9 @@ expect<utxo_entry> utxo_entry::from_data(byte_reader& reader) {
 
 data_chunk utxo_entry::to_data() const {
     data_chunk data;
-    auto const size = serialized_size();
-    data.reserve(size);
     data_sink ostream(data);
     to_data(ostream);
     ostream.flush();
-    KTH_ASSERT(data.size() == size);
     return data;
 }
 
@@ -42,7 +42,9 @@ settings::settings()
     , reorg_pool_limit(100)      //TODO(fernando): look for a good default
     , db_max_size(get_db_max_size_mainnet(db_mode))
     , safe_mode(true)
-    , cache_capacity(0)
+    , cache_capacity(0)         // MB, the UTXO cache is opt-in
+    , group_commit_blocks(1000)
+    , group_commit_size(256)    // MB
 {}
 
 settings::settings(domain::config::network context)
@@ -0,0 +1,147 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/database.hpp>
+
+using namespace kth;
+using namespace kth::domain::chain;
+using namespace kth::database;
+
+namespace {
+
+constexpr uint32_t bits = 0x1d00ffff;
+
+// Headers linked by the previous block hash.
+std::vector<header> make_chain(size_t count) {
+    std::vector<header> chain;
+    auto previous = null_hash;
+    for (size_t height = 0; height < count; ++height) {
+        hash_digest merkle = null_hash;
+        merkle[0] = uint8_t(height);
+        chain.emplace_back(1, previous, merkle, uint32_t(1231006505 + height), bits, uint32_t(height));
+        previous = chain.back().hash();
+    }
+    return chain;
+}
+
+void push(header_index& index, header const& header, uint32_t height) {
+    index.push(std::make_tuple(header, uint64_t(height), uint64_t(2), uint64_t(3)), header.hash(), height);
+}
+
+} // namespace
+
+// Start Test Suite: header index tests
+
+TEST_CASE("header index  empty", "[header index]") {
+    header_index index;
+    REQUIRE(index.size() == 0);
+    REQUIRE( ! index.top());
+    REQUIRE( ! index.hash(0));
+    REQUIRE( ! index.header(0));
+    REQUIRE(index.headers(0, 10).empty());
+    REQUIRE( ! index.work(0, 10));
+}
+
+TEST_CASE("header index  push and query", "[header index]") {
+    auto const chain = make_chain(5);
+    header_index index;
+    for (size_t height = 0; height < chain.size(); ++height) {
+        push(index, chain[height], uint32_t(height));
+    }
+
+    REQUIRE(index.size() == 5);
+    REQUIRE(*index.top() == 4);
+
+    for (size_t height = 0; height < chain.size(); ++height) {
+        REQUIRE(*index.hash(uint32_t(height)) == chain[height].hash());
+        REQUIRE(*index.height(chain[height].hash()) == height);
+
+        auto const entry = index.header(uint32_t(height));
+        REQUIRE(entry);
+        REQUIRE(std::get<0>(*entry) == chain[height]);
+        REQUIRE(std::get<1>(*entry) == height);
+        REQUIRE(std::get<3>(*entry) == 3);
+    }
+
+    auto const list = index.headers(1, 10);
+    REQUIRE(list.size() == 4);
+    REQUIRE(list.front() == chain[1]);
+    REQUIRE(list.back() == chain[4]);
+
+    auto const proof = header::proof(bits);
+    REQUIRE(*index.work(0, 4) == proof * 5);
+    REQUIRE(*index.work(2, 3) == proof * 2);
+    REQUIRE(*index.work(3, 10) == proof * 2);
+    REQUIRE( ! index.work(5, 10));
+}
+
+TEST_CASE("header index  duplicate is ignored", "[header index]") {
+    auto const chain = make_chain(2);
+    header_index index;
+    push(index, chain[0], 0);
+    push(index, chain[1], 1);
+    push(index, chain[1], 1);
+    REQUIRE(index.size() == 2);
+    REQUIRE(*index.work(0, 1) == header::proof(bits) * 2);
+}
+
+TEST_CASE("header index  truncate", "[header index]") {
+    auto const chain = make_chain(5);
+    header_index index;
+    for (size_t height = 0; height < chain.size(); ++height) {
+        push(index, chain[height], uint32_t(height));
+    }
+
+    index.truncate(3);
+    REQUIRE(index.size() == 3);
+    REQUIRE(*index.top() == 2);
+    REQUIRE( ! index.height(chain[3].hash()));
+    REQUIRE( ! index.header(3));
+
+    // The popped heights can be pushed again.
+    push(index, chain[3], 3);
+    REQUIRE(*index.top() == 3);
+    REQUIRE(std::get<0>(*index.header(3)) == chain[3]);
+
+    index.clear();
+    REQUIRE( ! index.top());
+    REQUIRE( ! index.height(chain[0].hash()));
+}
+
+TEST_CASE("header index  gap", "[header index]") {
+    auto const chain = make_chain(5);
+    header_index index;
+    push(index, chain[0], 0);
+    push(index, chain[3], 3);
+    push(index, chain[4], 4);
+
+    REQUIRE(index.size() == 3);
+    REQUIRE(*index.top() == 4);
+    REQUIRE( ! index.header(1));
+    REQUIRE( ! index.hash(2));
+
+    // The previous block hash of the header after the gap is kept.
+    REQUIRE(std::get<0>(*index.header(3)) == chain[3]);
+    REQUIRE(index.headers(0, 4).size() == 1);
+
+    auto const proof = header::proof(bits);
+    REQUIRE(*index.work(0, 4) == proof * 3);
+
+    push(index, chain[1], 1);
+    push(index, chain[2], 2);
+    REQUIRE(index.size() == 5);
+    REQUIRE(index.headers(0, 4).size() == 5);
+    REQUIRE(*index.work(0, 4) == proof * 5);
+
+    // The gaps below the top are removed with it.
+    header_index sparse;
+    push(sparse, chain[0], 0);
+    push(sparse, chain[3], 3);
+    sparse.truncate(3);
+    REQUIRE(*sparse.top() == 0);
+}
+
+// End Test Suite
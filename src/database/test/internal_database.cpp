@@ -900,6 +900,132 @@ TEST_CASE("internal database  spend", "[None]") {
 }
 
 
+TEST_CASE("internal database  get utxos batch", "[None]") {
+    //79880
+    auto const orig = get_block("01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000");
+    //80000
+    auto const spender = get_block("01000000ba8b9cda965dd8e536670f9ddec10e53aab14b20bacad27b9137190000000000190760b278fe7b8565fda3b968b918d5fd997f993b23674c0af3b6fde300b38f33a5914ce6ed5b1b01e32f570201000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b014effffffff0100f2052a01000000434104b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059cc6469d65c665ccfd1cfeb75c6e8e19413bba7fbff9bc762419a76d87b16086eac000000000100000001a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f5000000004948304502206e21798a42fae0e854281abd38bacd1aeed3ee3738d9e1446618c4571d1090db022100e2ac980643b0b82c0e88ffdfec6b64e3e6ba35e7ba5fdd7d5d6cc8d25c6b241501ffffffff0100f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac00000000");
+
+    internal_database db(db_path, db_mode_type::full, 10000000, db_size, true);
+    REQUIRE(db.open());
+    REQUIRE(db.push_block(orig, 0, 1) == result_code::success);
+    REQUIRE(db.push_block(spender, 1, 1) == result_code::success);
+
+    hash_digest spent;
+    hash_digest coinbase;
+    hash_digest txid;
+    REQUIRE(decode_hash(spent, "f5d8ee39a430901c91a5917b9f2dc19d6d1a0e9cea205b009ca73dd04470b9a6"));
+    REQUIRE(decode_hash(coinbase, "c06fbab289f723c6261d3030ddb6be121f7d2508d77862bb1e484f5cd7f92b25"));
+    REQUIRE(decode_hash(txid, "5a4ebf66822b0b2d56bd9dc64ece0bc38ee7844a23ff1d7320a88c5fdb2ad3e2"));
+
+    output_point const p0{txid, 0};
+    output_point const p1{spent, 0};
+    output_point const p2{coinbase, 0};
+    output_point const p3{txid, 1};
+
+    // Not in key order, the entries must come back in the given order.
+    auto const entries = db.get_utxos({&p0, &p1, &p2, &p3, &p0});
+    REQUIRE(entries.size() == 5);
+
+    REQUIRE(entries[0].is_valid());
+    REQUIRE( ! entries[0].coinbase());
+    REQUIRE(encode_base16(entries[0].output().to_data(true)) == "00f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac");
+
+    REQUIRE( ! entries[1].is_valid());
+
+    REQUIRE(entries[2].is_valid());
+    REQUIRE(entries[2].height() == 1);
+    REQUIRE(entries[2].coinbase());
+
+    REQUIRE( ! entries[3].is_valid());
+
+    REQUIRE(entries[4].is_valid());
+    REQUIRE(entries[4].output().value() == entries[0].output().value());
+}
+
+TEST_CASE("internal database  group commit", "[None]") {
+    //79880
+    auto const orig = std::make_shared<block const>(get_block("01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000"));
+    //80000
+    auto const spender = std::make_shared<block const>(get_block("01000000ba8b9cda965dd8e536670f9ddec10e53aab14b20bacad27b9137190000000000190760b278fe7b8565fda3b968b918d5fd997f993b23674c0af3b6fde300b38f33a5914ce6ed5b1b01e32f570201000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b014effffffff0100f2052a01000000434104b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059cc6469d65c665ccfd1cfeb75c6e8e19413bba7fbff9bc762419a76d87b16086eac000000000100000001a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f5000000004948304502206e21798a42fae0e854281abd38bacd1aeed3ee3738d9e1446618c4571d1090db022100e2ac980643b0b82c0e88ffdfec6b64e3e6ba35e7ba5fdd7d5d6cc8d25c6b241501ffffffff0100f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac00000000"));
+
+    hash_digest spent;
+    REQUIRE(decode_hash(spent, "f5d8ee39a430901c91a5917b9f2dc19d6d1a0e9cea205b009ca73dd04470b9a6"));
+    output_point const point{spent, 0};
+
+    {
+        internal_database db(db_path, db_mode_type::full, 10000000, db_size, true, 0, 10, 0);
+        REQUIRE(db.open());
+        REQUIRE(db.push_block_deferred(orig, 0, 1) == result_code::success);
+        REQUIRE(db.push_block_deferred(spender, 1, 1) == result_code::success);
+
+        // Pending, only the headers are visible.
+        uint32_t height;
+        REQUIRE(db.get_last_height(height) == result_code::success);
+        REQUIRE(height == 1);
+        REQUIRE(db.get_header(1).hash() == spender->hash());
+        REQUIRE(db.get_header(spender->hash()).second == 1);
+        REQUIRE(db.get_headers(0, 1).size() == 2);
+        REQUIRE( ! db.get_block(1).is_valid());
+        REQUIRE( ! db.get_utxo(output_point{spender->transactions()[1].hash(), 0}).is_valid());
+    }   //close() implicit, writes the pending blocks
+
+    internal_database db(db_path, db_mode_type::full, 10000000, db_size, true);
+    REQUIRE(db.open());
+
+    uint32_t height;
+    REQUIRE(db.get_last_height(height) == result_code::success);
+    REQUIRE(height == 1);
+    REQUIRE(db.get_block(1).is_valid());
+    REQUIRE( ! db.get_utxo(point).is_valid());
+
+    // The header index is loaded from the store.
+    REQUIRE(*db.get_block_hash(0) == orig->hash());
+    REQUIRE(*db.get_block_hash(1) == spender->hash());
+    REQUIRE(db.get_header(spender->hash()).second == 1);
+    REQUIRE(*db.get_work(0, 1) == orig->header().proof() + spender->header().proof());
+    REQUIRE(db.get_utxo(output_point{spender->transactions()[1].hash(), 0}).is_valid());
+}
+
+TEST_CASE_METHOD(internal_database_directory_setup_fixture, "internal database  group commit  failed write keeps the pending blocks", "[None]") {
+    //79880
+    auto const orig = std::make_shared<block const>(get_block("01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000"));
+    //80000
+    auto const spender = std::make_shared<block const>(get_block("01000000ba8b9cda965dd8e536670f9ddec10e53aab14b20bacad27b9137190000000000190760b278fe7b8565fda3b968b918d5fd997f993b23674c0af3b6fde300b38f33a5914ce6ed5b1b01e32f570201000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b014effffffff0100f2052a01000000434104b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059cc6469d65c665ccfd1cfeb75c6e8e19413bba7fbff9bc762419a76d87b16086eac000000000100000001a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f5000000004948304502206e21798a42fae0e854281abd38bacd1aeed3ee3738d9e1446618c4571d1090db022100e2ac980643b0b82c0e88ffdfec6b64e3e6ba35e7ba5fdd7d5d6cc8d25c6b241501ffffffff0100f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac00000000"));
+    auto const genesis = get_genesis();
+
+    {
+        internal_database db(db_path, db_mode_type::full, 10000000, db_size, true, 0, 10, 0);
+        REQUIRE(db.open());
+        REQUIRE(db.push_block(genesis, 0, 1) == result_code::success);
+
+        // The output spent by the block is not in the store, writing it fails.
+        REQUIRE(db.push_block_deferred(spender, 1, 1) == result_code::success);
+        REQUIRE( ! succeed(db.commit_pending_blocks()));
+
+        // The block was reported as pushed, it is not dropped.
+        uint32_t height;
+        REQUIRE(db.get_last_height(height) == result_code::success);
+        REQUIRE(height == 1);
+        REQUIRE(db.get_header(spender->hash()).second == 1);
+        REQUIRE( ! db.get_block(1).is_valid());
+
+        // No other block is written on top of it.
+        REQUIRE( ! succeed(db.push_block_deferred(orig, 2, 1)));
+        REQUIRE( ! succeed(db.push_block(*orig, 2, 1)));
+        REQUIRE( ! db.get_header(orig->hash()).first.is_valid());
+    }   //close() implicit, fails again
+
+    // The store stays at the last commit.
+    internal_database db(db_path, db_mode_type::full, 10000000, db_size, true);
+    REQUIRE(db.open());
+
+    uint32_t height;
+    REQUIRE(db.get_last_height(height) == result_code::success);
+    REQUIRE(height == 0);
+    REQUIRE( ! db.get_header(spender->hash()).first.is_valid());
+}
+
 TEST_CASE("internal database  reorg", "[None]") {
     //79880 - 00000000002e872c6fbbcf39c93ef0d89e33484ebf457f6829cbf4b561f3af5a
     std::string orig_enc = "01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000";
@@ -3854,6 +3980,82 @@ TEST_CASE("internal database  prune empty reorg pool 3", "[None]") {
 }
 
 
+TEST_CASE_METHOD(internal_database_directory_setup_fixture, "internal database  utxo cache write back", "[None]") {
+    //79880 - 00000000002e872c6fbbcf39c93ef0d89e33484ebf457f6829cbf4b561f3af5a
+    std::string orig_enc = "01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000";
+    auto const orig = get_block(orig_enc);
+
+    //80000 - 000000000043a8c0fd1d6f726790caa2a406010d19efd2780db27bdbbd93baf6
+    std::string spender_enc = "01000000ba8b9cda965dd8e536670f9ddec10e53aab14b20bacad27b9137190000000000190760b278fe7b8565fda3b968b918d5fd997f993b23674c0af3b6fde300b38f33a5914ce6ed5b1b01e32f570201000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b014effffffff0100f2052a01000000434104b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059cc6469d65c665ccfd1cfeb75c6e8e19413bba7fbff9bc762419a76d87b16086eac000000000100000001a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f5000000004948304502206e21798a42fae0e854281abd38bacd1aeed3ee3738d9e1446618c4571d1090db022100e2ac980643b0b82c0e88ffdfec6b64e3e6ba35e7ba5fdd7d5d6cc8d25c6b241501ffffffff0100f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac00000000";
+    auto const spender = get_block(spender_enc);
+
+    // Both blocks are out of the reorg window, their UTXOs stay in the cache.
+    using my_clock = dummy_clock<1284613427 + 600>;
+
+    output_point const spent {orig.transactions()[0].hash(), 0};
+    output_point const coinbase {spender.transactions()[0].hash(), 0};
+    output_point const output {spender.transactions()[1].hash(), 0};
+
+    {
+        internal_database_basis<my_clock> db(db_path, db_mode_type::full, 1, db_size, true, 16);
+        REQUIRE(db.open());
+        REQUIRE(db.push_block(orig, 0, 1) == result_code::success);
+        REQUIRE(db.get_utxo(spent).is_valid());
+
+        REQUIRE(db.push_block(spender, 1, 1) == result_code::success);
+        REQUIRE( ! db.get_utxo(spent).is_valid());
+        REQUIRE(db.get_utxo(coinbase).is_valid());
+        REQUIRE(db.get_utxo(coinbase).height() == 1);
+        REQUIRE(db.get_utxo(coinbase).coinbase());
+        REQUIRE(db.get_utxo(output).is_valid());
+        REQUIRE( ! db.get_utxo(output).coinbase());
+    }   //close() flushes
+
+    {
+        internal_database_basis<my_clock> db(db_path, db_mode_type::full, 1, db_size, true);
+        REQUIRE(db.open());
+        REQUIRE( ! db.get_utxo(spent).is_valid());
+        REQUIRE(db.get_utxo(coinbase).is_valid());
+        REQUIRE(db.get_utxo(output).is_valid());
+        REQUIRE(db.get_utxo(output).height() == 1);
+
+        uint32_t height;
+        REQUIRE(db.get_last_height(height) == result_code::success);
+        REQUIRE(height == 1);
+    }
+}
+
+TEST_CASE_METHOD(internal_database_directory_setup_fixture, "internal database  utxo cache flush before reorg window", "[None]") {
+    //79880 - 00000000002e872c6fbbcf39c93ef0d89e33484ebf457f6829cbf4b561f3af5a
+    std::string orig_enc = "01000000a594fda9d85f69e762e498650d6fdb54d838657cea7841915203170000000000a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f505da904ce6ed5b1b017fe8070101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b015cffffffff0100f2052a01000000434104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac00000000";
+    auto const orig = get_block(orig_enc);
+
+    //80000 - 000000000043a8c0fd1d6f726790caa2a406010d19efd2780db27bdbbd93baf6
+    std::string spender_enc = "01000000ba8b9cda965dd8e536670f9ddec10e53aab14b20bacad27b9137190000000000190760b278fe7b8565fda3b968b918d5fd997f993b23674c0af3b6fde300b38f33a5914ce6ed5b1b01e32f570201000000010000000000000000000000000000000000000000000000000000000000000000ffffffff0704e6ed5b1b014effffffff0100f2052a01000000434104b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059cc6469d65c665ccfd1cfeb75c6e8e19413bba7fbff9bc762419a76d87b16086eac000000000100000001a6b97044d03da79c005b20ea9c0e1a6d9dc12d9f7b91a5911c9030a439eed8f5000000004948304502206e21798a42fae0e854281abd38bacd1aeed3ee3738d9e1446618c4571d1090db022100e2ac980643b0b82c0e88ffdfec6b64e3e6ba35e7ba5fdd7d5d6cc8d25c6b241501ffffffff0100f2052a010000001976a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac00000000";
+    auto const spender = get_block(spender_enc);
+
+    // orig is out of the reorg window (cached), spender is not.
+    using my_clock = dummy_clock<1284613427>;
+
+    internal_database_basis<my_clock> db(db_path, db_mode_type::full, 86, db_size, true, 16);
+    REQUIRE(db.open());
+    REQUIRE(db.push_block(orig, 0, 1) == result_code::success);
+    REQUIRE(db.push_block(spender, 1, 1) == result_code::success);
+
+    // The reorg pool got the spent output from the flushed utxo_db.
+    auto const pool = db.get_utxo_pool_from(1, 1);
+    REQUIRE(pool.first == result_code::success);
+    REQUIRE(pool.second.size() == 1);
+    REQUIRE(pool.second.begin()->first.hash() == orig.transactions()[0].hash());
+
+    domain::chain::block out_block;
+    REQUIRE(db.pop_block(out_block) == result_code::success);
+    REQUIRE(out_block.hash() == spender.hash());
+    REQUIRE(db.get_utxo(output_point{orig.transactions()[0].hash(), 0}).is_valid());
+    REQUIRE( ! db.get_utxo(output_point{spender.transactions()[0].hash(), 0}).is_valid());
+}
+
+
 
 
 
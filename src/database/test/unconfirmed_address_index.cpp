@@ -0,0 +1,136 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/database.hpp>
+
+using namespace kth;
+using namespace kth::domain::chain;
+using namespace kth::database;
+using kth::domain::wallet::payment_address;
+
+namespace {
+
+short_hash make_hash(uint8_t value) {
+    short_hash hash = null_short_hash;
+    hash[0] = value;
+    return hash;
+}
+
+output pay_to(short_hash const& hash, uint64_t value) {
+    return output{value, script{script::to_pay_public_key_hash_pattern(hash)}, token_data_opt{}};
+}
+
+output pay_to_script(short_hash const& hash, uint64_t value) {
+    return output{value, script{script::to_pay_script_hash_pattern(hash)}, token_data_opt{}};
+}
+
+transaction make_tx(output_point const& previous, transaction::outs const& outputs) {
+    return transaction{1, 0, {input{previous, script{}, 0}}, outputs};
+}
+
+} // namespace
+
+// Start Test Suite: unconfirmed address index tests
+
+TEST_CASE("unconfirmed address index  outputs", "[unconfirmed address index]") {
+    auto const alice = make_hash(1);
+    auto const bob = make_hash(2);
+    auto const tx = make_tx(output_point{null_hash, 0}, {pay_to(alice, 10), pay_to(bob, 20), pay_to(alice, 30)});
+
+    unconfirmed_address_index index;
+    index.add(tx, 42, {output{}});
+    REQUIRE(index.size() == 1);
+
+    auto const entries = index.find(payment_address(alice, payment_address::mainnet_p2kh));
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].hash == tx.hash());
+    REQUIRE(entries[0].index == 0);
+    REQUIRE( ! entries[0].input);
+    REQUIRE(entries[0].delta == 10);
+    REQUIRE(entries[0].arrival_time == 42);
+    REQUIRE(entries[1].index == 2);
+    REQUIRE(entries[1].delta == 30);
+
+    // The kind of address is part of the key, not the network.
+    REQUIRE(index.find(payment_address(bob, payment_address::testnet_p2kh)).size() == 1);
+    REQUIRE(index.find(payment_address(bob, payment_address::mainnet_p2sh)).empty());
+    REQUIRE(index.find(payment_address(make_hash(3), payment_address::mainnet_p2kh)).empty());
+}
+
+TEST_CASE("unconfirmed address index  inputs use the prevout script", "[unconfirmed address index]") {
+    auto const alice = make_hash(1);
+    auto const carol = make_hash(3);
+    auto const funding = make_tx(output_point{null_hash, 0}, {pay_to_script(carol, 50)});
+    auto const spending = make_tx(output_point{funding.hash(), 0}, {pay_to(alice, 45)});
+
+    unconfirmed_address_index index;
+    index.add(funding, 1, {output{}});
+    index.add(spending, 2, {funding.outputs()[0]});
+    REQUIRE(index.size() == 2);
+
+    auto const entries = index.find(payment_address(carol, payment_address::mainnet_p2sh));
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].hash == funding.hash());
+    REQUIRE(entries[0].delta == 50);
+
+    REQUIRE(entries[1].hash == spending.hash());
+    REQUIRE(entries[1].input);
+    REQUIRE(entries[1].index == 0);
+    REQUIRE(entries[1].delta == -50);
+    REQUIRE(entries[1].previous_output == output_point{funding.hash(), 0});
+    REQUIRE(entries[1].arrival_time == 2);
+}
+
+TEST_CASE("unconfirmed address index  remove", "[unconfirmed address index]") {
+    auto const alice = make_hash(1);
+    auto const first = make_tx(output_point{null_hash, 0}, {pay_to(alice, 10)});
+    auto const second = make_tx(output_point{null_hash, 1}, {pay_to(alice, 20)});
+    payment_address const address(alice, payment_address::mainnet_p2kh);
+
+    unconfirmed_address_index index;
+    index.add(first, 1, {output{}});
+    index.add(second, 2, {output{}});
+
+    // A transaction already indexed is ignored.
+    index.add(first, 3, {output{}});
+    REQUIRE(index.size() == 2);
+    REQUIRE(index.find(address).size() == 2);
+
+    index.remove(first.hash());
+    REQUIRE(index.size() == 1);
+    auto const entries = index.find(address);
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].hash == second.hash());
+
+    index.remove(first.hash());
+    REQUIRE(index.size() == 1);
+
+    index.clear();
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.find(address).empty());
+}
+
+TEST_CASE("unconfirmed address index  transactions", "[unconfirmed address index]") {
+    auto const first = make_tx(output_point{null_hash, 0}, {pay_to(make_hash(1), 10)});
+
+    // Transactions without addresses are kept as well.
+    auto const second = make_tx(output_point{null_hash, 1}, {output{20, script{}, token_data_opt{}}});
+
+    unconfirmed_address_index index;
+    index.add(first, 1, {output{}});
+    index.add(second, 2, {output{}});
+
+    auto hashes = index.transactions();
+    std::sort(hashes.begin(), hashes.end());
+    hash_list expected {first.hash(), second.hash()};
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(hashes == expected);
+
+    index.remove(first.hash());
+    REQUIRE(index.transactions() == hash_list{second.hash()});
+}
+
+// End Test Suite
@@ -0,0 +1,144 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/database.hpp>
+
+using namespace kth;
+using namespace kth::domain::chain;
+using namespace kth::database;
+
+namespace {
+
+constexpr size_t cache_size = 16 * 1024 * 1024;
+
+point make_point(uint8_t seed, uint32_t index) {
+    hash_digest hash = null_hash;
+    hash[0] = seed;
+    hash[31] = seed;
+    return point{hash, index};
+}
+
+data_chunk make_value(uint8_t seed) {
+    return data_chunk(10, seed);
+}
+
+} // namespace
+
+// Start Test Suite: utxo cache tests
+
+TEST_CASE("utxo cache  disabled", "[utxo cache]") {
+    utxo_cache cache(0);
+    REQUIRE( ! cache.enabled());
+    REQUIRE(cache.size() == 0);
+    REQUIRE( ! cache.find(make_point(1, 0)).cached);
+}
+
+TEST_CASE("utxo cache  created and spent never dirty", "[utxo cache]") {
+    utxo_cache cache(cache_size);
+    REQUIRE(cache.enabled());
+
+    utxo_cache_batch created;
+    created[make_point(1, 0)] = make_value(1);
+    cache.apply(created, true);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.dirty() == 1);
+
+    auto const found = cache.find(make_point(1, 0));
+    REQUIRE(found.cached);
+    REQUIRE(found.value != nullptr);
+    REQUIRE(*found.value == make_value(1));
+
+    utxo_cache_batch spent;
+    spent[make_point(1, 0)] = std::nullopt;
+    cache.apply(spent, true);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.dirty() == 0);
+    REQUIRE(cache.dirty_entries(false).empty());
+}
+
+TEST_CASE("utxo cache  spend of uncached output", "[utxo cache]") {
+    utxo_cache cache(cache_size);
+
+    utxo_cache_batch spent;
+    spent[make_point(2, 3)] = std::nullopt;
+    cache.apply(spent, true);
+
+    auto const found = cache.find(make_point(2, 3));
+    REQUIRE(found.cached);
+    REQUIRE(found.value == nullptr);
+
+    auto const writes = cache.dirty_entries(false);
+    REQUIRE(writes.size() == 1);
+    REQUIRE(writes[0].value == nullptr);
+    REQUIRE(writes[0].key == make_point(2, 3).to_data(false));
+
+    cache.mark_flushed();
+    REQUIRE(cache.size() == 0);
+    REQUIRE( ! cache.find(make_point(2, 3)).cached);
+}
+
+TEST_CASE("utxo cache  dirty entries sorted by key", "[utxo cache]") {
+    utxo_cache cache(cache_size);
+
+    utxo_cache_batch batch;
+    for (int i = 200; i > 0; i -= 7) {
+        batch[make_point(uint8_t(i), uint32_t(i))] = make_value(uint8_t(i));
+    }
+    cache.apply(batch, true);
+
+    auto const writes = cache.dirty_entries(false);
+    REQUIRE(writes.size() == cache.size());
+    for (size_t i = 1; i < writes.size(); ++i) {
+        REQUIRE(writes[i - 1].key < writes[i].key);
+    }
+}
+
+TEST_CASE("utxo cache  flush and evict", "[utxo cache]") {
+    utxo_cache cache(cache_size);
+
+    utxo_cache_batch batch;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        batch[make_point(uint8_t(i), i)] = make_value(uint8_t(i));
+    }
+    cache.apply(batch, true);
+    REQUIRE(cache.size() == 5000);
+    REQUIRE(cache.dirty() == 5000);
+
+    cache.mark_flushed();
+    REQUIRE(cache.size() == 5000);
+    REQUIRE(cache.dirty() == 0);
+
+    // A flushed entry spent again must be deleted from utxo_db.
+    utxo_cache_batch spent;
+    spent[make_point(7, 7)] = std::nullopt;
+    cache.apply(spent, true);
+    REQUIRE(cache.dirty() == 1);
+
+    cache.evict();
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.find(make_point(7, 7)).cached);
+    REQUIRE( ! cache.find(make_point(8, 8)).cached);
+}
+
+TEST_CASE("utxo cache  written through entries are clean", "[utxo cache]") {
+    utxo_cache cache(cache_size);
+
+    utxo_cache_batch batch;
+    batch[make_point(1, 0)] = make_value(1);
+    batch[make_point(2, 0)] = make_value(2);
+    cache.apply(batch, false);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.dirty() == 0);
+
+    utxo_cache_batch spent;
+    spent[make_point(1, 0)] = std::nullopt;
+    cache.apply(spent, false);
+    REQUIRE(cache.size() == 1);
+    REQUIRE( ! cache.find(make_point(1, 0)).cached);
+    REQUIRE(cache.find(make_point(2, 0)).cached);
+}
+
+// End Test Suite
@@ -0,0 +1,132 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/database.hpp>
+#include <kth/infrastructure/utility/ostream_writer.hpp>
+
+using namespace kth;
+using namespace kth::domain::chain;
+using namespace kth::database;
+
+namespace {
+
+script make_script(std::string const& hex) {
+    data_chunk data;
+    REQUIRE(decode_base16(data, hex));
+    return script(std::move(data), false);
+}
+
+utxo_entry round_trip(utxo_entry const& entry) {
+    auto const data = entry.to_data();
+    byte_reader reader(data);
+    auto const res = utxo_entry::from_data(reader);
+    REQUIRE(res);
+    REQUIRE(reader.remaining_size() == 0);
+    return *res;
+}
+
+void check_round_trip(output const& out, size_t expected_size) {
+    utxo_entry const entry(out, 650000, 1600000000, false);
+    REQUIRE(entry.serialized_size() == expected_size);
+
+    auto const res = round_trip(entry);
+    REQUIRE(res.output() == entry.output());
+    REQUIRE(res.height() == 650000);
+    REQUIRE(res.median_time_past() == 1600000000);
+    REQUIRE( ! res.coinbase());
+}
+
+} // namespace
+
+// Start Test Suite: utxo entry tests
+
+TEST_CASE("utxo entry  compress amount round trip", "[utxo entry]") {
+    for (uint64_t value : {uint64_t(0), uint64_t(1), uint64_t(546), uint64_t(1000), uint64_t(5000000000),
+                           uint64_t(123456789), uint64_t(2100000000000000)}) {
+        REQUIRE(utxo_entry::decompress_amount(utxo_entry::compress_amount(value)) == value);
+    }
+
+    REQUIRE(utxo_entry::compress_amount(5000000000) < 0x80);
+}
+
+TEST_CASE("utxo entry  p2pkh", "[utxo entry]") {
+    output const out{5000000000, make_script("76a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac"), token_data_opt{}};
+    // 3 height, 4 mtp, 1 amount, 1 script code, 20 hash
+    check_round_trip(out, 29);
+}
+
+TEST_CASE("utxo entry  p2sh", "[utxo entry]") {
+    output const out{1234, make_script("a914404371705fa9bd789a2fcd52d2c580b65d35549d87"), token_data_opt{}};
+    check_round_trip(out, 3 + 4 + 2 + 1 + 20);
+}
+
+TEST_CASE("utxo entry  p2sh32", "[utxo entry]") {
+    output const out{1234, make_script("aa20404371705fa9bd789a2fcd52d2c580b65d35549d404371705fa9bd789a2fcd5287"), token_data_opt{}};
+    check_round_trip(out, 3 + 4 + 2 + 1 + 32);
+}
+
+TEST_CASE("utxo entry  p2pk compressed", "[utxo entry]") {
+    output const out{5000000000, make_script("2103b68a50eaa0287eff855189f949c1c6e5f58b37c88231373d8a59809cbae83059ac"), token_data_opt{}};
+    check_round_trip(out, 3 + 4 + 1 + 1 + 32);
+}
+
+TEST_CASE("utxo entry  raw script", "[utxo entry]") {
+    // P2PK with an uncompressed key is kept raw.
+    auto const raw = make_script("4104283338ffd784c198147f99aed2cc16709c90b1522e3b3637b312a6f9130e0eda7081e373a96d36be319710cd5c134aaffba81ff08650d7de8af332fe4d8cde20ac");
+    output const out{5000000000, raw, token_data_opt{}};
+    check_round_trip(out, 3 + 4 + 1 + 2 + 67);
+
+    output const empty{0, script{}, token_data_opt{}};
+    check_round_trip(empty, 3 + 4 + 1 + 1);
+}
+
+TEST_CASE("utxo entry  token data", "[utxo entry]") {
+    token_data_opt const token = token_data_t{hash_digest{1, 2, 3}, fungible{amount_t{1000}}};
+    output const out{800, make_script("76a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac"), token};
+
+    utxo_entry const entry(out, 800000, 1700000000, true);
+    auto const res = round_trip(entry);
+    REQUIRE(res.output() == out);
+    REQUIRE(res.output().token_data().has_value());
+    REQUIRE(res.coinbase());
+}
+
+TEST_CASE("utxo entry  fixed data", "[utxo entry]") {
+    output const out{5000000000, make_script("76a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac"), token_data_opt{}};
+
+    auto const fixed = utxo_entry::to_data_fixed(800000, 1700000000, true);
+    REQUIRE(utxo_entry::coinbase_fixed(fixed));
+    REQUIRE( ! utxo_entry::coinbase_fixed(utxo_entry::to_data_fixed(800000, 1700000000, false)));
+
+    auto const data = utxo_entry::to_data_with_fixed(out, fixed);
+    REQUIRE(data == utxo_entry(out, 800000, 1700000000, true).to_data());
+}
+
+TEST_CASE("utxo entry  legacy format", "[utxo entry]") {
+    output const out{5000000000, make_script("76a914404371705fa9bd789a2fcd52d2c580b65d35549d88ac"), token_data_opt{}};
+
+    // output (non wire) + height + mtp + coinbase
+    auto data = out.to_data(false);
+    data_sink ostream(data);
+    ostream_writer sink(ostream);
+    sink.write_4_bytes_little_endian(42);
+    sink.write_4_bytes_little_endian(1234);
+    sink.write_byte(1);
+    ostream.flush();
+
+    byte_reader reader(data);
+    auto const res = utxo_entry::from_data_legacy(reader);
+    REQUIRE(res);
+    REQUIRE(res->output() == out);
+    REQUIRE(res->height() == 42);
+    REQUIRE(res->median_time_past() == 1234);
+    REQUIRE(res->coinbase());
+
+    // The compact encoding is what the migration writes back.
+    REQUIRE(res->to_data().size() < data.size());
+}
+
+// End Test Suite
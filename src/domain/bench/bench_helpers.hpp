@@ -0,0 +1,173 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_BENCH_HELPERS_HPP
+#define KTH_DOMAIN_BENCH_HELPERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain.hpp>
+
+// Synthetic fixtures shaped like the mainnet traffic: P2PKH spends with
+// realistic signature and key sizes, some many-input consolidations and
+// CashToken outputs. The content is pseudo random with a fixed seed, so every
+// run benchmarks the same bytes.
+
+namespace kth::domain::bench {
+
+// Mainnet blocks of the last years carry up to a few thousand transactions.
+constexpr size_t large_block_transactions = 4000;
+constexpr size_t many_inputs = 1000;
+
+class generator {
+public:
+    explicit
+    generator(uint64_t seed = 42)
+        : engine_(seed)
+    {}
+
+    uint64_t number() {
+        return engine_();
+    }
+
+    data_chunk bytes(size_t size) {
+        data_chunk out(size);
+        for (auto& byte : out) {
+            byte = uint8_t(engine_());
+        }
+        return out;
+    }
+
+    hash_digest digest() {
+        hash_digest out;
+        for (auto& byte : out) {
+            byte = uint8_t(engine_());
+        }
+        return out;
+    }
+
+    short_hash short_digest() {
+        short_hash out;
+        for (auto& byte : out) {
+            byte = uint8_t(engine_());
+        }
+        return out;
+    }
+
+private:
+    std::mt19937_64 engine_;
+};
+
+// A 72 byte DER signature (with the sighash byte) and a compressed key.
+inline
+chain::input p2pkh_input(generator& random) {
+    chain::script script(machine::operation::list {
+        machine::operation(random.bytes(72)),
+        machine::operation(random.bytes(33))
+    });
+    return {chain::output_point(random.digest(), uint32_t(random.number() % 4)), std::move(script), max_input_sequence};
+}
+
+inline
+chain::output p2pkh_output(generator& random) {
+    auto script = chain::script(chain::script::to_pay_public_key_hash_pattern(random.short_digest()));
+    return {random.number() % 100'000'000, std::move(script), chain::token_data_opt{}};
+}
+
+// A fungible amount and a mutable NFT with a 40 byte commitment.
+inline
+chain::output token_output(generator& random) {
+    chain::token_data_t token_data {
+        random.digest(),
+        chain::both_kinds {
+            chain::fungible{chain::amount_t(1 + random.number() % 1'000'000)},
+            chain::non_fungible{chain::capability_t::mut, random.bytes(40)}
+        }
+    };
+
+    auto script = chain::script(chain::script::to_pay_public_key_hash_pattern(random.short_digest()));
+    return {1000, std::move(script), chain::token_data_opt(std::move(token_data))};
+}
+
+inline
+chain::transaction make_transaction(generator& random, size_t inputs, size_t outputs, bool tokens) {
+    chain::input::list ins;
+    ins.reserve(inputs);
+    for (size_t index = 0; index < inputs; ++index) {
+        ins.push_back(p2pkh_input(random));
+    }
+
+    chain::output::list outs;
+    outs.reserve(outputs);
+    for (size_t index = 0; index < outputs; ++index) {
+        outs.push_back(tokens && index == 0 ? token_output(random) : p2pkh_output(random));
+    }
+
+    return {2, 0, std::move(ins), std::move(outs)};
+}
+
+inline
+chain::transaction make_coinbase(generator& random) {
+    chain::script script(machine::operation::list {
+        machine::operation(random.bytes(4)),
+        machine::operation(random.bytes(20))
+    });
+
+    chain::input::list ins {{chain::output_point(null_hash, chain::point::null_index), std::move(script), max_input_sequence}};
+    chain::output::list outs {p2pkh_output(random)};
+    return {1, 0, std::move(ins), std::move(outs)};
+}
+
+// Most transactions spend two coins into two outputs, one in eight carries a
+// token output and one in fifty is a twenty input consolidation.
+inline
+chain::block make_block(size_t transactions) {
+    generator random;
+
+    chain::transaction::list txs;
+    txs.reserve(transactions);
+    txs.push_back(make_coinbase(random));
+
+    for (size_t index = 1; index < transactions; ++index) {
+        auto const inputs = index % 50 == 0 ? 20 : 2;
+        txs.push_back(make_transaction(random, inputs, 2, index % 8 == 0));
+    }
+
+    chain::block result(chain::header{}, std::move(txs));
+    chain::header header(0x20000000, random.digest(), result.generate_merkle_root(), 1700000000, 0x18034b7c, uint32_t(random.number()));
+    result.set_header(header);
+    return result;
+}
+
+// The fixtures are built once per process.
+
+inline
+chain::block const& large_block() {
+    static auto const instance = make_block(large_block_transactions);
+    return instance;
+}
+
+inline
+data_chunk const& large_block_data() {
+    static auto const instance = large_block().to_data();
+    return instance;
+}
+
+inline
+chain::transaction const& many_inputs_transaction() {
+    static auto const instance = [] {
+        generator random;
+        return make_transaction(random, many_inputs, 2, false);
+    }();
+    return instance;
+}
+
+} // namespace kth::domain::bench
+
+#endif
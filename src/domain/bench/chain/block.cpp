@@ -0,0 +1,93 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <optional>
+#include <vector>
+
+#include <bench_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kd::bench;
+
+// Start Benchmark Suite: block benchmarks
+
+TEST_CASE("block  from data  large block", "[block benchmarks]") {
+    auto const& data = large_block_data();
+
+    BENCHMARK("block::from_data") {
+        byte_reader reader(data);
+        return chain::block::from_data(reader);
+    };
+
+    BENCHMARK("block::from_data arena") {
+        byte_reader reader(data);
+        return chain::block::from_data(reader, true, true);
+    };
+}
+
+// Parsed outside of the measurement, only the destruction is timed.
+TEST_CASE("block  destroy  large block", "[block benchmarks]") {
+    for (auto const arena : {false, true}) {
+        BENCHMARK_ADVANCED(arena ? "block::~block arena" : "block::~block")(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::optional<chain::block>> blocks(meter.runs());
+            for (auto& block : blocks) {
+                byte_reader reader(large_block_data());
+                block.emplace(std::move(*chain::block::from_data(reader, true, arena)));
+            }
+
+            meter.measure([&blocks](int run) {
+                blocks[run].reset();
+            });
+        };
+    }
+}
+
+TEST_CASE("block  to data  large block", "[block benchmarks]") {
+    auto const& block = large_block();
+
+    BENCHMARK("block::to_data") {
+        return block.to_data();
+    };
+}
+
+// The memoized benchmark measures the tree alone, the cold one includes the
+// transaction hashes (blocks freshly deserialized have none cached).
+TEST_CASE("block  generate merkle root  large block", "[block benchmarks]") {
+    auto const& block = large_block();
+    REQUIRE(block.generate_merkle_root() == block.header().merkle());
+
+    BENCHMARK("block_basis::generate_merkle_root memoized") {
+        return block.generate_merkle_root();
+    };
+
+    BENCHMARK_ADVANCED("block_basis::generate_merkle_root cold")(Catch::Benchmark::Chronometer meter) {
+        std::vector<chain::block> blocks;
+        blocks.reserve(meter.runs());
+        for (int run = 0; run < meter.runs(); ++run) {
+            byte_reader reader(large_block_data());
+            blocks.push_back(*chain::block::from_data(reader));
+        }
+
+        meter.measure([&blocks](int run) {
+            return blocks[run].generate_merkle_root();
+        });
+    };
+}
+
+TEST_CASE("block  header hash", "[block benchmarks]") {
+    auto const& header = large_block().header();
+    header.hash();
+
+    BENCHMARK("hash_memoizer::hash memoized") {
+        return header.hash();
+    };
+
+    BENCHMARK("hash_memoizer::hash cold") {
+        header.invalidate();
+        return header.hash();
+    };
+}
+
+// End Benchmark Suite
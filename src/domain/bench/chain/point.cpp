@@ -0,0 +1,25 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kd::bench;
+
+// Start Benchmark Suite: point benchmarks
+
+TEST_CASE("point  to data  many inputs", "[point benchmarks]") {
+    auto const& tx = many_inputs_transaction();
+
+    BENCHMARK("point::to_data") {
+        size_t size = 0;
+        for (auto const& input : tx.inputs()) {
+            size += input.previous_output().to_data().size();
+        }
+        return size;
+    };
+}
+
+// End Benchmark Suite
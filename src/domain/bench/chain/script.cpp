@@ -0,0 +1,38 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <vector>
+
+#include <bench_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kd::bench;
+
+// Start Benchmark Suite: script benchmarks
+
+// The operations are parsed on first use and cached, each run parses the
+// scripts of a fresh copy of the transaction.
+TEST_CASE("script  operations  many inputs", "[script benchmarks]") {
+    auto const data = many_inputs_transaction().to_data();
+
+    BENCHMARK_ADVANCED("script::operations")(Catch::Benchmark::Chronometer meter) {
+        std::vector<chain::transaction> txs;
+        txs.reserve(meter.runs());
+        for (int run = 0; run < meter.runs(); ++run) {
+            byte_reader reader(data);
+            txs.push_back(*chain::transaction::from_data(reader, true));
+        }
+
+        meter.measure([&txs](int run) {
+            size_t count = 0;
+            for (auto const& input : txs[run].inputs()) {
+                count += input.script().operations().size();
+            }
+            return count;
+        });
+    };
+}
+
+// End Benchmark Suite
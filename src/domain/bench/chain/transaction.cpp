@@ -0,0 +1,52 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kd::bench;
+
+// Start Benchmark Suite: transaction benchmarks
+
+TEST_CASE("transaction  to data  many inputs", "[transaction benchmarks]") {
+    auto const& tx = many_inputs_transaction();
+
+    BENCHMARK("transaction::to_data") {
+        return tx.to_data();
+    };
+}
+
+TEST_CASE("transaction  from data  many inputs", "[transaction benchmarks]") {
+    auto const data = many_inputs_transaction().to_data();
+
+    BENCHMARK("transaction::from_data") {
+        byte_reader reader(data);
+        return chain::transaction::from_data(reader, true);
+    };
+}
+
+TEST_CASE("transaction  hash  many inputs", "[transaction benchmarks]") {
+    auto const& tx = many_inputs_transaction();
+    tx.hash();
+
+    BENCHMARK("transaction::hash memoized") {
+        return tx.hash();
+    };
+
+    BENCHMARK("transaction hash cold") {
+        return chain::hash(tx);
+    };
+}
+
+TEST_CASE("transaction  to data  token outputs", "[transaction benchmarks]") {
+    generator random;
+    auto const tx = make_transaction(random, 2, 8, true);
+
+    BENCHMARK("transaction::to_data tokens") {
+        return tx.to_data();
+    };
+}
+
+// End Benchmark Suite
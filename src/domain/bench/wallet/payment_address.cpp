@@ -0,0 +1,47 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kd::bench;
+
+// Start Benchmark Suite: payment address benchmarks
+
+TEST_CASE("payment address  extract  large block", "[payment address benchmarks]") {
+    auto const& block = large_block();
+
+    // Parse the operations up front, as the indexers find them.
+    for (auto const& tx : block.transactions()) {
+        for (auto const& input : tx.inputs()) {
+            input.script().operations();
+        }
+        for (auto const& output : tx.outputs()) {
+            output.script().operations();
+        }
+    }
+
+    BENCHMARK("payment_address::extract outputs") {
+        size_t count = 0;
+        for (auto const& tx : block.transactions()) {
+            for (auto const& output : tx.outputs()) {
+                count += wallet::payment_address::extract(output.script()).size();
+            }
+        }
+        return count;
+    };
+
+    BENCHMARK("payment_address::extract inputs") {
+        size_t count = 0;
+        for (auto const& tx : block.transactions()) {
+            for (auto const& input : tx.inputs()) {
+                count += wallet::payment_address::extract(input.script()).size();
+            }
+        }
+        return count;
+    };
+}
+
+// End Benchmark Suite
@@ -29,6 +29,7 @@
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
 #include <kth/infrastructure/utility/data.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/reader.hpp>
 #include <kth/infrastructure/utility/thread.hpp>
 #include <kth/infrastructure/utility/writer.hpp>
@@ -53,13 +54,21 @@ public:
         asio::time_point end_deserialize;
         asio::time_point start_check;
         asio::time_point start_populate;
+        asio::time_point start_reorg_subset;
+        asio::time_point end_reorg_subset;
         asio::time_point start_accept;
         asio::time_point start_connect;
         asio::time_point start_notify;
         asio::time_point start_pop;
         asio::time_point start_push;
         asio::time_point end_push;
+
+        // Script verification, summed over the connect tasks.
+        asio::duration connect_queue{};         // dispatched but waiting for a thread
+        asio::duration connect_execution{};     // running
+
         float cache_efficiency;
+        float script_cache_efficiency;
     };
 
     // Constructors.
@@ -79,7 +88,7 @@ public:
         : block_basis(std::move(basis))
     {}
 
-    //Note(kth): cannot be defaulted because of the mutex data member.
+    //Note(kth): cannot be defaulted, the caches are not copied.
     block(block const& x);
     block(block&& x) noexcept;
     /// This class is move assignable and copy assignable.
@@ -89,7 +98,7 @@ public:
     // Deserialization.
     //-------------------------------------------------------------------------
     static
-    expect<block> from_data(byte_reader& reader, bool wire = true);
+    expect<block> from_data(byte_reader& reader, bool wire = true, bool arena = false);
 
     // Serialization.
     //-------------------------------------------------------------------------
@@ -153,14 +162,10 @@ public:
     mutable validation_t validation{};
 
 private:
-    mutable std::optional<size_t> total_inputs_;
-    mutable std::optional<size_t> base_size_;   // total size
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
+    // Computed once and then read without locking. Copies do not carry
+    // them, as transactions() allows changes that bypass invalidation.
+    once_cache<size_t> total_inputs_;
+    once_cache<size_t> base_size_;   // total size
 };
 
 } // namespace kth::domain::chain
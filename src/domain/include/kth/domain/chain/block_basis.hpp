@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -45,6 +46,17 @@ public:
     block_basis(chain::header const& header, transaction::list&& transactions);
     block_basis(chain::header const& header, transaction::list const& transactions);
 
+    // Special member functions.
+    //-------------------------------------------------------------------------
+
+    //Note(kth): cannot be defaulted, copies do not share the arena and the
+    // transactions must be released before the arena.
+    block_basis(block_basis const& x);
+    block_basis(block_basis&& x) noexcept = default;
+    block_basis& operator=(block_basis const& x);
+    block_basis& operator=(block_basis&& x) noexcept;
+    ~block_basis() = default;
+
     // Operators.
     //-------------------------------------------------------------------------
     bool operator==(block_basis const& x) const;
@@ -53,8 +65,10 @@ public:
     // Deserialization.
     //-------------------------------------------------------------------------
 
+    /// With arena the inputs, outputs and scripts are allocated from a
+    /// monotonic buffer owned by the block, released at once with it.
     static
-    expect<block_basis> from_data(byte_reader& reader, bool /*wire*/);
+    expect<block_basis> from_data(byte_reader& reader, bool /*wire*/, bool arena = false);
 
     [[nodiscard]]
     bool is_valid() const;
@@ -183,6 +197,8 @@ public:
     size_t non_coinbase_input_count() const;
 
 private:
+    // Declared first so it is destroyed after the transactions.
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> arena_;
     chain::header header_;
     transaction::list transactions_;
 };
@@ -5,7 +5,8 @@
 #ifndef KTH_DOMAIN_CHAIN_HASH_MEMOIZER_HPP
 #define KTH_DOMAIN_CHAIN_HASH_MEMOIZER_HPP
 
-#include <kth/infrastructure/utility/thread.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 
 namespace kth::domain::chain {
 
@@ -13,54 +14,18 @@ template <typename T>
 class hash_memoizer {
 public:
     hash_digest hash() const {
-#if ! defined(__EMSCRIPTEN__)
-        ///////////////////////////////////////////////////////////////////////////
-        // Critical Section
-        mutex_.lock_upgrade();
-
-        if ( ! hash_) {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            mutex_.unlock_upgrade_and_lock();
-            hash_ = std::make_shared<hash_digest>(bitcoin_hash(derived().to_data()));
-            mutex_.unlock_and_lock_upgrade();
-            //---------------------------------------------------------------------
-        }
-        auto const hash = *hash_;
-        mutex_.unlock_upgrade();
-        ///////////////////////////////////////////////////////////////////////////
-        return hash;
-#else
-        return bitcoin_hash(derived().to_data());
-#endif
+        return hash_.get([this] { return bitcoin_hash(derived().to_data()); });
     }
 
     void invalidate() const {
-#if ! defined(__EMSCRIPTEN__)
-        ///////////////////////////////////////////////////////////////////////////
-        // Critical Section
-        mutex_.lock_upgrade();
-
-        if (hash_) {
-            mutex_.unlock_upgrade_and_lock();
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_.reset();
-            //---------------------------------------------------------------------
-            mutex_.unlock_and_lock_upgrade();
-        }
-
-        mutex_.unlock_upgrade();
-        ///////////////////////////////////////////////////////////////////////////
-#endif
+        hash_.reset();
     }
 
 private:
     T& derived() {return *static_cast<T*>(this);}
     T const& derived() const {return *static_cast<T const*>(this);}
 
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-    mutable std::shared_ptr<hash_digest> hash_;
-#endif
+    once_cache<hash_digest> hash_;
 };
 
 } // namespace kth::domain::chain
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #if defined(__EMSCRIPTEN__)
@@ -24,6 +25,7 @@
 #include <kth/infrastructure/math/hash.hpp>
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/reader.hpp>
 #include <kth/infrastructure/utility/thread.hpp>
 #include <kth/infrastructure/utility/writer.hpp>
@@ -35,7 +37,7 @@ namespace kth::domain::chain {
 
 class KD_API input : public input_basis {
 public:
-    using list = std::vector<input>;
+    using list = std::pmr::vector<input>;
 
     // Constructors.
     //-------------------------------------------------------------------------
@@ -51,16 +53,16 @@ public:
     // Special member functions.
     //-------------------------------------------------------------------------
 
-    input(input const& x);
-    input(input&& x) noexcept;
-    input& operator=(input&& x) noexcept;
-    input& operator=(input const& x);
+    input(input const& x) = default;
+    input(input&& x) noexcept = default;
+    input& operator=(input&& x) noexcept = default;
+    input& operator=(input const& x) = default;
 
     // Deserialization.
     //-------------------------------------------------------------------------
 
     static
-    expect<input> from_data(byte_reader& reader, bool wire);
+    expect<input> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
@@ -79,16 +81,7 @@ protected:
     void invalidate_cache() const;
 
 private:
-    using addresses_ptr = std::shared_ptr<wallet::payment_address::list>;
-    addresses_ptr addresses_cache() const;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable std::shared_mutex mutex_;
-#endif
-
-    mutable addresses_ptr addresses_;
+    once_cache<wallet::payment_address::list> addresses_;
 };
 
 } // namespace kth::domain::chain
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include <kth/domain/wallet/payment_address.hpp>
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/reader.hpp>
 #include <kth/infrastructure/utility/thread.hpp>
 #include <kth/infrastructure/utility/writer.hpp>
@@ -27,7 +29,7 @@
 namespace kth::domain::chain {
 class KD_API output : public output_basis {
 public:
-    using list = std::vector<output>;
+    using list = std::pmr::vector<output>;
 
     /// This is a sentinel used in .value to indicate not found in store.
     /// This is a sentinel used in cache.value to indicate not populated.
@@ -57,17 +59,17 @@ public:
 
     using output_basis::output_basis;   //inherit constructors from output_basis
 
-    output(output const& x);
-    output(output&& x) noexcept;
-    output& operator=(output const& x);
-    output& operator=(output&& x) noexcept;
+    output(output const& x) = default;
+    output(output&& x) noexcept = default;
+    output& operator=(output const& x) = default;
+    output& operator=(output&& x) noexcept = default;
 
     // Deserialization.
     //-------------------------------------------------------------------------
 
 
     static
-    expect<output> from_data(byte_reader& reader, bool wire = true);
+    expect<output> from_data(byte_reader& reader, bool wire = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Serialization.
     //-------------------------------------------------------------------------
@@ -112,16 +114,7 @@ protected:
     void invalidate_cache() const;
 
 private:
-    using addresses_ptr = std::shared_ptr<wallet::payment_address::list>;
-    addresses_ptr addresses_cache() const;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
-
-    mutable addresses_ptr addresses_;
+    once_cache<wallet::payment_address::list> addresses_;
 };
 
 } // namespace kth::domain::chain
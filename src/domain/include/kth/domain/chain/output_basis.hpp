@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -61,7 +62,7 @@ struct KD_API output_basis {
     //-------------------------------------------------------------------------
 
     static
-    expect<output_basis> from_data(byte_reader& reader, bool /*wire*/ = true);
+    expect<output_basis> from_data(byte_reader& reader, bool /*wire*/ = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 
     [[nodiscard]]
@@ -28,6 +28,7 @@
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
 #include <kth/infrastructure/utility/data.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/reader.hpp>
 #include <kth/infrastructure/utility/thread.hpp>
 #include <kth/infrastructure/utility/writer.hpp>
@@ -87,10 +88,10 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<script> from_data(byte_reader& reader, bool wire);
+    expect<script> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     static
-    expect<script> from_data_with_size(byte_reader& reader, size_t size);
+    expect<script> from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list&& ops);
@@ -307,15 +308,8 @@ private:
     std::pair<hash_digest, size_t> generate_unversioned_signature_hash(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type);
 #endif // ! KTH_CURRENCY_BCH
 
-    // These are protected by mutex.
-    mutable bool cached_{false};
-    mutable operation::list operations_;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
+    // Computed once and then read without locking, copies do not carry it.
+    once_cache<operation::list> operations_;
 };
 
 } // namespace kth::domain::chain
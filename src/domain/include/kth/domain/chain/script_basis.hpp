@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <type_traits>
 
@@ -46,12 +47,16 @@ public:
     using script_version = infrastructure::machine::script_version;
 #endif // ! KTH_CURRENCY_BCH
 
+    /// Copies allocate from the default resource, moves keep the resource.
+    using bytes_type = std::pmr::vector<uint8_t>;
+
     // Constructors.
     //-------------------------------------------------------------------------
 
     script_basis() = default;
     script_basis(data_chunk const& encoded, bool prefix);
     script_basis(data_chunk&& encoded, bool prefix);
+    script_basis(byte_span encoded, std::pmr::memory_resource* resource);
 
     // Operators.
     //-------------------------------------------------------------------------
@@ -62,11 +67,12 @@ public:
     // Deserialization.
     //-------------------------------------------------------------------------
 
+    /// The bytes are allocated from resource, which must outlive the script.
     static
-    expect<script_basis> from_data(byte_reader& reader, bool prefix);
+    expect<script_basis> from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     static
-    expect<script_basis> from_data_with_size(byte_reader& reader, size_t size);
+    expect<script_basis> from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list const& ops);
@@ -90,7 +96,7 @@ public:
             sink.write_variable_little_endian(serialized_size(false));
         }
 
-        sink.write_bytes(bytes_);
+        sink.write_bytes(bytes_.data(), bytes_.size());
     }
 
     [[nodiscard]]
@@ -104,7 +110,7 @@ public:
     size_t serialized_size(bool prefix) const;
 
     [[nodiscard]]
-    data_chunk const& bytes() const;
+    byte_span bytes() const;
     // operation::list const& operations() const;
 
     // Utilities (static).
@@ -224,7 +230,7 @@ public:
     size_t serialized_size(operation::list const& ops);
 protected:
     static
-    data_chunk operations_to_data(operation::list const& ops);
+    bytes_type operations_to_data(operation::list const& ops);
 
     // static
     // hash_digest generate_unversioned_signature_hash(transaction const& tx, uint32_t input_index, script_basis const& script_code, uint8_t sighash_type);
@@ -239,7 +245,7 @@ protected:
         uint32_t active_forks
     );
 
-    data_chunk bytes_;
+    bytes_type bytes_;
     bool valid_{false};
 };
 
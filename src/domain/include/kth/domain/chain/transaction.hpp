@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -30,6 +31,7 @@
 #include <kth/infrastructure/math/hash.hpp>
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/reader.hpp>
 #include <kth/infrastructure/utility/writer.hpp>
 
@@ -93,7 +95,7 @@ public:
     //-----------------------------------------------------------------------------
 
 
-    //Note(kth): cannot be defaulted because of the mutex data member.
+    //Note(kth): cannot be defaulted, the caches are not copied.
     transaction(transaction const& x);
     transaction(transaction&& x) noexcept;
     transaction& operator=(transaction const& x);
@@ -103,7 +105,7 @@ public:
     //-----------------------------------------------------------------------------
 
     static
-    expect<transaction> from_data(byte_reader& reader, bool wire);
+    expect<transaction> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Serialization.
     //-----------------------------------------------------------------------------
@@ -199,35 +201,24 @@ protected:
     bool all_inputs_final() const;
 
 private:
+    void reset_caches() const;
 
     // TODO(kth): (refactor to transaction_result)
     // this 3 variables should be stored in transaction_unconfired database when the store
     // function is called. This values will be in the transaction_result object before
     // creating the transaction object
 
-    // These share a mutex as they are not expected to contend.
-    mutable hash_ptr hash_;
-    mutable hash_ptr outputs_hash_;
-    mutable hash_ptr inpoints_hash_;
-    mutable hash_ptr sequences_hash_;
-    mutable hash_ptr utxos_hash_;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex hash_mutex_;
-#else
-    mutable shared_mutex hash_mutex_;
-#endif
+    // Computed once and then read without locking. Copies do not carry
+    // them, as inputs() and outputs() allow changes that bypass invalidation.
+    once_cache<hash_digest> hash_;
+    once_cache<hash_digest> outputs_hash_;
+    once_cache<hash_digest> inpoints_hash_;
+    once_cache<hash_digest> sequences_hash_;
+    once_cache<hash_digest> utxos_hash_;
 
-    // These share a mutex as they are not expected to contend.
-    mutable std::optional<uint64_t> total_input_value_;
-    mutable std::optional<uint64_t> total_output_value_;
+    once_cache<uint64_t> total_input_value_;
+    once_cache<uint64_t> total_output_value_;
     mutable std::optional<bool> segregated_;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
 };
 
 
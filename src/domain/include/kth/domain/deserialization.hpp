@@ -10,6 +10,7 @@
 // #include <expected>
 
 // #include <memory>
+#include <memory_resource>
 // #include <string>
 // #include <vector>
 
@@ -99,6 +100,34 @@ expect<std::vector<T>> read_collection(byte_reader& reader, Args&&... args) {
     return list;
 }
 
+// Reads into a list allocated from resource, the elements are read with
+// resource as the last argument.
+template <typename T, typename ... Args>
+    requires has_from_data<T, Args..., std::pmr::memory_resource*>
+expect<std::pmr::vector<T>> read_collection(std::pmr::memory_resource* resource, byte_reader& reader, Args&&... args) {
+    auto const count_exp = reader.read_size_little_endian();
+    if ( ! count_exp) {
+        return make_unexpected(count_exp.error());
+    }
+    auto const count = *count_exp;
+    if (count > static_absolute_max_block_size()) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    std::pmr::vector<T> list(resource);
+    list.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto res = T::from_data(reader, args..., resource);
+        if ( ! res) {
+            return make_unexpected(res.error());
+        }
+        list.emplace_back(std::move(*res));
+    }
+
+    return list;
+}
+
 
 } // namespace kth
 
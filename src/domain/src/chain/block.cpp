@@ -195,12 +195,16 @@ block::block(block&& x) noexcept
 
 block& block::operator=(block const& x) {
     block_basis::operator=(x);
+    total_inputs_.reset();
+    base_size_.reset();
     validation = x.validation;
     return *this;
 }
 
 block& block::operator=(block&& x) noexcept {
     block_basis::operator=(std::move(static_cast<block_basis&&>(x)));
+    total_inputs_.reset();
+    base_size_.reset();
     validation = std::move(x.validation);
     return *this;
 }
@@ -209,9 +213,9 @@ block& block::operator=(block&& x) noexcept {
 //-----------------------------------------------------------------------------
 
 
-expect<block> block::from_data(byte_reader& reader, bool wire) {
+expect<block> block::from_data(byte_reader& reader, bool wire, bool arena) {
     auto const start_deserialize = asio::steady_clock::now();
-    auto basis = block_basis::from_data(reader, wire);
+    auto basis = block_basis::from_data(reader, wire, arena);
     auto const end_deserialize = asio::steady_clock::now();
     if ( ! basis) {
         return make_unexpected(basis.error());
@@ -234,57 +238,21 @@ data_chunk block::to_data() const {
 
 // Full block serialization is always canonical encoding.
 size_t block::serialized_size() const {
-    size_t value;
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (base_size_) {
-        value = base_size_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (base_size_) {
-            return base_size_.value();
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-#endif
-
-    value = chain::serialized_size(*this);
-    base_size_ = value;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-#endif
-
-    return value;
+    return base_size_.get([this] { return chain::serialized_size(*this); });
 }
 
 // TODO(legacy): see set_header comments.
 void block::set_transactions(transaction::list const& value) {
     block_basis::set_transactions(value);
-    total_inputs_ = std::nullopt;
-    base_size_ = std::nullopt;
+    total_inputs_.reset();
+    base_size_.reset();
 }
 
 // TODO(legacy): see set_header comments.
 void block::set_transactions(transaction::list&& value) {
     block_basis::set_transactions(std::move(value));
-    total_inputs_ = std::nullopt;
-    base_size_ = std::nullopt;
+    total_inputs_.reset();
+    base_size_.reset();
 }
 
 // Utilities.
@@ -383,44 +351,13 @@ size_t block::signature_operations() const {
     return block_basis::signature_operations(bip16, bip141);
 }
 
+// Only the count with the coinbase is cached, the other one is derived.
 size_t block::total_inputs(bool with_coinbase) const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_inputs_ != std::nullopt) {
-        auto const value = total_inputs_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
+    auto const total = total_inputs_.get([&] { return chain::total_inputs(*this, true); });
+    if (with_coinbase || transactions().empty()) {
+        return total;
     }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    auto const value = chain::total_inputs(*this, with_coinbase);
-    total_inputs_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-
-        if (total_inputs_) {
-            return total_inputs_.value();
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-    if ( ! total_inputs_) {
-        total_inputs_ = chain::total_inputs(*this, with_coinbase);
-    }
-
-    auto value = total_inputs_.value();
-#endif
-
-    return value;
+    return total - transactions().front().inputs().size();
 }
 
 // Validation.
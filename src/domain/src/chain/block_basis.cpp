@@ -61,6 +61,33 @@ block_basis::block_basis(chain::header const& header, transaction::list&& transa
     , transactions_(std::move(transactions))
 {}
 
+// The copied transactions allocate from the default resource.
+block_basis::block_basis(block_basis const& x)
+    : header_(x.header_)
+    , transactions_(x.transactions_)
+{}
+
+block_basis& block_basis::operator=(block_basis const& x) {
+    if (this == &x) {
+        return *this;
+    }
+
+    // Assigning over the current transactions would allocate from the arena.
+    transactions_.clear();
+    transactions_ = x.transactions_;
+    arena_.reset();
+    header_ = x.header_;
+    return *this;
+}
+
+block_basis& block_basis::operator=(block_basis&& x) noexcept {
+    // The current transactions are destroyed before their arena.
+    transactions_ = std::move(x.transactions_);
+    arena_ = std::move(x.arena_);
+    header_ = std::move(x.header_);
+    return *this;
+}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
@@ -92,16 +119,31 @@ bool block_basis::is_valid() const {
 
 
 // static
-expect<block_basis> block_basis::from_data(byte_reader& reader, bool wire) {
+expect<block_basis> block_basis::from_data(byte_reader& reader, bool wire, bool arena) {
     auto const hdr = chain::header::from_data(reader, wire);
     if ( ! hdr) {
         return make_unexpected(hdr.error());
     }
-    auto txs = read_collection<chain::transaction>(reader, wire);
+
+    if ( ! arena) {
+        auto txs = read_collection<chain::transaction>(reader, wire);
+        if ( ! txs) {
+            return make_unexpected(txs.error());
+        }
+        return block_basis {*hdr, std::move(*txs)};
+    }
+
+    // The parsed inputs, outputs and scripts take nearly four times the
+    // payload, so a single buffer is usually enough.
+    auto const initial_size = std::max(4 * reader.remaining_size(), size_t{1024});
+    auto resource = std::make_shared<std::pmr::monotonic_buffer_resource>(initial_size);
+    auto txs = read_collection<chain::transaction>(reader, wire, resource.get());
     if ( ! txs) {
         return make_unexpected(txs.error());
     }
-    return block_basis {*hdr, std::move(*txs)};
+    block_basis result {*hdr, std::move(*txs)};
+    result.arena_ = std::move(resource);
+    return result;
 }
 
 // Serialization.
@@ -246,32 +288,7 @@ bool block_basis::is_distinct_transaction_set() const {
 }
 
 hash_digest block_basis::generate_merkle_root() const {
-    if (transactions_.empty()) {
-        return null_hash;
-    }
-
-    hash_list update;
-    auto merkle = to_hashes();
-
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
-    while (merkle.size() > 1) {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0) {
-            merkle.push_back(merkle.back());
-        }
-
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2) {
-            update.push_back(bitcoin_hash(build_chunk({it[0], it[1]})));
-        }
-
-        std::swap(merkle, update);
-        update.clear();
-    }
-
-    // There is now only one item in the list.
-    return merkle.front();
+    return merkle_root(to_hashes());
 }
 
 size_t block_basis::non_coinbase_input_count() const {
@@ -314,8 +331,11 @@ bool block_basis::is_forward_reference() const {
 bool block_basis::is_canonical_ordered() const {
     //precondition: transactions_.size() > 1
 
+    // hash() returns by value, both iterators must come from the same copy.
     auto const hash_cmp = [](transaction const& a, transaction const& b){
-        return std::lexicographical_compare(a.hash().rbegin(), a.hash().rend(), b.hash().rbegin(), b.hash().rend());
+        auto const hash_a = a.hash();
+        auto const hash_b = b.hash();
+        return std::lexicographical_compare(hash_a.rbegin(), hash_a.rend(), hash_b.rbegin(), hash_b.rend());
     };
 
     // Skip the coinbase
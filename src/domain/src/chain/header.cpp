@@ -22,11 +22,13 @@ namespace kth::domain::chain {
 
 header::header(header const& x)
     : header_basis(x)
+    , hash_memoizer<header>(x)
     , validation(x.validation)
 {}
 
 header& header::operator=(header const& x) {
     header_basis::operator=(x);
+    hash_memoizer<header>::operator=(x);
     validation = x.validation;
     return *this;
 }
@@ -31,41 +31,6 @@ input::input(input_basis&& x) noexcept
     : input_basis(std::move(x))
 {}
 
-// Private cache access for copy/move construction.
-input::addresses_ptr input::addresses_cache() const {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    shared_lock lock(mutex_);
-
-    return addresses_;
-    ///////////////////////////////////////////////////////////////////////////
-}
-
-input::input(input const& x)
-    : input_basis(x)
-    , addresses_(x.addresses_cache())
-{}
-
-input::input(input&& x) noexcept
-    : input_basis(std::move(x))
-    , addresses_(x.addresses_cache())
-{}
-
-// Operators.
-//-----------------------------------------------------------------------------
-
-input& input::operator=(input const& x) {
-    input_basis::operator=(x);
-    addresses_ = x.addresses_cache();
-    return *this;
-}
-
-input& input::operator=(input&& x) noexcept {
-    input_basis::operator=(std::move(static_cast<input_basis&&>(x)));
-    addresses_ = x.addresses_cache();
-    return *this;
-}
-
 void input::reset() {
     input_basis::reset();
     addresses_.reset();
@@ -75,8 +40,8 @@ void input::reset() {
 //-----------------------------------------------------------------------------
 
 // static
-expect<input> input::from_data(byte_reader& reader, bool wire) {
-    auto basis = input_basis::from_data(reader, wire);
+expect<input> input::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
+    auto basis = input_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -98,33 +63,7 @@ void input::set_script(chain::script&& value) {
 
 // protected
 void input::invalidate_cache() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_) {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if ( ! addresses_) {
-            return;
-        }
-    }
-
-    std::unique_lock lock(mutex_);
     addresses_.reset();
-#endif
 }
 
 payment_address input::address() const {
@@ -133,42 +72,8 @@ payment_address input::address() const {
 }
 
 payment_address::list input::addresses() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if ( ! addresses_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-
-        // TODO(legacy): expand to include segregated witness address extraction.
-        addresses_ = std::make_shared<payment_address::list>(payment_address::extract_input(script()));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-
-        if (addresses_) {
-            return *addresses_;
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-    if ( ! addresses_) {
-        addresses_ = std::make_shared<payment_address::list>(payment_address::extract_input(script()));
-    }
-
-    auto addresses = *addresses_;
-#endif
-
-    return addresses;
+    // TODO(legacy): expand to include segregated witness address extraction.
+    return addresses_.get([this] { return payment_address::extract_input(script()); });
 }
 
 } // namespace kth::domain::chain
@@ -53,12 +53,12 @@ bool input_basis::is_valid() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<input_basis> input_basis::from_data(byte_reader& reader, bool wire) {
+expect<input_basis> input_basis::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
     auto point = output_point::from_data(reader, wire);
     if ( ! point) {
         return make_unexpected(point.error());
     }
-    auto script = script::from_data(reader, true);
+    auto script = script::from_data(reader, true, resource);
     if ( ! script) {
         return make_unexpected(script.error());
     }
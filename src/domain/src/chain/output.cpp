@@ -36,47 +36,11 @@ output::output(output_basis&& x) noexcept
     : output_basis(std::move(x))
 {}
 
-output::output(output const& x)
-    : output_basis(x)
-    , addresses_(x.addresses_cache())
-    , validation(x.validation)
-{}
-
-output::output(output&& x) noexcept
-    : output_basis(std::move(x))
-    , addresses_(x.addresses_cache())
-    , validation(x.validation)
-{}
-
-output& output::operator=(output const& x) {
-    output_basis::operator=(x);
-    addresses_ = x.addresses_cache();
-    validation = x.validation;
-    return *this;
-}
-
-output& output::operator=(output&& x) noexcept {
-    output_basis::operator=(std::move(static_cast<output_basis&&>(x)));
-    addresses_ = x.addresses_cache();
-    validation = x.validation;
-    return *this;
-}
-
-// Private cache access for copy/move construction.
-output::addresses_ptr output::addresses_cache() const {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    shared_lock lock(mutex_);
-
-    return addresses_;
-    ///////////////////////////////////////////////////////////////////////////
-}
-
 // Deserialization.
 //-----------------------------------------------------------------------------
 
 // static
-expect<output> output::from_data(byte_reader& reader, bool wire) {
+expect<output> output::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
     uint32_t spender_height = validation::not_spent;
     if ( ! wire) {
         auto const height = reader.read_little_endian<uint32_t>();
@@ -86,7 +50,7 @@ expect<output> output::from_data(byte_reader& reader, bool wire) {
         spender_height = *height;
     }
 
-    auto basis = output_basis::from_data(reader, wire);
+    auto basis = output_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -138,32 +102,7 @@ void output::set_script(chain::script&& value) {
 
 // protected
 void output::invalidate_cache() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_) {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if ( ! addresses_) {
-            return;
-        }
-    }
-
-    std::unique_lock lock(mutex_);
     addresses_.reset();
-#endif
 }
 
 payment_address output::address(bool testnet /*= false*/) const {
@@ -179,37 +118,7 @@ payment_address output::address(uint8_t p2kh_version, uint8_t p2sh_version) cons
 }
 
 payment_address::list output::addresses(uint8_t p2kh_version, uint8_t p2sh_version) const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if ( ! addresses_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        addresses_ = std::make_shared<payment_address::list>(payment_address::extract_output(script(), p2kh_version, p2sh_version));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (addresses_) {
-            return *addresses_;
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-    if ( ! addresses_) {
-        addresses_ = std::make_shared<payment_address::list>(payment_address::extract_output(script(), p2kh_version, p2sh_version));
-    }
-    auto addresses = *addresses_;
-#endif
-    return addresses;
+    return addresses_.get([&] { return payment_address::extract_output(script(), p2kh_version, p2sh_version); });
 }
 
 } // namespace kth::domain::chain
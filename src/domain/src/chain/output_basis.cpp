@@ -49,7 +49,7 @@ bool output_basis::is_valid() const {
 // Deserialization.
 //-----------------------------------------------------------------------------
 
-expect<output_basis> output_basis::from_data(byte_reader& reader, bool /*wire*/) {
+expect<output_basis> output_basis::from_data(byte_reader& reader, bool /*wire*/, std::pmr::memory_resource* resource) {
     auto const value = reader.read_little_endian<uint64_t>();
     if ( ! value) {
         return make_unexpected(value.error());
@@ -80,7 +80,7 @@ expect<output_basis> output_basis::from_data(byte_reader& reader, bool /*wire*/)
         script_size -= 1; // prefix byte
     }
 
-    auto script = script::from_data_with_size(reader, script_size);
+    auto script = script::from_data_with_size(reader, script_size, resource);
     if ( ! script) {
         return make_unexpected(script.error());
     }
@@ -105,8 +105,8 @@ script& script::operator=(script const& x) {
 //-----------------------------------------------------------------------------
 
 // static
-expect<script> script::from_data(byte_reader& reader, bool prefix) {
-    auto basis = script_basis::from_data(reader, prefix);
+expect<script> script::from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource) {
+    auto basis = script_basis::from_data(reader, prefix, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -114,8 +114,8 @@ expect<script> script::from_data(byte_reader& reader, bool prefix) {
 }
 
 // static
-expect<script> script::from_data_with_size(byte_reader& reader, size_t size) {
-    auto basis = script_basis::from_data_with_size(reader, size);
+expect<script> script::from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource) {
+    auto basis = script_basis::from_data_with_size(reader, size, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -145,15 +145,13 @@ bool script::from_string(std::string const& mnemonic) {
 // Concurrent read/write is not supported, so no critical section.
 void script::from_operations(operation::list&& ops) {
     script_basis::from_operations(ops);
-    operations_ = std::move(ops);
-    cached_ = true;
+    operations_.set(std::move(ops));
 }
 
 // Concurrent read/write is not supported, so no critical section.
 void script::from_operations(operation::list const& ops) {
     script_basis::from_operations(ops);
-    operations_ = ops;
-    cached_ = true;
+    operations_.set(ops);
 }
 
 
@@ -166,15 +164,14 @@ void script::from_operations(operation::list const& ops) {
 // Concurrent read/write is not supported, so no critical section.
 void script::reset() {
     script_basis::reset();
-    cached_ = false;
-    operations_.clear();
-    operations_.shrink_to_fit();
+    operations_.reset();
 }
 
 bool script::is_valid_operations() const {
     // Script validity is independent of individual operation validity.
     // There is a trailing invalid/default op if a push op had a size mismatch.
-    return operations().empty() || operations_.back().is_valid();
+    auto const& ops = operations();
+    return ops.empty() || ops.back().is_valid();
 }
 
 // Serialization.
@@ -287,39 +284,7 @@ operation::iterator script::end() const {
 
 // protected
 operation::list const& script::operations() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (cached_) {
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return operations_;
-    }
-
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    mutex_.unlock_upgrade_and_lock();
-
-    operations_ = chain::operations(*this);
-    cached_ = true;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (cached_) {
-            return operations_;
-        }
-    }
-    std::unique_lock lock(mutex_);
-    if ( ! cached_) {
-        operations_ = chain::operations(*this);
-        cached_ = true;
-    }
-#endif
-    return operations_;
+    return operations_.get([this] { return chain::operations(*this); });
 }
 
 operation script::first_operation() const {
@@ -971,28 +936,28 @@ script_pattern script::pattern() const {
 // Output patterns are mutually and input unambiguous.
 // The bip141 coinbase pattern is not tested here, must test independently.
 script_pattern script::output_pattern() const {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_public_key_hash_pattern(operations())) {
+    auto const& ops = operations();
+    if (is_pay_public_key_hash_pattern(ops)) {
         return script_pattern::pay_public_key_hash;
     }
 
-    if (is_pay_script_hash_pattern(operations_)) {
+    if (is_pay_script_hash_pattern(ops)) {
         return script_pattern::pay_script_hash;
     }
 
-    if (is_pay_script_hash_32_pattern(operations_)) {
+    if (is_pay_script_hash_32_pattern(ops)) {
         return script_pattern::pay_script_hash_32;
     }
 
-    if (is_null_data_pattern(operations_)) {
+    if (is_null_data_pattern(ops)) {
         return script_pattern::null_data;
     }
 
-    if (is_pay_public_key_pattern(operations_)) {
+    if (is_pay_public_key_pattern(ops)) {
         return script_pattern::pay_public_key;
     }
 
-    if (is_pay_multisig_pattern(operations_)) {
+    if (is_pay_multisig_pattern(ops)) {
         return script_pattern::pay_multisig;
     }
 
@@ -1003,27 +968,27 @@ script_pattern script::output_pattern() const {
 // The bip34 coinbase pattern is not tested here, must test independently.
 script_pattern script::input_pattern() const {
     // std::cout << "input_pattern() - 1" << std::endl;
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_sign_public_key_hash_pattern(operations())) {
+    auto const& ops = operations();
+    if (is_sign_public_key_hash_pattern(ops)) {
         // std::cout << "input_pattern() - 2" << std::endl;
         return script_pattern::sign_public_key_hash;
     }
 
     // std::cout << "input_pattern() - 3" << std::endl;
     // This must follow is_sign_public_key_hash_pattern for ambiguity comment to hold.
-    if (is_sign_script_hash_pattern(operations_)) {
+    if (is_sign_script_hash_pattern(ops)) {
         // std::cout << "input_pattern() - 4" << std::endl;
         return script_pattern::sign_script_hash;
     }
 
     // std::cout << "input_pattern() - 5" << std::endl;
-    if (is_sign_public_key_pattern(operations_)) {
+    if (is_sign_public_key_pattern(ops)) {
         // std::cout << "input_pattern() - 6" << std::endl;
         return script_pattern::sign_public_key;
     }
 
     // std::cout << "input_pattern() - 7" << std::endl;
-    if (is_sign_multisig_pattern(operations_)) {
+    if (is_sign_multisig_pattern(ops)) {
         // std::cout << "input_pattern() - 8" << std::endl;
         return script_pattern::sign_multisig;
     }
@@ -1089,8 +1054,8 @@ size_t script::sigops(bool accurate) const {
 // circumstance. This allows for exclusion of the output as unspendable.
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const {
-    // The first operations access must be method-based to guarantee the cache.
-    return ( ! operations().empty() && operations_[0].code() == opcode::return_) || serialized_size(false) > max_script_size;
+    auto const& ops = operations();
+    return ( ! ops.empty() && ops[0].code() == opcode::return_) || serialized_size(false) > max_script_size;
 }
 
 // Validation.
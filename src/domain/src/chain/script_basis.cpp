@@ -65,7 +65,7 @@ script_basis::script_basis(data_chunk&& encoded, bool prefix) {
     }
 
     // This is an optimization that avoids streaming the encoded bytes.
-    bytes_ = std::move(encoded);
+    bytes_.assign(encoded.begin(), encoded.end());
     valid_ = true;
 }
 
@@ -79,6 +79,11 @@ script_basis::script_basis(data_chunk const& encoded, bool prefix) {
     *this = std::move(obj.value());
 }
 
+script_basis::script_basis(byte_span encoded, std::pmr::memory_resource* resource)
+    : bytes_(encoded.begin(), encoded.end(), resource)
+    , valid_(true)
+{}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
@@ -121,8 +126,8 @@ void script_basis::from_operations(operation::list const& ops) {
 }
 
 // private/static
-data_chunk script_basis::operations_to_data(operation::list const& ops) {
-    data_chunk out;
+script_basis::bytes_type script_basis::operations_to_data(operation::list const& ops) {
+    bytes_type out;
     auto const size = serialized_size(ops);
     out.reserve(size);
     auto const concatenate = [&out](operation const& op) {
@@ -163,13 +168,13 @@ bool script_basis::is_valid() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix) {
+expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource) {
     if ( ! prefix) {
         auto const bytes = reader.read_remaining_bytes();
         if ( ! bytes) {
             return make_unexpected(bytes.error());
         }
-        return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+        return script_basis {*bytes, resource};
     }
 
     auto const size = reader.read_size_little_endian();
@@ -186,11 +191,11 @@ expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix) {
     if ( ! bytes) {
         return make_unexpected(bytes.error());
     }
-    return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+    return script_basis {*bytes, resource};
 }
 
 // static
-expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size_t size) {
+expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource) {
     // The max_script_size constant limits evaluation, but not all scripts evaluate, so use max_block_size to guard memory allocation here.
     if (size > static_absolute_max_block_size()) {
         return make_unexpected(error::script_invalid_size);
@@ -200,7 +205,7 @@ expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size
     if ( ! bytes) {
         return make_unexpected(bytes.error());
     }
-    return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+    return script_basis {*bytes, resource};
 }
 
 // Serialization.
@@ -248,7 +253,7 @@ size_t script_basis::serialized_size(bool prefix) const {
     return size;
 }
 
-data_chunk const& script_basis::bytes() const {
+byte_span script_basis::bytes() const {
     return bytes_;
 }
 
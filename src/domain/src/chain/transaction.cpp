@@ -73,7 +73,7 @@ transaction::transaction(transaction const& x, hash_digest const& hash)
     : transaction_basis(x)
     , validation(x.validation)
 {
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     // validation = x.validation;
 }
 
@@ -81,7 +81,7 @@ transaction::transaction(transaction&& x, hash_digest const& hash)
     : transaction_basis(std::move(x))
     , validation(std::move(x.validation))
 {
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     // validation = std::move(x.validation);
 }
 
@@ -106,12 +106,14 @@ transaction::transaction(transaction&& x) noexcept
 
 transaction& transaction::operator=(transaction const& x) {
     transaction_basis::operator=(x);
+    reset_caches();
     validation = x.validation;
     return *this;
 }
 
 transaction& transaction::operator=(transaction&& x) noexcept {
     transaction_basis::operator=(std::move(static_cast<transaction_basis&&>(x)));
+    reset_caches();
     validation = std::move(x.validation);
     return *this;
 }
@@ -119,21 +121,15 @@ transaction& transaction::operator=(transaction&& x) noexcept {
 // protected
 void transaction::reset() {
     transaction_basis::reset();
-    invalidate_cache();
-    outputs_hash_.reset();
-    inpoints_hash_.reset();
-    sequences_hash_.reset();
-    segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
-    total_output_value_ = std::nullopt;
+    reset_caches();
 }
 
 // Deserialization.
 //-----------------------------------------------------------------------------
 
 // static
-expect<transaction> transaction::from_data(byte_reader& reader, bool wire) {
-    auto basis = transaction_basis::from_data(reader, wire);
+expect<transaction> transaction::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
+    auto basis = transaction_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -194,27 +190,27 @@ void transaction::set_inputs(input::list const& value) {
     inpoints_hash_.reset();
     sequences_hash_.reset();
     segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
+    total_input_value_.reset();
 }
 
 void transaction::set_inputs(input::list&& value) {
     transaction_basis::set_inputs(std::move(value));
     invalidate_cache();
     segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
+    total_input_value_.reset();
 }
 
 void transaction::set_outputs(output::list const& value) {
     transaction_basis::set_outputs(value);
     invalidate_cache();
     outputs_hash_.reset();
-    total_output_value_ = std::nullopt;
+    total_output_value_.reset();
 }
 
 void transaction::set_outputs(output::list&& value) {
     transaction_basis::set_outputs(std::move(value));
     invalidate_cache();
-    total_output_value_ = std::nullopt;
+    total_output_value_.reset();
 }
 
 // Cache.
@@ -222,210 +218,46 @@ void transaction::set_outputs(output::list&& value) {
 
 // protected
 void transaction::invalidate_cache() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (hash_) {
-        hash_mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        //---------------------------------------------------------------------
-        hash_mutex_.unlock_and_lock_upgrade();
-    }
-
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if ( ! hash_) {
-            return;
-        }
-    }
+    hash_.reset();
+}
 
-    std::unique_lock lock(hash_mutex_);
+// private
+void transaction::reset_caches() const {
     hash_.reset();
-#endif
+    outputs_hash_.reset();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    utxos_hash_.reset();
+    segregated_ = std::nullopt;
+    total_input_value_.reset();
+    total_output_value_.reset();
 }
 
 hash_digest transaction::hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade(); //TODO(fernando): use RAII
-
-    if ( ! hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock(); //TODO(fernando): use RAII
-        hash_ = std::make_shared<hash_digest>(chain::hash(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *hash_;
-    hash_mutex_.unlock_upgrade();
-///////////////////////////////////////////////////////////////////////////
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (hash_) {
-            return *hash_;
-        }
-    }
-
-    std::unique_lock lock(hash_mutex_);
-    if ( ! hash_) {
-        hash_ = std::make_shared<hash_digest>(chain::hash(*this));
-    }
-    return *hash_;
-#endif
+    return hash_.get([this] { return chain::hash(*this); });
 }
 
 hash_digest transaction::outputs_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! outputs_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        outputs_hash_ = std::make_shared<hash_digest>(to_outputs(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *outputs_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (outputs_hash_) {
-            return *outputs_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! outputs_hash_) {
-        outputs_hash_ = std::make_shared<hash_digest>(to_outputs(*this));
-    }
-    return *outputs_hash_;
-
-#endif
+    return outputs_hash_.get([this] { return to_outputs(*this); });
 }
 
 hash_digest transaction::inpoints_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! inpoints_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        inpoints_hash_ = std::make_shared<hash_digest>(to_inpoints(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *inpoints_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (inpoints_hash_) {
-            return *inpoints_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! inpoints_hash_) {
-        inpoints_hash_ = std::make_shared<hash_digest>(to_inpoints(*this));
-    }
-    return *inpoints_hash_;
-#endif
+    return inpoints_hash_.get([this] { return to_inpoints(*this); });
 }
 
 hash_digest transaction::sequences_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! sequences_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        sequences_hash_ = std::make_shared<hash_digest>(to_sequences(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *sequences_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (sequences_hash_) {
-            return *sequences_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! sequences_hash_) {
-        sequences_hash_ = std::make_shared<hash_digest>(to_sequences(*this));
-    }
-    return *sequences_hash_;
-#endif
+    return sequences_hash_.get([this] { return to_sequences(*this); });
 }
 
 hash_digest transaction::utxos_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! utxos_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        utxos_hash_ = std::make_shared<hash_digest>(to_utxos(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *utxos_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (utxos_hash_) {
-            return *utxos_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! utxos_hash_) {
-        utxos_hash_ = std::make_shared<hash_digest>(to_utxos(*this));
-    }
-    return *utxos_hash_;
-#endif
+    return utxos_hash_.get([this] { return to_utxos(*this); });
 }
 
 // Utilities.
 //-----------------------------------------------------------------------------
 
 void transaction::recompute_hash() {
-    hash_ = nullptr;
+    hash_.reset();
     hash();
 }
 
@@ -434,81 +266,12 @@ void transaction::recompute_hash() {
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_input_value() const {
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_input_value_ != std::nullopt) {
-        auto const value = total_input_value_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    auto const value = chain::total_input_value(*this);
-    total_input_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (total_input_value_ != std::nullopt) {
-            return total_input_value_.value();
-        }
-    }
-    std::unique_lock lock(mutex_);
-    if (total_input_value_ == std::nullopt) {
-        total_input_value_ = chain::total_input_value(*this);
-    }
-    return total_input_value_.value();
-#endif
+    return total_input_value_.get([this] { return chain::total_input_value(*this); });
 }
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_output_value() const {
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_output_value_ != std::nullopt) {
-        auto const value = total_output_value_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    auto const value = chain::total_output_value(*this);
-    total_output_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (total_output_value_ != std::nullopt) {
-            return total_output_value_.value();
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-    if (total_output_value_ == std::nullopt) {
-        total_output_value_ = chain::total_output_value(*this);
-    }
-    return total_output_value_.value();
-#endif
+    return total_output_value_.get([this] { return chain::total_output_value(*this); });
 }
 
 uint64_t transaction::fees() const {
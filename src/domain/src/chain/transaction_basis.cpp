@@ -85,18 +85,18 @@ bool transaction_basis::is_valid() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool wire /*= true*/) {
+expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool wire /*= true*/, std::pmr::memory_resource* resource) {
     if (wire) {
         // Wire (satoshi protocol) deserialization.
         auto const version = reader.read_little_endian<uint32_t>();
         if ( ! version) {
             return make_unexpected(version.error());
         }
-        auto inputs = read_collection<chain::input>(reader, wire);
+        auto inputs = read_collection<chain::input>(resource, reader, wire);
         if ( ! inputs) {
             return make_unexpected(inputs.error());
         }
-        auto outputs = read_collection<chain::output>(reader, wire);
+        auto outputs = read_collection<chain::output>(resource, reader, wire);
         if ( ! outputs) {
             return make_unexpected(outputs.error());
         }
@@ -113,11 +113,11 @@ expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool
     }
 
     // Database (outputs forward) serialization.
-    auto outputs = read_collection<chain::output>(reader, wire);
+    auto outputs = read_collection<chain::output>(resource, reader, wire);
     if ( ! outputs) {
         return make_unexpected(outputs.error());
     }
-    auto inputs = read_collection<chain::input>(reader, wire);
+    auto inputs = read_collection<chain::input>(resource, reader, wire);
     if ( ! inputs) {
         return make_unexpected(inputs.error());
     }
@@ -75,7 +75,8 @@ bool block::operator!=(block const& x) const {
 
 // static
 expect<block> block::from_data(byte_reader& reader, uint32_t /*version*/) {
-    auto chain_block = chain::block::from_data(reader);
+    // Received blocks are shared read only, so they can own an arena.
+    auto chain_block = chain::block::from_data(reader, true, true);
     if ( ! chain_block) {
         return make_unexpected(chain_block.error());
     }
@@ -224,6 +224,19 @@ TEST_CASE("block  from data  insufficient transaction bytes  failure", "[block s
     REQUIRE( ! result);
 }
 
+TEST_CASE("block  from data  arena  insufficient transaction bytes  failure", "[block serialization]") {
+    data_chunk const data = to_chunk(base16_literal(
+        "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a00"
+        "000000005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4"
+        "dc118244d67fb74c9d8e2f1bea5ee82a03010000000100000000000000000000"
+        "00000000000000000000000000000000000000000000ffffffff07049d8e2f1b"
+        "0114ffffffff0100f2052a0100000043410437b36a7221bc977dce712728a954"));
+
+    byte_reader reader(data);
+    auto const result = chain::block::from_data(reader, true, true);
+    REQUIRE( ! result);
+}
+
 TEST_CASE("block genesis mainnet valid structure", "[block serialization]") {
     auto const genesis = chain::block::genesis_mainnet();
     REQUIRE(genesis.is_valid());
@@ -335,6 +348,62 @@ TEST_CASE("block  factory from data 3  genesis mainnet  success", "[block serial
     REQUIRE(genesis.header().merkle() == block.generate_merkle_root());
 }
 
+TEST_CASE("block  factory from data  arena  matches the heap parse", "[block serialization]") {
+    auto const genesis = chain::block::genesis_mainnet();
+    auto const raw_block = genesis.to_data();
+
+    byte_reader reader(raw_block);
+    auto const result = chain::block::from_data(reader, true, true);
+    REQUIRE(result);
+    REQUIRE(*result == genesis);
+    REQUIRE(result->to_data() == raw_block);
+    REQUIRE(genesis.header().merkle() == result->generate_merkle_root());
+}
+
+TEST_CASE("block  factory from data  arena  copies outlive the block", "[block serialization]") {
+    auto const genesis = chain::block::genesis_mainnet();
+    auto const raw_block = genesis.to_data();
+
+    chain::block copy;
+    chain::transaction tx;
+    chain::script script;
+    {
+        byte_reader reader(raw_block);
+        auto const result = chain::block::from_data(reader, true, true);
+        REQUIRE(result);
+        copy = *result;
+        tx = result->transactions().front();
+        script = result->transactions().front().outputs().front().script();
+    }
+
+    REQUIRE(copy == genesis);
+    REQUIRE(tx == genesis.transactions().front());
+    REQUIRE(script == genesis.transactions().front().outputs().front().script());
+}
+
+TEST_CASE("block  factory from data  arena  assigned over", "[block serialization]") {
+    auto const genesis = chain::block::genesis_mainnet();
+    auto const raw_block = genesis.to_data();
+
+    byte_reader reader(raw_block);
+    auto result = chain::block::from_data(reader, true, true);
+    REQUIRE(result);
+    auto block = std::move(*result);
+
+    // The arena transactions are released before their arena.
+    block = chain::block::genesis_testnet();
+    REQUIRE(block == chain::block::genesis_testnet());
+
+    byte_reader other_reader(raw_block);
+    auto other = chain::block::from_data(other_reader, true, true);
+    REQUIRE(other);
+    block = std::move(*other);
+    REQUIRE(block == genesis);
+
+    block = genesis;
+    REQUIRE(block == genesis);
+}
+
 // End Test Suite
 
 // Start Test Suite: block generate merkle root tests
@@ -659,6 +728,51 @@ TEST_CASE("block  is forward reference  forward reference  true", "[block is for
     REQUIRE(value.is_forward_reference());
 }
 
+TEST_CASE("block  is canonical ordered  ascending txids  true", "[block is canonical ordered]") {
+    chain::transaction coinbase{1, 0, {{{null_hash, chain::point::null_index}, {}, 0}}, {}};
+    chain::transaction::list txs {{1, 0, {}, {}}, {2, 0, {}, {}}, {3, 0, {}, {}}, {4, 0, {}, {}}};
+    std::sort(txs.begin(), txs.end(), [](chain::transaction const& a, chain::transaction const& b) {
+        return encode_hash(a.hash()) < encode_hash(b.hash());
+    });
+    txs.insert(txs.begin(), coinbase);
+
+    chain::block value;
+    value.set_transactions(txs);
+    REQUIRE(value.is_canonical_ordered());
+}
+
+TEST_CASE("block  is canonical ordered  descending txids  false", "[block is canonical ordered]") {
+    chain::transaction coinbase{1, 0, {{{null_hash, chain::point::null_index}, {}, 0}}, {}};
+    chain::transaction::list txs {{1, 0, {}, {}}, {2, 0, {}, {}}, {3, 0, {}, {}}, {4, 0, {}, {}}};
+    std::sort(txs.begin(), txs.end(), [](chain::transaction const& a, chain::transaction const& b) {
+        return encode_hash(a.hash()) > encode_hash(b.hash());
+    });
+    txs.insert(txs.begin(), coinbase);
+
+    chain::block value;
+    value.set_transactions(txs);
+    REQUIRE( ! value.is_canonical_ordered());
+}
+
 // End Test Suite
 
+// Start Test Suite: block total inputs tests
+
+TEST_CASE("block  total inputs  without coinbase first  does not cache the flag", "[block total inputs]") {
+    chain::transaction coinbase{1, 0, {{{null_hash, chain::point::null_index}, {}, 0}}, {}};
+    chain::transaction spend{1, 0, {{{null_hash, 0}, {}, 0}, {{null_hash, 1}, {}, 0}}, {}};
+
+    chain::block value;
+    value.set_transactions({coinbase, spend});
+    REQUIRE(value.total_inputs(false) == 2);
+    REQUIRE(value.total_inputs(true) == 3);
+    REQUIRE(value.total_inputs(false) == 2);
+}
+
+TEST_CASE("block  total inputs  no transactions  zero", "[block total inputs]") {
+    chain::block value;
+    REQUIRE(value.total_inputs(false) == 0);
+    REQUIRE(value.total_inputs(true) == 0);
+}
+
 // End Test Suite
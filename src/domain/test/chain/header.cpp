@@ -400,6 +400,27 @@ TEST_CASE("chain header  operator assign equals  always  matches equivalent", "[
     REQUIRE(instance.is_valid());
 }
 
+TEST_CASE("chain header  operator assign equals  hashed instance  returns new hash", "[chain header]") {
+    chain::header const value(10u, null_hash, null_hash, 531234u, 6523454u, 68644u);
+    chain::header instance;
+    auto const default_hash = instance.hash();
+
+    instance = value;
+    REQUIRE(instance.hash() == value.hash());
+    REQUIRE(instance.hash() != default_hash);
+}
+
+TEST_CASE("chain header  setter  hashed instance  returns new hash", "[chain header]") {
+    chain::header instance(10u, null_hash, null_hash, 531234u, 6523454u, 68644u);
+    auto const hash = instance.hash();
+
+    instance.set_nonce(68645u);
+    REQUIRE(instance.hash() != hash);
+
+    instance.set_nonce(68644u);
+    REQUIRE(instance.hash() == hash);
+}
+
 TEST_CASE("chain header  operator boolean equals  duplicates  returns true", "[chain header]") {
     chain::header const expected(
         10u,
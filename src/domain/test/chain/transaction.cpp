@@ -479,6 +479,20 @@ TEST_CASE("chain transaction  factory data 1  case 2  success", "[chain transact
     REQUIRE(resave == raw_tx);
 }
 
+TEST_CASE("chain transaction  operator assign equals  hashed instance  returns new hash", "[chain transaction]") {
+    static auto const raw_tx1 = to_chunk(base16_literal(TX1));
+    static auto const raw_tx4 = to_chunk(base16_literal(TX4));
+
+    auto instance = create<chain::transaction>(raw_tx1);
+    REQUIRE(instance.hash() == hash_literal(TX1_HASH));
+    REQUIRE(instance.outputs_hash() != null_hash);
+    auto const outputs_hash = instance.outputs_hash();
+
+    instance = create<chain::transaction>(raw_tx4);
+    REQUIRE(instance.hash() == hash_literal(TX4_HASH));
+    REQUIRE(instance.outputs_hash() != outputs_hash);
+}
+
 TEST_CASE("chain transaction  factory data 2  case 1  success", "[chain transaction]") {
     static auto const tx_hash = hash_literal(TX1_HASH);
     static auto const raw_tx = to_chunk(base16_literal(TX1));
@@ -112,8 +112,10 @@
 #include <kth/infrastructure/utility/flush_lock.hpp>
 #include <kth/infrastructure/utility/interprocess_lock.hpp>
 #include <kth/infrastructure/utility/istream_reader.hpp>
+#include <kth/infrastructure/utility/metrics.hpp>
 #include <kth/infrastructure/utility/monitor.hpp>
 #include <kth/infrastructure/utility/noncopyable.hpp>
+#include <kth/infrastructure/utility/once_cache.hpp>
 #include <kth/infrastructure/utility/operators.hpp>
 #include <kth/infrastructure/utility/ostream_writer.hpp>
 
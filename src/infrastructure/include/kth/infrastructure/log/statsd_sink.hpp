@@ -10,6 +10,7 @@
 #include <kth/infrastructure/config/authority.hpp>
 #include <kth/infrastructure/define.hpp>
 #include <kth/infrastructure/log/rotable_file.hpp>
+#include <kth/infrastructure/utility/metrics.hpp>
 #include <kth/infrastructure/utility/threadpool.hpp>
 
 namespace kth::log {
@@ -18,6 +19,9 @@ void initialize_statsd(rotable_file const& file);
 
 void initialize_statsd(threadpool& pool, const infrastructure::config::authority& server);
 
+/// Emit every metric of the registry as a statsd gauge (negatives as zero).
+void publish_statsd(metrics::registry const& registry);
+
 } // namespace kth::log
 
 #endif
@@ -57,6 +57,24 @@ KI_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t
 /// Generate a bitcoin hash.
 KI_API hash_digest bitcoin_hash(data_slice data);
 
+/// Generate the bitcoin hash of each of blocks consecutive 64 byte messages,
+/// several at once with SIMD when the CPU supports it. out may alias in.
+KI_API void sha256d64(uint8_t* out, uint8_t const* in, size_t blocks);
+
+/// Generate the merkle root of a list of hashes, null_hash if empty.
+KI_API hash_digest merkle_root(hash_list hashes);
+
+/// A sha256d64 kernel, hashing width consecutive 64 byte messages at once.
+struct sha256d64_kernel {
+    char const* name;
+    size_t width;
+    void (*transform)(uint8_t* out, uint8_t const* in);
+};
+
+/// Every sha256d64 kernel the CPU supports, the portable one first, whether
+/// sha256d64 dispatches to it or not. Allows testing them against each other.
+KI_API std::vector<sha256d64_kernel> sha256d64_kernels();
+
 //TODO(fernando): see what to do with Currency
 #if defined(KTH_CURRENCY_LTC)
 /// Generate a litecoin hash.
@@ -5,6 +5,7 @@
 #ifndef KTH_SIP_HASH_HPP_
 #define KTH_SIP_HASH_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
 #include <kth/infrastructure/math/hash.hpp>
@@ -80,6 +81,11 @@ public:
 uint64_t sip_hash_uint256(uint64_t k0, uint64_t k1, hash_digest const& val);
 uint64_t sip_hash_uint256_extra(uint64_t k0, uint64_t k1, hash_digest const& val, uint32_t extra);
 
+/** sip_hash_uint256 of each of the count hashes into out, several at once
+ *  with SIMD when the CPU supports it.
+ */
+void sip_hash_uint256(uint64_t k0, uint64_t k1, hash_digest const* hashes, size_t count, uint64_t* out);
+
 } // namespace kth
 
 #endif /* KTH_SIP_HASH_HPP_ */
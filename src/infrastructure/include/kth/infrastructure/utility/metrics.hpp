@@ -0,0 +1,149 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_INFRASTRUCTURE_METRICS_HPP
+#define KTH_INFRASTRUCTURE_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <kth/infrastructure/define.hpp>
+
+namespace kth::metrics {
+
+/// Monotonic count, thread safe and lock free.
+class KI_API counter {
+public:
+    void add(uint64_t value = 1) {
+        value_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/// Current value, thread safe and lock free.
+class KI_API gauge {
+public:
+    void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void add(int64_t value) {
+        value_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    int64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+/// Log-linear (HDR style) histogram of unsigned values, thread safe and lock
+/// free. Each power of two is split in sub_buckets buckets, so a bucket bound
+/// is within 1/sub_buckets of the values it holds. A record is three relaxed
+/// atomic increments, cheap enough for the block and transaction paths.
+class KI_API histogram {
+public:
+    static constexpr size_t sub_bucket_bits = 3;
+    static constexpr size_t sub_buckets = size_t(1) << sub_bucket_bits;
+    static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+    using buckets_t = std::array<uint64_t, bucket_count>;
+
+    void record(uint64_t value) {
+        buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const;
+    uint64_t sum() const;
+
+    /// The bucket counts, not cumulative.
+    buckets_t buckets() const;
+
+    /// The upper bound of the bucket holding the quantile (0 to 1), zero if
+    /// empty.
+    uint64_t quantile(double value) const;
+
+    static
+    size_t bucket_index(uint64_t value);
+
+    /// The largest value of the bucket.
+    static
+    uint64_t bucket_bound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, bucket_count> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+};
+
+/// Named metrics, thread safe. The metrics live as long as the registry, so
+/// callers resolve them once and keep the reference, recording does not
+/// lock. Names follow the Prometheus conventions (kth_<area>_<name>_<unit>).
+class KI_API registry {
+public:
+    using sampler = std::function<int64_t()>;
+
+    /// Return the metric of that name, created on first use.
+    counter& make_counter(std::string const& name, std::string const& help);
+    gauge& make_gauge(std::string const& name, std::string const& help);
+    histogram& make_histogram(std::string const& name, std::string const& help);
+
+    /// A gauge read on collection, for values owned by other objects.
+    /// Replaces a sampler of the same name, remove it before the owner dies.
+    void make_sampled_gauge(std::string const& name, std::string const& help, sampler sample);
+    void remove_sampled_gauge(std::string const& name);
+
+    /// The Prometheus text exposition format (version 0.0.4).
+    /// Histograms export the bucket bounds of each power of two up to the
+    /// largest value recorded.
+    std::string to_prometheus() const;
+
+    /// Flat name/value pairs for push sinks (statsd). Histograms export
+    /// <name>.count, <name>.sum and the p50, p90, p99 and max bucket bounds.
+    std::vector<std::pair<std::string, int64_t>> snapshot() const;
+
+private:
+    enum class kind { counter, gauge, histogram, sampled };
+
+    struct entry {
+        kind type;
+        std::string help;
+        std::unique_ptr<counter> counter_value;
+        std::unique_ptr<gauge> gauge_value;
+        std::unique_ptr<histogram> histogram_value;
+        sampler sample;
+    };
+
+    // precondition: mutex_ is held
+    entry& find_or_create(std::string const& name, std::string const& help, kind type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, entry> entries_;
+};
+
+/// The process wide registry, fed by all the modules.
+KI_API registry& default_registry();
+
+} // namespace kth::metrics
+
+#endif
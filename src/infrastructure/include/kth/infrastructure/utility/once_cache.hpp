@@ -0,0 +1,131 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_INFRASTRUCTURE_ONCE_CACHE_HPP
+#define KTH_INFRASTRUCTURE_ONCE_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace kth {
+
+/// A lazily computed value stored inline, computed at most once and then
+/// read with a single acquire load. Concurrent readers of an empty cache
+/// wait for the first one to publish it. Like the owning object, the cache
+/// must not be reset, set or assigned concurrently with reads.
+template <typename Type>
+class once_cache {
+public:
+    once_cache() = default;
+
+    /// Copies carry the value if it was computed.
+    once_cache(once_cache const& x) {
+        if (x.has_value()) {
+            value_ = x.value_;
+            state_.store(ready, std::memory_order_relaxed);
+        }
+    }
+
+    once_cache(once_cache&& x) noexcept {
+        if (x.has_value()) {
+            value_ = std::move(x.value_);
+            state_.store(ready, std::memory_order_relaxed);
+            x.reset();
+        }
+    }
+
+    once_cache& operator=(once_cache const& x) {
+        if (this == &x) {
+            return *this;
+        }
+
+        if (x.has_value()) {
+            set(x.value_);
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    once_cache& operator=(once_cache&& x) noexcept {
+        if (this == &x) {
+            return *this;
+        }
+
+        if (x.has_value()) {
+            set(std::move(x.value_));
+            x.reset();
+        } else {
+            reset();
+        }
+        return *this;
+    }
+
+    /// The cached value, compute() is called if there is none yet.
+    template <typename Compute>
+    Type const& get(Compute&& compute) const {
+        if (state_.load(std::memory_order_acquire) == ready) {
+            return value_;
+        }
+        return get_slow(compute);
+    }
+
+    bool has_value() const {
+        return state_.load(std::memory_order_acquire) == ready;
+    }
+
+    /// Stores a value known in advance.
+    void set(Type value) const {
+        value_ = std::move(value);
+        state_.store(ready, std::memory_order_release);
+    }
+
+    void reset() const {
+        state_.store(empty, std::memory_order_relaxed);
+        value_ = Type{};
+    }
+
+private:
+    static constexpr uint8_t empty = 0;
+    static constexpr uint8_t busy = 1;
+    static constexpr uint8_t ready = 2;
+
+    template <typename Compute>
+    Type const& get_slow(Compute& compute) const {
+        while (true) {
+            auto expected = empty;
+            if (state_.compare_exchange_strong(expected, busy, std::memory_order_acquire)) {
+                try {
+                    value_ = compute();
+                } catch (...) {
+                    state_.store(empty, std::memory_order_release);
+                    throw;
+                }
+
+                state_.store(ready, std::memory_order_release);
+                return value_;
+            }
+
+            // Another reader is computing it, which takes microseconds.
+            while (expected == busy) {
+                std::this_thread::yield();
+                expected = state_.load(std::memory_order_acquire);
+            }
+
+            // Otherwise its computation threw, try again.
+            if (expected == ready) {
+                return value_;
+            }
+        }
+    }
+
+    mutable Type value_{};
+    mutable std::atomic<uint8_t> state_{empty};
+};
+
+} // namespace kth
+
+#endif
@@ -26,6 +26,10 @@ public:
     void lock_low_priority();
     void unlock_low_priority();
 
+    /// Low priority, shared with the other shared low priority holders.
+    void lock_low_priority_shared();
+    void unlock_low_priority_shared();
+
     void lock_high_priority();
     void unlock_high_priority();
 
@@ -4,6 +4,7 @@
 
 #include <kth/infrastructure/log/statsd_sink.hpp>
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -23,6 +24,7 @@
 #include <kth/infrastructure/log/features/timer.hpp>
 #include <kth/infrastructure/log/file_collector_repository.hpp>
 #include <kth/infrastructure/log/severity.hpp>
+#include <kth/infrastructure/log/statsd_source.hpp>
 #include <kth/infrastructure/log/udp_client_sink.hpp>
 #include <kth/infrastructure/unicode/ofstream.hpp>
 #include <kth/infrastructure/utility/asio.hpp>
@@ -130,4 +132,10 @@ void initialize_statsd(threadpool& pool, authority const& server) {
     }
 }
 
+void publish_statsd(metrics::registry const& registry) {
+    for (auto const& [name, value] : registry.snapshot()) {
+        KI_STATS_GAUGE(name, uint64_t(std::max(value, int64_t(0))));
+    }
+}
+
 } // namespace kth::log
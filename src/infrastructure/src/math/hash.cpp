@@ -17,8 +17,8 @@
 #include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
 #include "../math/external/sha1.h"
-#include "../math/external/sha256.h"
 #include "../math/external/sha512.h"
+#include "sha256/sha256.hpp"
 
 //TODO(fernando): see what to do with Currency
 // #ifdef KTH_CURRENCY_LTC
@@ -28,7 +28,9 @@
 namespace kth {
 
 hash_digest bitcoin_hash(data_slice data) {
-    return sha256_hash(sha256_hash(data));
+    hash_digest hash;
+    sha256::double_hash(data.data(), data.size(), hash.data());
+    return hash;
 }
 
 // #ifdef KTH_CURRENCY_LTC
@@ -70,23 +72,22 @@ data_chunk sha1_hash_chunk(data_slice data) {
 
 hash_digest sha256_hash(data_slice data) {
     hash_digest hash;
-    SHA256_(data.data(), data.size(), hash.data());
+    sha256::hash(data.data(), data.size(), hash.data());
     return hash;
 }
 
 data_chunk sha256_hash_chunk(data_slice data) {
     data_chunk hash(hash_size);
-    SHA256_(data.data(), data.size(), hash.data());
+    sha256::hash(data.data(), data.size(), hash.data());
     return hash;
 }
 
 hash_digest sha256_hash(data_slice first, data_slice second) {
     hash_digest hash;
-    SHA256CTX context;
-    SHA256Init(&context);
-    SHA256Update(&context, first.data(), first.size());
-    SHA256Update(&context, second.data(), second.size());
-    SHA256Final(&context, hash.data());
+    sha256::context context;
+    context.write(first.data(), first.size());
+    context.write(second.data(), second.size());
+    context.finalize(hash.data());
     return hash;
 }
 
@@ -0,0 +1,136 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "sha256_kernels.hpp"
+#include "sha256_lanes.hpp"
+
+namespace kth::sha256 {
+
+namespace {
+
+using transform_t = void (*)(uint32_t* state, uint8_t const* blocks, size_t count);
+
+transform_t select_transform() {
+#if defined(KTH_SHA256_X86)
+    if (detect_cpu().shani) {
+        return shani::transform;
+    }
+#endif
+    return portable::transform;
+}
+
+void transform(uint32_t* state, uint8_t const* blocks, size_t count) {
+    static auto const selected = select_transform();
+    selected(state, blocks, count);
+}
+
+} // namespace
+
+namespace portable {
+
+void transform(uint32_t* state, uint8_t const* blocks, size_t count) {
+    using scalar = lanes<scalar_ops>;
+
+    scalar::state current;
+    std::copy_n(state, 8, current.words);
+
+    for (; count > 0; --count, blocks += 64) {
+        uint32_t w[16];
+        for (size_t i = 0; i < 16; ++i) {
+            w[i] = scalar_ops::load(blocks, i);
+        }
+
+        auto const previous = current;
+        scalar::compress(current, w);
+        scalar::add_to(current, previous);
+    }
+
+    std::copy_n(current.words, 8, state);
+}
+
+} // namespace portable
+
+context::context() {
+    std::copy(initial_state.begin(), initial_state.end(), state_);
+}
+
+void context::write(uint8_t const* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    auto used = size_t(size_ % 64);
+    size_ += size;
+
+    if (used != 0) {
+        auto const fill = std::min(size, 64 - used);
+        std::memcpy(buffer_ + used, data, fill);
+        data += fill;
+        size -= fill;
+        used += fill;
+
+        if (used < 64) {
+            return;
+        }
+
+        transform(state_, buffer_, 1);
+    }
+
+    // Whole blocks straight from the input, without copying.
+    auto const blocks = size / 64;
+    if (blocks != 0) {
+        transform(state_, data, blocks);
+        data += blocks * 64;
+        size -= blocks * 64;
+    }
+
+    std::memcpy(buffer_, data, size);
+}
+
+void context::finalize(uint8_t* digest) {
+    auto const bits = size_ * 8;
+    auto const used = size_t(size_ % 64);
+
+    // 0x80, zeros up to 56 bytes of the last block, the length in bits.
+    uint8_t padding[72] {0x80};
+    auto const pad = used < 56 ? 56 - used : 120 - used;
+    for (size_t i = 0; i < 8; ++i) {
+        padding[pad + i] = uint8_t(bits >> (56 - 8 * i));
+    }
+
+    write(padding, pad + 8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        write_be32(digest + 4 * i, state_[i]);
+    }
+}
+
+void hash(uint8_t const* data, size_t size, uint8_t* digest) {
+    context hasher;
+    hasher.write(data, size);
+    hasher.finalize(digest);
+}
+
+void double_hash(uint8_t const* data, size_t size, uint8_t* digest) {
+    // The first digest, its padding and its length (256 bits) make one block.
+    uint8_t block[64] {};
+    hash(data, size, block);
+    block[32] = 0x80;
+    block[62] = 0x01;
+
+    uint32_t state[8];
+    std::copy(initial_state.begin(), initial_state.end(), state);
+    transform(state, block, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        write_be32(digest + 4 * i, state[i]);
+    }
+}
+
+} // namespace kth::sha256
@@ -0,0 +1,37 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_INFRASTRUCTURE_SHA256_HPP
+#define KTH_INFRASTRUCTURE_SHA256_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// SHA256 of arbitrary messages over the fastest transform of the CPU
+// (SHA-NI when present, the portable code otherwise).
+
+namespace kth::sha256 {
+
+/// Incremental SHA256, write any number of times then finalize once.
+class context {
+public:
+    context();
+
+    void write(uint8_t const* data, size_t size);
+    void finalize(uint8_t* digest);
+
+private:
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    uint64_t size_ = 0;
+};
+
+void hash(uint8_t const* data, size_t size, uint8_t* digest);
+
+/// SHA256 of the SHA256, the second hash in a single block.
+void double_hash(uint8_t const* data, size_t size, uint8_t* digest);
+
+} // namespace kth::sha256
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_INFRASTRUCTURE_SHA256_KERNELS_HPP
+#define KTH_INFRASTRUCTURE_SHA256_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// The SHA256 kernels and the CPU features that select them. The x86 kernels
+// are compiled (KTH_SHA256_X86) with their instruction set flags in their own
+// translation units, and are only called when the CPU supports them.
+
+namespace kth::sha256 {
+
+struct cpu_features {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool shani = false;
+};
+
+/// Detected once, the kernels can be disabled with KTH_SHA256_DISABLE_SIMD.
+cpu_features const& detect_cpu();
+
+namespace portable {
+void transform(uint32_t* state, uint8_t const* blocks, size_t count);
+void transform_d64(uint8_t* out, uint8_t const* in);
+} // namespace portable
+
+#if defined(KTH_SHA256_X86)
+
+namespace sse41 {
+void transform_d64_4way(uint8_t* out, uint8_t const* in);
+} // namespace sse41
+
+namespace avx2 {
+void transform_d64_8way(uint8_t* out, uint8_t const* in);
+} // namespace avx2
+
+namespace shani {
+void transform(uint32_t* state, uint8_t const* blocks, size_t count);
+void transform_d64(uint8_t* out, uint8_t const* in);
+void transform_d64_2way(uint8_t* out, uint8_t const* in);
+} // namespace shani
+
+#endif // KTH_SHA256_X86
+
+} // namespace kth::sha256
+
+#endif
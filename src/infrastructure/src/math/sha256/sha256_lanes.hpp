@@ -0,0 +1,234 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_INFRASTRUCTURE_SHA256_LANES_HPP
+#define KTH_INFRASTRUCTURE_SHA256_LANES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// The double SHA256 of 64 byte messages, computed for several messages at
+// once in the lanes of a vector type. Each kernel (portable, SSE4.1, AVX2)
+// instantiates it with its own lane operations.
+//
+// This header is included by translation units compiled with different
+// instruction set flags, so everything here must have internal linkage: a
+// shared inline definition could be taken from the AVX2 unit by the linker
+// and run on a CPU without AVX2.
+
+namespace kth::sha256 {
+namespace {
+
+constexpr std::array<uint32_t, 64> round_constants {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+constexpr std::array<uint32_t, 8> initial_state {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+constexpr uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+// The padding block of a 64 byte message is constant, so is its schedule.
+// Returns the schedule words with the round constants added.
+constexpr std::array<uint32_t, 64> padding_schedule() {
+    std::array<uint32_t, 64> w {};
+    w[0] = 0x80000000;
+    w[15] = 512;
+    for (size_t i = 16; i < 64; ++i) {
+        auto const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        auto const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    for (size_t i = 0; i < 64; ++i) {
+        w[i] += round_constants[i];
+    }
+    return w;
+}
+
+constexpr auto padding_64 = padding_schedule();
+
+inline
+uint32_t read_be32(uint8_t const* data) {
+    return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+inline
+void write_be32(uint8_t* data, uint32_t value) {
+    data[0] = uint8_t(value >> 24);
+    data[1] = uint8_t(value >> 16);
+    data[2] = uint8_t(value >> 8);
+    data[3] = uint8_t(value);
+}
+
+// One message at a time, the portable kernels.
+struct scalar_ops {
+    using vector = uint32_t;
+
+    static vector set1(uint32_t x) { return x; }
+    static vector add(vector x, vector y) { return x + y; }
+    static vector bxor(vector x, vector y) { return x ^ y; }
+    static vector band(vector x, vector y) { return x & y; }
+    static vector bor(vector x, vector y) { return x | y; }
+    static vector shr(vector x, int n) { return x >> n; }
+    static vector shl(vector x, int n) { return x << n; }
+
+    static vector load(uint8_t const* in, size_t word) {
+        return read_be32(in + 4 * word);
+    }
+
+    static void store(uint8_t* out, size_t word, vector x) {
+        write_be32(out + 4 * word, x);
+    }
+};
+
+// Ops provides the vector type and: lanes, set1, add, bxor, band, bor, shr,
+// shl, load (word of each lane message) and store (word of each lane digest).
+template <typename Ops>
+struct lanes {
+    using vector = typename Ops::vector;
+
+    // Plain arrays, std::array would drop the alignment of the vector types.
+    struct state {
+        vector words[8];
+
+        vector& operator[](size_t i) { return words[i]; }
+        vector const& operator[](size_t i) const { return words[i]; }
+    };
+
+    static
+    vector ror(vector x, int n) {
+        return Ops::bor(Ops::shr(x, n), Ops::shl(x, 32 - n));
+    }
+
+    static
+    vector big_sigma0(vector x) {
+        return Ops::bxor(Ops::bxor(ror(x, 2), ror(x, 13)), ror(x, 22));
+    }
+
+    static
+    vector big_sigma1(vector x) {
+        return Ops::bxor(Ops::bxor(ror(x, 6), ror(x, 11)), ror(x, 25));
+    }
+
+    static
+    vector small_sigma0(vector x) {
+        return Ops::bxor(Ops::bxor(ror(x, 7), ror(x, 18)), Ops::shr(x, 3));
+    }
+
+    static
+    vector small_sigma1(vector x) {
+        return Ops::bxor(Ops::bxor(ror(x, 17), ror(x, 19)), Ops::shr(x, 10));
+    }
+
+    static
+    vector choose(vector x, vector y, vector z) {
+        return Ops::bxor(z, Ops::band(x, Ops::bxor(y, z)));
+    }
+
+    static
+    vector majority(vector x, vector y, vector z) {
+        return Ops::bor(Ops::band(x, y), Ops::band(z, Ops::bor(x, y)));
+    }
+
+    // One round, k is the schedule word plus the round constant.
+    static
+    void round(state& s, vector k) {
+        auto const t1 = Ops::add(Ops::add(Ops::add(s[7], big_sigma1(s[4])), choose(s[4], s[5], s[6])), k);
+        auto const t2 = Ops::add(big_sigma0(s[0]), majority(s[0], s[1], s[2]));
+        s[7] = s[6];
+        s[6] = s[5];
+        s[5] = s[4];
+        s[4] = Ops::add(s[3], t1);
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = Ops::add(t1, t2);
+    }
+
+    // The schedule is expanded in place, w is clobbered.
+    static
+    void compress(state& s, vector (&w)[16]) {
+        for (size_t i = 0; i < 64; ++i) {
+            if (i >= 16) {
+                w[i % 16] = Ops::add(Ops::add(w[i % 16], small_sigma0(w[(i + 1) % 16])),
+                    Ops::add(w[(i + 9) % 16], small_sigma1(w[(i + 14) % 16])));
+            }
+            round(s, Ops::add(w[i % 16], Ops::set1(round_constants[i])));
+        }
+    }
+
+    static
+    void compress_padding(state& s) {
+        for (size_t i = 0; i < 64; ++i) {
+            round(s, Ops::set1(padding_64[i]));
+        }
+    }
+
+    static
+    state initial() {
+        state s;
+        for (size_t i = 0; i < 8; ++i) {
+            s[i] = Ops::set1(initial_state[i]);
+        }
+        return s;
+    }
+
+    static
+    void add_to(state& s, state const& other) {
+        for (size_t i = 0; i < 8; ++i) {
+            s[i] = Ops::add(s[i], other[i]);
+        }
+    }
+
+    // Ops::lanes consecutive 64 byte messages in, as many 32 byte digests out.
+    static
+    void transform_d64(uint8_t* out, uint8_t const* in) {
+        vector w[16];
+        for (size_t i = 0; i < 16; ++i) {
+            w[i] = Ops::load(in, i);
+        }
+
+        // First hash, the message block and the padding block.
+        auto s = initial();
+        compress(s, w);
+        add_to(s, initial());
+        auto const first = s;
+        compress_padding(s);
+        add_to(s, first);
+
+        // Second hash, the 32 byte digest and its padding in a single block.
+        for (size_t i = 0; i < 8; ++i) {
+            w[i] = s[i];
+        }
+        w[8] = Ops::set1(0x80000000);
+        for (size_t i = 9; i < 15; ++i) {
+            w[i] = Ops::set1(0);
+        }
+        w[15] = Ops::set1(256);
+
+        s = initial();
+        compress(s, w);
+        add_to(s, initial());
+
+        for (size_t i = 0; i < 8; ++i) {
+            Ops::store(out, i, s[i]);
+        }
+    }
+};
+
+} // namespace
+} // namespace kth::sha256
+
+#endif
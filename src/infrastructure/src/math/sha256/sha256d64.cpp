@@ -0,0 +1,187 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/infrastructure/math/hash.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include "sha256_kernels.hpp"
+#include "sha256_lanes.hpp"
+
+#if defined(KTH_SHA256_X86)
+#include <cpuid.h>
+#endif
+
+namespace kth::sha256 {
+
+namespace {
+
+#if defined(KTH_SHA256_X86)
+
+uint64_t xgetbv() {
+    uint32_t low;
+    uint32_t high;
+    __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (uint64_t(high) << 32) | low;
+}
+
+cpu_features detect() {
+    cpu_features result;
+    if (std::getenv("KTH_SHA256_DISABLE_SIMD") != nullptr) {
+        return result;
+    }
+
+    uint32_t eax, ebx, ecx, edx;
+    if ( ! __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return result;
+    }
+
+    auto const ssse3 = (ecx & bit_SSSE3) != 0;
+    result.sse41 = (ecx & bit_SSE4_1) != 0;
+
+    // The OS must save the YMM registers (XCR0 bits 1 and 2).
+    auto const avx = (ecx & bit_AVX) != 0 && (ecx & bit_OSXSAVE) != 0 && (xgetbv() & 0x6) == 0x6;
+
+    if ( ! __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return result;
+    }
+
+    result.avx2 = avx && (ebx & bit_AVX2) != 0;
+    result.shani = ssse3 && result.sse41 && (ebx & bit_SHA) != 0;
+    return result;
+}
+
+#else
+
+cpu_features detect() {
+    return {};
+}
+
+#endif // KTH_SHA256_X86
+
+using transform_d64_t = void (*)(uint8_t* out, uint8_t const* in);
+
+// The widest kernel of each width, null if there is none.
+struct d64_kernels {
+    transform_d64_t way1 = portable::transform_d64;
+    transform_d64_t way2 = nullptr;
+    transform_d64_t way4 = nullptr;
+    transform_d64_t way8 = nullptr;
+};
+
+// SHA-NI beats the SIMD kernels, they are only used without it.
+d64_kernels select_d64() {
+    d64_kernels result;
+
+#if defined(KTH_SHA256_X86)
+    auto const& cpu = detect_cpu();
+    if (cpu.shani) {
+        result.way1 = shani::transform_d64;
+        result.way2 = shani::transform_d64_2way;
+        return result;
+    }
+
+    if (cpu.sse41) {
+        result.way4 = sse41::transform_d64_4way;
+    }
+
+    if (cpu.avx2) {
+        result.way8 = avx2::transform_d64_8way;
+    }
+#endif
+
+    return result;
+}
+
+} // namespace
+
+cpu_features const& detect_cpu() {
+    static cpu_features const instance = detect();
+    return instance;
+}
+
+namespace portable {
+
+void transform_d64(uint8_t* out, uint8_t const* in) {
+    lanes<scalar_ops>::transform_d64(out, in);
+}
+
+} // namespace portable
+
+} // namespace kth::sha256
+
+namespace kth {
+
+// Each kernel reads all of its messages before writing, and the digests
+// written never pass the messages still unread, so out may alias in.
+void sha256d64(uint8_t* out, uint8_t const* in, size_t blocks) {
+    static auto const kernels = sha256::select_d64();
+
+    if (kernels.way8 != nullptr) {
+        for (; blocks >= 8; blocks -= 8, out += 8 * hash_size, in += 8 * 64) {
+            kernels.way8(out, in);
+        }
+    }
+
+    if (kernels.way4 != nullptr) {
+        for (; blocks >= 4; blocks -= 4, out += 4 * hash_size, in += 4 * 64) {
+            kernels.way4(out, in);
+        }
+    }
+
+    if (kernels.way2 != nullptr) {
+        for (; blocks >= 2; blocks -= 2, out += 2 * hash_size, in += 2 * 64) {
+            kernels.way2(out, in);
+        }
+    }
+
+    for (; blocks > 0; --blocks, out += hash_size, in += 64) {
+        kernels.way1(out, in);
+    }
+}
+
+std::vector<sha256d64_kernel> sha256d64_kernels() {
+    std::vector<sha256d64_kernel> result {{"portable", 1, sha256::portable::transform_d64}};
+
+#if defined(KTH_SHA256_X86)
+    auto const& cpu = sha256::detect_cpu();
+    if (cpu.sse41) {
+        result.push_back({"sse41", 4, sha256::sse41::transform_d64_4way});
+    }
+
+    if (cpu.avx2) {
+        result.push_back({"avx2", 8, sha256::avx2::transform_d64_8way});
+    }
+
+    if (cpu.shani) {
+        result.push_back({"shani", 1, sha256::shani::transform_d64});
+        result.push_back({"shani", 2, sha256::shani::transform_d64_2way});
+    }
+#endif
+
+    return result;
+}
+
+hash_digest merkle_root(hash_list hashes) {
+    if (hashes.empty()) {
+        return null_hash;
+    }
+
+    // Each level is reduced in place, into the front of the list.
+    while (hashes.size() > 1) {
+        // If number of hashes is odd, duplicate last hash in the list.
+        if (hashes.size() % 2 != 0) {
+            hashes.push_back(hashes.back());
+        }
+
+        auto const pairs = hashes.size() / 2;
+        sha256d64(hashes.front().data(), hashes.front().data(), pairs);
+        hashes.resize(pairs);
+    }
+
+    return hashes.front();
+}
+
+} // namespace kth
@@ -0,0 +1,49 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Compiled with -mavx2, only called when the CPU and the OS support it.
+
+#include <immintrin.h>
+
+#include "sha256_kernels.hpp"
+#include "sha256_lanes.hpp"
+
+namespace kth::sha256::avx2 {
+
+namespace {
+
+struct ops {
+    using vector = __m256i;
+
+    static vector set1(uint32_t x) { return _mm256_set1_epi32(int(x)); }
+    static vector add(vector x, vector y) { return _mm256_add_epi32(x, y); }
+    static vector bxor(vector x, vector y) { return _mm256_xor_si256(x, y); }
+    static vector band(vector x, vector y) { return _mm256_and_si256(x, y); }
+    static vector bor(vector x, vector y) { return _mm256_or_si256(x, y); }
+    static vector shr(vector x, int n) { return _mm256_srli_epi32(x, n); }
+    static vector shl(vector x, int n) { return _mm256_slli_epi32(x, n); }
+
+    static vector load(uint8_t const* in, size_t word) {
+        auto const at = in + 4 * word;
+        return _mm256_set_epi32(
+            int(read_be32(at + 448)), int(read_be32(at + 384)), int(read_be32(at + 320)), int(read_be32(at + 256)),
+            int(read_be32(at + 192)), int(read_be32(at + 128)), int(read_be32(at + 64)), int(read_be32(at)));
+    }
+
+    static void store(uint8_t* out, size_t word, vector x) {
+        alignas(32) uint32_t values[8];
+        _mm256_store_si256(reinterpret_cast<vector*>(values), x);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            write_be32(out + 32 * lane + 4 * word, values[lane]);
+        }
+    }
+};
+
+} // namespace
+
+void transform_d64_8way(uint8_t* out, uint8_t const* in) {
+    lanes<ops>::transform_d64(out, in);
+}
+
+} // namespace kth::sha256::avx2
@@ -0,0 +1,173 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Compiled with -msse4.1 -msha, only called when the CPU supports SHA-NI.
+// The state is kept as the instructions want it: ABEF and CDGH (the highest
+// lane first).
+
+#include <immintrin.h>
+
+#include "sha256_kernels.hpp"
+#include "sha256_lanes.hpp"
+
+namespace kth::sha256::shani {
+
+namespace {
+
+// Reverses the bytes of each 32 bit lane.
+__m128i byte_swap(__m128i x) {
+    return _mm_shuffle_epi8(x, _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll));
+}
+
+__m128i load(void const* data) {
+    return _mm_loadu_si128(static_cast<__m128i const*>(data));
+}
+
+// N independent messages, interleaved to hide the latency of the rounds.
+template <size_t N>
+struct messages {
+    __m128i abef[N];
+    __m128i cdgh[N];
+
+    void initial() {
+        for (size_t n = 0; n < N; ++n) {
+            abef[n] = _mm_set_epi32(int(initial_state[0]), int(initial_state[1]), int(initial_state[4]), int(initial_state[5]));
+            cdgh[n] = _mm_set_epi32(int(initial_state[2]), int(initial_state[3]), int(initial_state[6]), int(initial_state[7]));
+        }
+    }
+
+    void add(messages const& other) {
+        for (size_t n = 0; n < N; ++n) {
+            abef[n] = _mm_add_epi32(abef[n], other.abef[n]);
+            cdgh[n] = _mm_add_epi32(cdgh[n], other.cdgh[n]);
+        }
+    }
+
+    void rounds(__m128i const (&k)[N]) {
+        for (size_t n = 0; n < N; ++n) {
+            cdgh[n] = _mm_sha256rnds2_epu32(cdgh[n], abef[n], k[n]);
+        }
+        for (size_t n = 0; n < N; ++n) {
+            abef[n] = _mm_sha256rnds2_epu32(abef[n], cdgh[n], _mm_shuffle_epi32(k[n], 0x0e));
+        }
+    }
+
+    // w holds the four schedule quads of the block (lane 0 first), clobbered.
+    void compress(__m128i (&w)[N][4]) {
+        for (size_t q = 0; q < 16; ++q) {
+            auto const constants = load(round_constants.data() + 4 * q);
+            __m128i k[N];
+            for (size_t n = 0; n < N; ++n) {
+                auto& m = w[n];
+                if (q >= 4) {
+                    auto const sum = _mm_add_epi32(_mm_sha256msg1_epu32(m[q % 4], m[(q + 1) % 4]),
+                        _mm_alignr_epi8(m[(q + 3) % 4], m[(q + 2) % 4], 4));
+                    m[q % 4] = _mm_sha256msg2_epu32(sum, m[(q + 3) % 4]);
+                }
+                k[n] = _mm_add_epi32(m[q % 4], constants);
+            }
+            rounds(k);
+        }
+    }
+
+    void compress_padding() {
+        for (size_t q = 0; q < 16; ++q) {
+            __m128i k[N];
+            for (size_t n = 0; n < N; ++n) {
+                k[n] = load(padding_64.data() + 4 * q);
+            }
+            rounds(k);
+        }
+    }
+
+    // From the state words a..h, lane 0 first.
+    void set_words(size_t n, __m128i abcd, __m128i efgh) {
+        auto const cdab = _mm_shuffle_epi32(abcd, 0xb1);
+        auto const efgh_high = _mm_shuffle_epi32(efgh, 0x1b);
+        abef[n] = _mm_alignr_epi8(cdab, efgh_high, 8);
+        cdgh[n] = _mm_blend_epi16(efgh_high, cdab, 0xf0);
+    }
+
+    // The digest words a..h, lane 0 first.
+    void words(size_t n, __m128i& abcd, __m128i& efgh) const {
+        auto const feba = _mm_shuffle_epi32(abef[n], 0x1b);
+        auto const dchg = _mm_shuffle_epi32(cdgh[n], 0xb1);
+        abcd = _mm_blend_epi16(feba, dchg, 0xf0);
+        efgh = _mm_alignr_epi8(dchg, feba, 8);
+    }
+};
+
+template <size_t N>
+void transform_d64_ways(uint8_t* out, uint8_t const* in) {
+    __m128i w[N][4];
+    for (size_t n = 0; n < N; ++n) {
+        for (size_t q = 0; q < 4; ++q) {
+            w[n][q] = byte_swap(load(in + 64 * n + 16 * q));
+        }
+    }
+
+    messages<N> initial;
+    initial.initial();
+
+    // First hash, the message block and the padding block.
+    auto state = initial;
+    state.compress(w);
+    state.add(initial);
+    auto const first = state;
+    state.compress_padding();
+    state.add(first);
+
+    // Second hash, the 32 byte digest and its padding in a single block.
+    for (size_t n = 0; n < N; ++n) {
+        state.words(n, w[n][0], w[n][1]);
+        w[n][2] = _mm_set_epi32(0, 0, 0, int(0x80000000));
+        w[n][3] = _mm_set_epi32(256, 0, 0, 0);
+    }
+
+    state = initial;
+    state.compress(w);
+    state.add(initial);
+
+    for (size_t n = 0; n < N; ++n) {
+        __m128i abcd;
+        __m128i efgh;
+        state.words(n, abcd, efgh);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * n), byte_swap(abcd));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * n + 16), byte_swap(efgh));
+    }
+}
+
+} // namespace
+
+void transform(uint32_t* state, uint8_t const* blocks, size_t count) {
+    messages<1> current;
+    current.set_words(0, load(state), load(state + 4));
+
+    for (; count > 0; --count, blocks += 64) {
+        __m128i w[1][4];
+        for (size_t q = 0; q < 4; ++q) {
+            w[0][q] = byte_swap(load(blocks + 16 * q));
+        }
+
+        auto const previous = current;
+        current.compress(w);
+        current.add(previous);
+    }
+
+    __m128i abcd;
+    __m128i efgh;
+    current.words(0, abcd, efgh);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), abcd);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), efgh);
+}
+
+void transform_d64(uint8_t* out, uint8_t const* in) {
+    transform_d64_ways<1>(out, in);
+}
+
+void transform_d64_2way(uint8_t* out, uint8_t const* in) {
+    transform_d64_ways<2>(out, in);
+}
+
+} // namespace kth::sha256::shani
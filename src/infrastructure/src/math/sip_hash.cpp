@@ -4,6 +4,10 @@
 
 #include <kth/infrastructure/math/sip_hash.hpp>
 
+#if defined(KTH_SHA256_X86)
+#include "sha256/sha256_kernels.hpp"
+#endif
+
 #define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
 
 #define SIPROUND                                                               \
@@ -26,6 +30,12 @@
 
 namespace kth {
 
+#if defined(KTH_SHA256_X86)
+namespace avx2 {
+void sip_hash_uint256_4way(uint64_t k0, uint64_t k1, hash_digest const* hashes, uint64_t* out);
+} // namespace avx2
+#endif
+
 sip_hasher::sip_hasher(uint64_t k0, uint64_t k1)
     : v { 0x736f6d6570736575ULL ^ k0
         , 0x646f72616e646f6dULL ^ k1
@@ -188,4 +198,19 @@ uint64_t sip_hash_uint256_extra(uint64_t k0, uint64_t k1, hash_digest const& val
     return v0 ^ v1 ^ v2 ^ v3;
 }
 
+void sip_hash_uint256(uint64_t k0, uint64_t k1, hash_digest const* hashes, size_t count, uint64_t* out) {
+#if defined(KTH_SHA256_X86)
+    static auto const use_avx2 = sha256::detect_cpu().avx2;
+    if (use_avx2) {
+        for (; count >= 4; count -= 4, hashes += 4, out += 4) {
+            avx2::sip_hash_uint256_4way(k0, k1, hashes, out);
+        }
+    }
+#endif
+
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = sip_hash_uint256(k0, k1, hashes[i]);
+    }
+}
+
 } // namespace kth
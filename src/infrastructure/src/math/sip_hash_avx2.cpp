@@ -0,0 +1,104 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Compiled with -mavx2, only called when the CPU supports it.
+
+#include <kth/infrastructure/math/sip_hash.hpp>
+
+#include <immintrin.h>
+
+namespace kth::avx2 {
+
+namespace {
+
+template <int Bits>
+__m256i rotl(__m256i x) {
+    if constexpr (Bits == 32) {
+        return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if constexpr (Bits == 16) {
+        auto const mask = _mm256_setr_epi8(
+            6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13,
+            6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13);
+        return _mm256_shuffle_epi8(x, mask);
+    } else {
+        return _mm256_or_si256(_mm256_slli_epi64(x, Bits), _mm256_srli_epi64(x, 64 - Bits));
+    }
+}
+
+struct state {
+    __m256i v0;
+    __m256i v1;
+    __m256i v2;
+    __m256i v3;
+
+    void round() {
+        v0 = _mm256_add_epi64(v0, v1);
+        v1 = rotl<13>(v1);
+        v1 = _mm256_xor_si256(v1, v0);
+        v0 = rotl<32>(v0);
+        v2 = _mm256_add_epi64(v2, v3);
+        v3 = rotl<16>(v3);
+        v3 = _mm256_xor_si256(v3, v2);
+        v0 = _mm256_add_epi64(v0, v3);
+        v3 = rotl<21>(v3);
+        v3 = _mm256_xor_si256(v3, v0);
+        v2 = _mm256_add_epi64(v2, v1);
+        v1 = rotl<17>(v1);
+        v1 = _mm256_xor_si256(v1, v2);
+        v2 = rotl<32>(v2);
+    }
+
+    void compress(__m256i d) {
+        v3 = _mm256_xor_si256(v3, d);
+        round();
+        round();
+        v0 = _mm256_xor_si256(v0, d);
+    }
+};
+
+} // namespace
+
+// The words of the 4 hashes are transposed so that each vector holds the same
+// word of every hash, one per 64 bit lane (little endian, as get_uint64).
+void sip_hash_uint256_4way(uint64_t k0, uint64_t k1, hash_digest const* hashes, uint64_t* out) {
+    auto const h0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(hashes[0].data()));
+    auto const h1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(hashes[1].data()));
+    auto const h2 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(hashes[2].data()));
+    auto const h3 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(hashes[3].data()));
+
+    // {h0.w0, h1.w0, h0.w2, h1.w2} and so on.
+    auto const lo01 = _mm256_unpacklo_epi64(h0, h1);
+    auto const hi01 = _mm256_unpackhi_epi64(h0, h1);
+    auto const lo23 = _mm256_unpacklo_epi64(h2, h3);
+    auto const hi23 = _mm256_unpackhi_epi64(h2, h3);
+
+    auto const w0 = _mm256_permute2x128_si256(lo01, lo23, 0x20);
+    auto const w1 = _mm256_permute2x128_si256(hi01, hi23, 0x20);
+    auto const w2 = _mm256_permute2x128_si256(lo01, lo23, 0x31);
+    auto const w3 = _mm256_permute2x128_si256(hi01, hi23, 0x31);
+
+    state s {
+        _mm256_set1_epi64x(int64_t(0x736f6d6570736575ULL ^ k0)),
+        _mm256_set1_epi64x(int64_t(0x646f72616e646f6dULL ^ k1)),
+        _mm256_set1_epi64x(int64_t(0x6c7967656e657261ULL ^ k0)),
+        _mm256_set1_epi64x(int64_t(0x7465646279746573ULL ^ k1))
+    };
+
+    s.compress(w0);
+    s.compress(w1);
+    s.compress(w2);
+    s.compress(w3);
+    s.compress(_mm256_set1_epi64x(int64_t(uint64_t(4) << 59)));
+
+    s.v2 = _mm256_xor_si256(s.v2, _mm256_set1_epi64x(0xFF));
+    s.round();
+    s.round();
+    s.round();
+    s.round();
+
+    auto const result = _mm256_xor_si256(_mm256_xor_si256(s.v0, s.v1), _mm256_xor_si256(s.v2, s.v3));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+}
+
+} // namespace kth::avx2
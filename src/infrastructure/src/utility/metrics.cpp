@@ -0,0 +1,231 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/infrastructure/utility/metrics.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+namespace kth::metrics {
+
+// histogram
+// ----------------------------------------------------------------------------
+
+uint64_t histogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t histogram::sum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+histogram::buckets_t histogram::buckets() const {
+    buckets_t result;
+    for (size_t index = 0; index < bucket_count; ++index) {
+        result[index] = buckets_[index].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint64_t histogram::quantile(double value) const {
+    auto const values = buckets();
+
+    uint64_t total = 0;
+    for (auto const bucket : values) {
+        total += bucket;
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    auto const rank = std::max(uint64_t(1), uint64_t(std::ceil(value * double(total))));
+
+    uint64_t accumulated = 0;
+    for (size_t index = 0; index < bucket_count; ++index) {
+        accumulated += values[index];
+        if (accumulated >= rank) {
+            return bucket_bound(index);
+        }
+    }
+
+    return bucket_bound(bucket_count - 1);
+}
+
+// The values below sub_buckets have a bucket each, above that every power of
+// two [2^n, 2^(n+1)) is split by the sub_bucket_bits bits after the top one.
+size_t histogram::bucket_index(uint64_t value) {
+    if (value < sub_buckets) {
+        return size_t(value);
+    }
+
+    auto const top = size_t(std::bit_width(value)) - 1;
+    auto const shift = top - sub_bucket_bits;
+    return (shift + 1) * sub_buckets + size_t((value >> shift) - sub_buckets);
+}
+
+uint64_t histogram::bucket_bound(size_t index) {
+    if (index < sub_buckets) {
+        return uint64_t(index);
+    }
+
+    auto const shift = index / sub_buckets - 1;
+    auto const lower = uint64_t(sub_buckets + index % sub_buckets) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+// registry
+// ----------------------------------------------------------------------------
+
+counter& registry::make_counter(std::string const& name, std::string const& help) {
+    std::lock_guard lock(mutex_);
+    auto& item = find_or_create(name, help, kind::counter);
+    if ( ! item.counter_value) {
+        item.counter_value = std::make_unique<counter>();
+    }
+    return *item.counter_value;
+}
+
+gauge& registry::make_gauge(std::string const& name, std::string const& help) {
+    std::lock_guard lock(mutex_);
+    auto& item = find_or_create(name, help, kind::gauge);
+    if ( ! item.gauge_value) {
+        item.gauge_value = std::make_unique<gauge>();
+    }
+    return *item.gauge_value;
+}
+
+histogram& registry::make_histogram(std::string const& name, std::string const& help) {
+    std::lock_guard lock(mutex_);
+    auto& item = find_or_create(name, help, kind::histogram);
+    if ( ! item.histogram_value) {
+        item.histogram_value = std::make_unique<histogram>();
+    }
+    return *item.histogram_value;
+}
+
+void registry::make_sampled_gauge(std::string const& name, std::string const& help, sampler sample) {
+    std::lock_guard lock(mutex_);
+    find_or_create(name, help, kind::sampled).sample = std::move(sample);
+}
+
+void registry::remove_sampled_gauge(std::string const& name) {
+    std::lock_guard lock(mutex_);
+    auto const it = entries_.find(name);
+    if (it != entries_.end() && it->second.type == kind::sampled) {
+        entries_.erase(it);
+    }
+}
+
+// Samplers are invoked under the lock so that they are not removed (and
+// their owner destroyed) while running, they must not use the registry.
+std::string registry::to_prometheus() const {
+    std::string out;
+
+    std::lock_guard lock(mutex_);
+    for (auto const& [name, item] : entries_) {
+        switch (item.type) {
+            case kind::counter:
+                out += fmt::format("# HELP {0} {1}\n# TYPE {0} counter\n{0} {2}\n", name, item.help, item.counter_value->value());
+                break;
+
+            case kind::gauge:
+                out += fmt::format("# HELP {0} {1}\n# TYPE {0} gauge\n{0} {2}\n", name, item.help, item.gauge_value->value());
+                break;
+
+            case kind::sampled:
+                out += fmt::format("# HELP {0} {1}\n# TYPE {0} gauge\n{0} {2}\n", name, item.help, item.sample ? item.sample() : 0);
+                break;
+
+            case kind::histogram: {
+                out += fmt::format("# HELP {0} {1}\n# TYPE {0} histogram\n", name, item.help);
+
+                auto const& values = *item.histogram_value;
+                auto const buckets = values.buckets();
+
+                auto last = size_t(0);
+                for (size_t index = 0; index < histogram::bucket_count; ++index) {
+                    if (buckets[index] != 0) {
+                        last = index;
+                    }
+                }
+
+                // One bound per power of two (the last bucket of each), up to
+                // the one holding the largest value.
+                auto const end = (last / histogram::sub_buckets + 1) * histogram::sub_buckets;
+                uint64_t accumulated = 0;
+                for (size_t index = 0; index < end; ++index) {
+                    accumulated += buckets[index];
+                    if (index % histogram::sub_buckets == histogram::sub_buckets - 1) {
+                        out += fmt::format("{}_bucket{{le=\"{}\"}} {}\n", name, histogram::bucket_bound(index), accumulated);
+                    }
+                }
+
+                // The count is read after the buckets, +Inf must not be below them.
+                auto const count = std::max(values.count(), accumulated);
+                out += fmt::format("{0}_bucket{{le=\"+Inf\"}} {1}\n{0}_sum {2}\n{0}_count {1}\n", name, count, values.sum());
+                break;
+            }
+        }
+    }
+
+    return out;
+}
+
+std::vector<std::pair<std::string, int64_t>> registry::snapshot() const {
+    std::vector<std::pair<std::string, int64_t>> out;
+
+    std::lock_guard lock(mutex_);
+    for (auto const& [name, item] : entries_) {
+        switch (item.type) {
+            case kind::counter:
+                out.emplace_back(name, int64_t(item.counter_value->value()));
+                break;
+
+            case kind::gauge:
+                out.emplace_back(name, item.gauge_value->value());
+                break;
+
+            case kind::sampled:
+                out.emplace_back(name, item.sample ? item.sample() : 0);
+                break;
+
+            case kind::histogram: {
+                auto const& values = *item.histogram_value;
+                out.emplace_back(name + ".count", int64_t(values.count()));
+                out.emplace_back(name + ".sum", int64_t(values.sum()));
+                out.emplace_back(name + ".p50", int64_t(values.quantile(0.5)));
+                out.emplace_back(name + ".p90", int64_t(values.quantile(0.9)));
+                out.emplace_back(name + ".p99", int64_t(values.quantile(0.99)));
+                out.emplace_back(name + ".max", int64_t(values.quantile(1.0)));
+                break;
+            }
+        }
+    }
+
+    return out;
+}
+
+// private
+registry::entry& registry::find_or_create(std::string const& name, std::string const& help, kind type) {
+    auto [it, inserted] = entries_.try_emplace(name);
+    if (inserted) {
+        it->second.type = type;
+        it->second.help = help;
+    } else if (it->second.type != type) {
+        throw std::logic_error("metric " + name + " registered with another type");
+    }
+    return it->second;
+}
+
+registry& default_registry() {
+    static registry instance;
+    return instance;
+}
+
+} // namespace kth::metrics
@@ -34,6 +34,22 @@ void prioritized_mutex::unlock_low_priority()
 }
 }
 
+void prioritized_mutex::lock_low_priority_shared()
+{
+    // A waiting high priority holds next_mutex_ until it gets the data.
+    if (prioritize_) {
+        next_mutex_.lock_shared();
+        next_mutex_.unlock_shared();
+    }
+
+    data_mutex_.lock_shared();
+}
+
+void prioritized_mutex::unlock_low_priority_shared()
+{
+    data_mutex_.unlock_shared();
+}
+
 void prioritized_mutex::lock_high_priority()
 {
     if (prioritize_) {
@@ -4,8 +4,11 @@
 
 #include "hash.hpp"
 
+#include <algorithm>
+
 #include <test_helpers.hpp>
 #include <kth/infrastructure.hpp>
+#include <kth/infrastructure/math/sip_hash.hpp>
 
 using namespace kth;
 
@@ -39,6 +42,42 @@ TEST_CASE("sha256 hash test", "[hash tests]") {
     REQUIRE(encode_base16(hash) == "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7");
 }
 
+TEST_CASE("sha256 hash  test vectors", "[hash tests]") {
+    for (auto const& result: sha256_tests) {
+        data_chunk data;
+        REQUIRE(decode_base16(data, result.input));
+        REQUIRE(encode_base16(sha256_hash(data)) == result.result);
+    }
+}
+
+TEST_CASE("sha256 hash  multiple blocks", "[hash tests]") {
+    REQUIRE(encode_base16(sha256_hash(to_chunk(std::string("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")))) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    REQUIRE(encode_base16(sha256_hash(to_chunk(std::string("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu")))) == "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1");
+    REQUIRE(encode_base16(sha256_hash(data_chunk(1000000, 'a'))) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST_CASE("sha256 hash  split message  same hash", "[hash tests]") {
+    data_chunk data(200);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i);
+    }
+
+    auto const expected = sha256_hash(data);
+    for (size_t split = 0; split <= data.size(); ++split) {
+        data_slice const first(data.data(), data.data() + split);
+        data_slice const second(data.data() + split, data.data() + data.size());
+        REQUIRE(sha256_hash(first, second) == expected);
+    }
+}
+
+TEST_CASE("bitcoin hash  every padding length  sha256 of sha256", "[hash tests]") {
+    data_chunk data;
+    for (size_t size = 0; size < 130; ++size) {
+        REQUIRE(bitcoin_hash(data) == sha256_hash(sha256_hash(data)));
+        data.push_back(uint8_t(size * 7));
+    }
+}
+
 TEST_CASE("sha512 hash test", "[hash tests]") {
     data_chunk const chunk{ 'd', 'a', 't', 'a' };
     auto const long_hash = sha512_hash(chunk);
@@ -66,4 +105,107 @@ TEST_CASE("pkcs5 pbkdf2 hmac sha512 test", "[hash tests]") {
     }
 }
 
+TEST_CASE("sha256d64  every batch size  matches bitcoin hash", "[hash tests]") {
+    // Up to 20 messages covers every kernel width and the remainders.
+    for (size_t blocks = 1; blocks <= 20; ++blocks) {
+        data_chunk data(blocks * 64);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = uint8_t(i * 31 + blocks);
+        }
+
+        data_chunk out(blocks * hash_size);
+        sha256d64(out.data(), data.data(), blocks);
+
+        // In place, the digests overwrite the messages.
+        auto in_place = data;
+        sha256d64(in_place.data(), in_place.data(), blocks);
+
+        for (size_t block = 0; block < blocks; ++block) {
+            auto const expected = bitcoin_hash(data_slice(data.data() + block * 64, data.data() + block * 64 + 64));
+            REQUIRE(std::equal(expected.begin(), expected.end(), out.begin() + block * hash_size));
+            REQUIRE(std::equal(expected.begin(), expected.end(), in_place.begin() + block * hash_size));
+        }
+    }
+}
+
+// sha256d64 only dispatches to the preferred kernels, the others are
+// compared against the portable one here, as far as the CPU supports them.
+TEST_CASE("sha256d64 kernels  every supported kernel  matches portable", "[hash tests]") {
+    auto const kernels = sha256d64_kernels();
+    REQUIRE( ! kernels.empty());
+    auto const& portable = kernels.front();
+    REQUIRE(portable.width == 1);
+
+    for (auto const& kernel : kernels) {
+        INFO(kernel.name << " " << kernel.width << "-way");
+
+        for (size_t round = 0; round < 4; ++round) {
+            data_chunk data(kernel.width * 64);
+            for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = uint8_t(i * 13 + round * 101 + kernel.width);
+            }
+
+            data_chunk out(kernel.width * hash_size);
+            kernel.transform(out.data(), data.data());
+
+            data_chunk expected(kernel.width * hash_size);
+            for (size_t block = 0; block < kernel.width; ++block) {
+                portable.transform(expected.data() + block * hash_size, data.data() + block * 64);
+            }
+
+            REQUIRE(out == expected);
+            REQUIRE(std::equal(out.begin(), out.begin() + hash_size, bitcoin_hash(data_slice(data.data(), data.data() + 64)).begin()));
+        }
+    }
+}
+
+TEST_CASE("merkle root  empty  null hash", "[hash tests]") {
+    REQUIRE(merkle_root({}) == null_hash);
+}
+
+TEST_CASE("merkle root  single hash  itself", "[hash tests]") {
+    auto const hash = bitcoin_hash(data_chunk{ 'd', 'a', 't', 'a' });
+    REQUIRE(merkle_root({hash}) == hash);
+}
+
+TEST_CASE("merkle root  odd levels  duplicates last hash", "[hash tests]") {
+    hash_list hashes;
+    for (uint8_t i = 0; i < 5; ++i) {
+        hashes.push_back(bitcoin_hash(data_chunk{ i }));
+    }
+
+    auto const pair = [](hash_digest const& left, hash_digest const& right) {
+        return bitcoin_hash(build_chunk({left, right}));
+    };
+
+    auto const expected = pair(
+        pair(pair(hashes[0], hashes[1]), pair(hashes[2], hashes[3])),
+        pair(pair(hashes[4], hashes[4]), pair(hashes[4], hashes[4])));
+
+    REQUIRE(merkle_root(hashes) == expected);
+}
+
+TEST_CASE("sip hash uint256  every batch size  matches sip hasher", "[hash tests]") {
+    uint64_t const k0 = 0x0706050403020100;
+    uint64_t const k1 = 0x0f0e0d0c0b0a0908;
+
+    hash_list hashes(11);
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        for (size_t j = 0; j < hash_size; ++j) {
+            hashes[i][j] = uint8_t(i * 37 + j);
+        }
+    }
+
+    for (size_t count = 0; count <= hashes.size(); ++count) {
+        std::vector<uint64_t> out(count);
+        sip_hash_uint256(k0, k1, hashes.data(), count, out.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            auto const expected = sip_hasher(k0, k1).write(hashes[i].data(), hash_size).finalize();
+            REQUIRE(out[i] == expected);
+            REQUIRE(out[i] == sip_hash_uint256(k0, k1, hashes[i]));
+        }
+    }
+}
+
 // End Test Suite
@@ -0,0 +1,104 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+#include <kth/infrastructure.hpp>
+
+using namespace kth;
+using namespace kth::metrics;
+
+// Start Test Suite: metrics tests
+
+TEST_CASE("metrics  histogram  bucket index  exact below sub buckets", "[metrics tests]") {
+    for (uint64_t value = 0; value < histogram::sub_buckets * 2; ++value) {
+        REQUIRE(histogram::bucket_index(value) == value);
+        REQUIRE(histogram::bucket_bound(size_t(value)) == value);
+    }
+}
+
+TEST_CASE("metrics  histogram  bucket bound  holds the value", "[metrics tests]") {
+    for (uint64_t value : {uint64_t(16), uint64_t(17), uint64_t(100), uint64_t(1000), uint64_t(123456789), max_uint64}) {
+        auto const index = histogram::bucket_index(value);
+        REQUIRE(index < histogram::bucket_count);
+        REQUIRE(histogram::bucket_bound(index) >= value);
+        REQUIRE(histogram::bucket_bound(index) - value <= value / histogram::sub_buckets);
+        REQUIRE(histogram::bucket_bound(index - 1) < value);
+    }
+
+    REQUIRE(histogram::bucket_index(max_uint64) == histogram::bucket_count - 1);
+}
+
+TEST_CASE("metrics  histogram  record  count sum quantile", "[metrics tests]") {
+    histogram values;
+    REQUIRE(values.quantile(0.5) == 0);
+
+    for (uint64_t value = 1; value <= 100; ++value) {
+        values.record(value);
+    }
+
+    REQUIRE(values.count() == 100);
+    REQUIRE(values.sum() == 5050);
+
+    auto const median = values.quantile(0.5);
+    REQUIRE(median >= 50);
+    REQUIRE(median <= 50 + 50 / histogram::sub_buckets);
+    REQUIRE(values.quantile(1.0) >= 100);
+}
+
+TEST_CASE("metrics  registry  make  returns the same metric", "[metrics tests]") {
+    registry metrics;
+    auto& first = metrics.make_counter("kth_test_total", "Test.");
+    auto& second = metrics.make_counter("kth_test_total", "Test.");
+    REQUIRE(&first == &second);
+    REQUIRE_THROWS_AS(metrics.make_gauge("kth_test_total", "Test."), std::logic_error);
+}
+
+TEST_CASE("metrics  registry  to prometheus", "[metrics tests]") {
+    registry metrics;
+    metrics.make_counter("kth_test_total", "Counter.").add(3);
+    metrics.make_gauge("kth_test_gauge", "Gauge.").set(-2);
+    metrics.make_sampled_gauge("kth_test_sampled", "Sampled.", [] { return int64_t(7); });
+
+    auto& values = metrics.make_histogram("kth_test_microseconds", "Histogram.");
+    values.record(3);
+    values.record(20);
+
+    auto const text = metrics.to_prometheus();
+    REQUIRE(text.find("# TYPE kth_test_total counter\nkth_test_total 3\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_gauge -2\n") != std::string::npos);
+    REQUIRE(text.find("# TYPE kth_test_sampled gauge\nkth_test_sampled 7\n") != std::string::npos);
+    REQUIRE(text.find("# TYPE kth_test_microseconds histogram\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_microseconds_bucket{le=\"7\"} 1\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_microseconds_bucket{le=\"31\"} 2\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_microseconds_bucket{le=\"+Inf\"} 2\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_microseconds_sum 23\n") != std::string::npos);
+    REQUIRE(text.find("kth_test_microseconds_count 2\n") != std::string::npos);
+
+    metrics.remove_sampled_gauge("kth_test_sampled");
+    REQUIRE(metrics.to_prometheus().find("kth_test_sampled") == std::string::npos);
+}
+
+TEST_CASE("metrics  registry  snapshot", "[metrics tests]") {
+    registry metrics;
+    metrics.make_counter("kth_test_total", "Counter.").add(5);
+    metrics.make_histogram("kth_test_microseconds", "Histogram.").record(4);
+
+    auto const values = metrics.snapshot();
+    auto const value = [&values](std::string const& name) {
+        for (auto const& [key, number] : values) {
+            if (key == name) {
+                return number;
+            }
+        }
+        return int64_t(-1);
+    };
+
+    REQUIRE(value("kth_test_total") == 5);
+    REQUIRE(value("kth_test_microseconds.count") == 1);
+    REQUIRE(value("kth_test_microseconds.sum") == 4);
+    REQUIRE(value("kth_test_microseconds.p50") == 4);
+    REQUIRE(value("kth_test_microseconds.max") == 4);
+}
+
+// End Test Suite
@@ -0,0 +1,89 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <kth/infrastructure.hpp>
+
+using namespace kth;
+
+// Start Test Suite: once cache tests
+
+TEST_CASE("once cache  get  computes once", "[once cache tests]") {
+    once_cache<int> cache;
+    size_t calls = 0;
+    auto const compute = [&calls] { ++calls; return 42; };
+
+    REQUIRE( ! cache.has_value());
+    REQUIRE(cache.get(compute) == 42);
+    REQUIRE(cache.get(compute) == 42);
+    REQUIRE(calls == 1);
+    REQUIRE(cache.has_value());
+}
+
+TEST_CASE("once cache  reset  computes again", "[once cache tests]") {
+    once_cache<int> cache;
+    cache.set(1);
+    REQUIRE(cache.get([] { return 2; }) == 1);
+
+    cache.reset();
+    REQUIRE( ! cache.has_value());
+    REQUIRE(cache.get([] { return 2; }) == 2);
+}
+
+TEST_CASE("once cache  copy  carries value", "[once cache tests]") {
+    once_cache<std::vector<int>> cache;
+    cache.set({1, 2, 3});
+
+    auto const copy = cache;
+    REQUIRE(copy.has_value());
+    REQUIRE(copy.get([] { return std::vector<int>{}; }) == std::vector<int>{1, 2, 3});
+
+    once_cache<std::vector<int>> assigned;
+    assigned = once_cache<std::vector<int>>{};
+    REQUIRE( ! assigned.has_value());
+    assigned = cache;
+    REQUIRE(assigned.has_value());
+}
+
+TEST_CASE("once cache  throwing compute  stays empty", "[once cache tests]") {
+    once_cache<int> cache;
+    REQUIRE_THROWS_AS(cache.get([]() -> int { throw std::runtime_error("compute"); }), std::runtime_error);
+    REQUIRE( ! cache.has_value());
+    REQUIRE(cache.get([] { return 7; }) == 7);
+}
+
+TEST_CASE("once cache  concurrent readers  compute once", "[once cache tests]") {
+    once_cache<std::vector<int>> cache;
+    std::atomic<size_t> calls{0};
+    auto const compute = [&calls] {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::vector<int>(100, 5);
+    };
+
+    std::vector<std::thread> readers;
+    std::atomic<size_t> matches{0};
+    for (size_t i = 0; i < 8; ++i) {
+        readers.emplace_back([&] {
+            if (cache.get(compute) == std::vector<int>(100, 5)) {
+                ++matches;
+            }
+        });
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(calls == 1);
+    REQUIRE(matches == 8);
+}
+
+// End Test Suite
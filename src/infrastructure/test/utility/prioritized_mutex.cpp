@@ -0,0 +1,57 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <kth/infrastructure.hpp>
+
+using namespace kth;
+
+// Start Test Suite: prioritized mutex tests
+
+TEST_CASE("prioritized mutex  low priority shared  held by several threads", "[prioritized mutex tests]") {
+    prioritized_mutex mutex;
+    mutex.lock_low_priority_shared();
+
+    std::atomic<bool> locked{false};
+    std::thread other([&] {
+        mutex.lock_low_priority_shared();
+        locked = true;
+        mutex.unlock_low_priority_shared();
+    });
+    other.join();
+
+    mutex.unlock_low_priority_shared();
+    REQUIRE(locked);
+}
+
+// No sleeps: the high priority holder records whether the shared side was
+// already released when it got the lock, which must always be the case.
+TEST_CASE("prioritized mutex  high priority  waits for shared holders", "[prioritized mutex tests]") {
+    prioritized_mutex mutex;
+    mutex.lock_low_priority_shared();
+
+    std::atomic<bool> trying{false};
+    std::atomic<bool> released{false};
+    std::atomic<bool> saw_released{false};
+    std::thread other([&] {
+        trying = true;
+        trying.notify_one();
+        mutex.lock_high_priority();
+        saw_released = released.load();
+        mutex.unlock_high_priority();
+    });
+
+    trying.wait(false);
+    released = true;
+    mutex.unlock_low_priority_shared();
+    other.join();
+
+    REQUIRE(saw_released);
+}
+
+// End Test Suite
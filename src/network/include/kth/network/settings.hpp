@@ -58,6 +58,7 @@ public:
     size_t maximum_archive_size;
     size_t maximum_archive_files;
     infrastructure::config::authority statistics_server;
+    infrastructure::config::authority metrics_server;
     bool verbose;
     bool use_ipv6;
 
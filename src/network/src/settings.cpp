@@ -49,6 +49,7 @@ settings::settings()
     , maximum_archive_size(0)
     , maximum_archive_files(0)
     , statistics_server(unspecified_network_address)
+    , metrics_server(unspecified_network_address)
     , verbose(false)
     , use_ipv6(true)
 {}
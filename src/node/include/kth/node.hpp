@@ -39,6 +39,7 @@
 #include <kth/node/sessions/session_inbound.hpp>
 #include <kth/node/sessions/session_manual.hpp>
 #include <kth/node/sessions/session_outbound.hpp>
+#include <kth/node/utility/metrics_server.hpp>
 #endif
 
 #include <kth/node/utility/check_list.hpp>
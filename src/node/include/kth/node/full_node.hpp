@@ -38,6 +38,7 @@ class Table;
 #if ! defined(__EMSCRIPTEN__)
 #include <kth/node/sessions/session_block_sync.hpp>
 #include <kth/node/sessions/session_header_sync.hpp>
+#include <kth/node/utility/metrics_server.hpp>
 #endif
 
 #include <kth/node/utility/check_list.hpp>
@@ -456,6 +457,11 @@ private:
     void handle_running(code const& ec, result_handler handler);
     void handle_running_chain(code const& ec, result_handler handler);
 
+#if ! defined(__EMSCRIPTEN__)
+    void start_metrics();
+    void stop_metrics();
+#endif
+
 
 #if defined(KTH_STATISTICS_ENABLED)
     // statistics_detail_t statistics_detail_;
@@ -514,6 +520,7 @@ private:
 
 #if ! defined(__EMSCRIPTEN__)
     const uint32_t protocol_maximum_;
+    metrics_server::ptr metrics_;
 #endif
 
     const node::settings& node_settings_;
@@ -47,6 +47,10 @@ private:
     void report(domain::chain::block const& block);
 #endif
 
+    // Feeds the metrics registry, for every connected block.
+    static
+    void record_metrics(domain::chain::block const& block);
+
     void send_get_blocks(hash_digest const& stop_hash);
     void send_get_data(code const& ec, get_data_ptr message);
 
@@ -0,0 +1,66 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_NODE_METRICS_SERVER_HPP
+#define KTH_NODE_METRICS_SERVER_HPP
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include <kth/infrastructure.hpp>
+#include <kth/node/define.hpp>
+
+namespace kth::node {
+
+/// Exposes the metrics of the default registry (metrics::default_registry).
+/// Any HTTP request to the endpoint is answered with the Prometheus text
+/// format, and the metrics are pushed to the statsd sink every interval.
+/// This class is thread safe.
+class BCN_API metrics_server
+    : public enable_shared_from_base<metrics_server>
+    , noncopyable
+{
+public:
+    using ptr = std::shared_ptr<metrics_server>;
+
+    static constexpr auto publish_interval = asio::seconds(10);
+    static constexpr auto accept_retry_interval = asio::seconds(1);
+    static constexpr auto connection_timeout = asio::seconds(5);
+    static constexpr size_t connection_limit = 8;
+
+    /// An unspecified endpoint disables the scrapes.
+    metrics_server(threadpool& pool, infrastructure::config::authority const& endpoint, bool publish_statsd);
+
+    /// False if the endpoint cannot be bound.
+    bool start();
+    void stop();
+
+private:
+    using buffer = std::array<char, 1024>;
+
+    void accept();
+    void handle_accept(boost_code const& ec, asio::socket_ptr socket);
+    void handle_accept_retry(code const& ec);
+    void handle_timeout(code const& ec, asio::socket_ptr socket);
+    void handle_request(boost_code const& ec, asio::socket_ptr socket, deadline::ptr timer, std::shared_ptr<buffer> request);
+    void finish(asio::socket_ptr socket, deadline::ptr timer);
+    void handle_timer(code const& ec);
+
+    threadpool& pool_;
+    infrastructure::config::authority const endpoint_;
+    bool const publish_statsd_;
+
+    // Protects the acceptor, the sockets, stopped and connections.
+    std::mutex mutex_;
+    bool stopped_;
+    size_t connections_;
+    asio::acceptor acceptor_;
+    deadline::ptr timer_;
+    deadline::ptr accept_retry_timer_;
+};
+
+} // namespace kth::node
+
+#endif
@@ -223,6 +223,8 @@ void full_node::handle_running(code const& ec, result_handler handler) {
     subscribe_blockchain(
         std::bind(&full_node::handle_reorganized, this, _1, _2, _3, _4));
 
+    start_metrics();
+
     // This is invoked on a new thread.
     // This is the end of the derived run startup sequence.
     p2p::run(handler);
@@ -291,6 +293,43 @@ bool full_node::handle_reorganized(code ec, size_t fork_height, block_const_ptr_
     return true;
 }
 
+// Metrics.
+// ----------------------------------------------------------------------------
+
+#if ! defined(__EMSCRIPTEN__)
+// A failure to bind the endpoint is logged, the node runs without it.
+void full_node::start_metrics() {
+    auto const& settings = network_settings();
+
+#if defined(KTH_LOG_LIBRARY_BOOST)
+    auto const publish_statsd = bool(settings.statistics_server);
+#else
+    auto const publish_statsd = false;
+#endif
+
+    if ( ! settings.metrics_server && ! publish_statsd) {
+        return;
+    }
+
+    metrics::default_registry().make_sampled_gauge("kth_network_connections", "Connected peers.", [this] {
+        return int64_t(connection_count());
+    });
+
+    metrics_ = std::make_shared<metrics_server>(thread_pool(), settings.metrics_server, publish_statsd);
+    metrics_->start();
+}
+
+void full_node::stop_metrics() {
+    if ( ! metrics_) {
+        return;
+    }
+
+    metrics_->stop();
+    metrics_.reset();
+    metrics::default_registry().remove_sampled_gauge("kth_network_connections");
+}
+#endif
+
 // Specializations.
 // ----------------------------------------------------------------------------
 // Create derived sessions and override these to inject from derived node.
@@ -323,6 +362,10 @@ session_block_sync::ptr full_node::attach_block_sync_session() {
 // ----------------------------------------------------------------------------
 
 bool full_node::stop() {
+#if ! defined(__EMSCRIPTEN__)
+    stop_metrics();
+#endif
+
     // Suspend new work last so we can use work to clear subscribers.
     auto const p2p_stop = p2p::stop();
     auto const chain_stop = chain_.stop();
@@ -200,6 +200,10 @@ options_metadata parser::load_settings() {
         "log.statistics_server",
         value<infrastructure::config::authority>(&configured.network.statistics_server),
         "The address of the statistics collection server, defaults to none."
+    )(
+        "log.metrics_server",
+        value<infrastructure::config::authority>(&configured.network.metrics_server),
+        "The address to serve the metrics on (Prometheus text format over HTTP), defaults to none."
     )(
         "log.verbose",
         value<bool>(&configured.network.verbose),
@@ -338,7 +342,15 @@ options_metadata parser::load_settings() {
     )(
         "database.cache_capacity",
         value<uint32_t>(&configured.database.cache_capacity),
-        "The maximum number of entries in the unspent outputs cache, defaults to 10000."
+        "The size in megabytes of the unspent outputs write-back cache, zero disables it, defaults to 0."
+    )(
+        "database.group_commit_blocks",
+        value<uint32_t>(&configured.database.group_commit_blocks),
+        "The number of blocks under the last checkpoint written in a single transaction, zero disables grouping, defaults to 1000."
+    )(
+        "database.group_commit_size",
+        value<uint32_t>(&configured.database.group_commit_size),
+        "The size in megabytes of the blocks under the last checkpoint written in a single transaction, defaults to 256."
     )
     /* [blockchain] */
     (
@@ -368,6 +380,22 @@ options_metadata parser::load_settings() {
         "blockchain.fix_checkpoints",
         value<bool>(&configured.chain.fix_checkpoints),
         "Uses the hardcoded checkpoints and the user defined ones, defaults to true."
+    )(
+        "blockchain.signature_cache_mb",
+        value<uint32_t>(&configured.chain.signature_cache_mb),
+        "The memory used to cache valid signatures, in MiB, defaults to 32 (0 to disable)."
+    )(
+        "blockchain.script_cache_mb",
+        value<uint32_t>(&configured.chain.script_cache_mb),
+        "The memory used to cache inputs with verified scripts, in MiB, defaults to 16 (0 to disable)."
+    )(
+        "blockchain.organize_pipeline_depth",
+        value<uint32_t>(&configured.chain.organize_pipeline_depth),
+        "The maximum number of blocks being checked or waiting while another one is organized, defaults to 4."
+    )(
+        "blockchain.transaction_pipeline_depth",
+        value<uint32_t>(&configured.chain.transaction_pipeline_depth),
+        "The maximum number of transactions being verified or waiting to be stored, defaults to 16."
     )
 
 
@@ -671,6 +671,8 @@ void protocol_block_in::handle_store_block(code const& ec, block_const_ptr messa
        , checked, ", ", state->minimum_version(), ").");
 
 
+    record_metrics(*message);
+
 #if defined(KTH_STATISTICS_ENABLED)
     report(*message, node_);
 #else
@@ -764,6 +766,12 @@ size_t unit_cost(const asio::time_point& start, const asio::time_point& end, siz
     return static_cast<size_t>(std::round(difference(start, end) / value));
 }
 
+inline
+size_t unit_cost(asio::duration const& elapsed, size_t value) {
+    auto const micros = duration_cast<asio::microseconds>(elapsed);
+    return static_cast<size_t>(std::round(static_cast<float>(micros.count()) / value));
+}
+
 inline
 size_t total_cost_ms(const asio::time_point& start, const asio::time_point& end) {
     static constexpr size_t microseconds_per_millisecond = 1000;
@@ -819,7 +827,7 @@ void protocol_block_in::report(domain::chain::block const& block) {
 
         auto formatted = fmt::format("[{:6}] {:>5} txs {:>5} ins "
             "{:>4} wms {:>5} vms {:>4} vus {:>4} rus {:>4} cus {:>4} pus "
-            "{:>4} aus {:>4} sus {:>4} dus {:f}", height, transactions, inputs,
+            "{:>4} aus {:>4} sus {:>4} qus {:>4} xus {:>4} dus {:>4} gus {:f} {:f}", height, transactions, inputs,
 
             // wms: wait total (ms)
             total_cost_ms(times.end_deserialize, times.start_check),
@@ -845,11 +853,23 @@ void protocol_block_in::report(domain::chain::block const& block) {
             // sus: connect (script) per input (µs)
             unit_cost(times.start_connect, times.start_notify, inputs),
 
+            // qus: connect tasks waiting for a thread per input (µs, summed over the tasks)
+            unit_cost(times.connect_queue, inputs),
+
+            // xus: connect tasks running per input (µs, summed over the tasks)
+            unit_cost(times.connect_execution, inputs),
+
             // dus: deposit per input (µs)
             unit_cost(times.start_push, times.end_push, inputs),
 
+            // gus: reorg subset build, once per block (µs)
+            unit_cost(times.start_reorg_subset, times.end_reorg_subset, 1),
+
             // this block transaction cache efficiency (hits/queries)
-            block.validation.cache_efficiency);
+            block.validation.cache_efficiency,
+
+            // this block script cache efficiency (hits/queries)
+            block.validation.script_cache_efficiency);
 
 #if defined(KTH_STATISTICS_ENABLED)
         if (enabled(height)) {
@@ -862,4 +882,84 @@ void protocol_block_in::report(domain::chain::block const& block) {
     }
 }
 
-} // namespace kth::node
\ No newline at end of file
+namespace {
+
+// Zero if a stage did not run (not timed).
+inline
+uint64_t elapsed_us(asio::time_point const& start, asio::time_point const& end) {
+    if (start == asio::time_point{} || end <= start) {
+        return 0;
+    }
+    return uint64_t(duration_cast<asio::microseconds>(end - start).count());
+}
+
+struct block_metrics {
+    metrics::counter& blocks;
+    metrics::counter& transactions;
+    metrics::counter& inputs;
+    metrics::gauge& height;
+    metrics::gauge& cache_efficiency;
+    metrics::gauge& script_cache_efficiency;
+    metrics::histogram& deserialize;
+    metrics::histogram& wait;
+    metrics::histogram& check;
+    metrics::histogram& populate;
+    metrics::histogram& accept;
+    metrics::histogram& connect;
+    metrics::histogram& push;
+    metrics::histogram& validate;
+};
+
+block_metrics& get_block_metrics() {
+    auto& registry = metrics::default_registry();
+    static block_metrics instance {
+        registry.make_counter("kth_block_connected_total", "Blocks connected to the chain."),
+        registry.make_counter("kth_block_transactions_total", "Transactions of the connected blocks."),
+        registry.make_counter("kth_block_inputs_total", "Inputs of the connected blocks."),
+        registry.make_gauge("kth_block_height", "Height of the last connected block."),
+        registry.make_gauge("kth_block_cache_efficiency_permille", "Transaction cache hits per thousand queries, last block."),
+        registry.make_gauge("kth_block_script_cache_efficiency_permille", "Script cache hits per thousand queries, last block."),
+        registry.make_histogram("kth_block_deserialize_microseconds", "Block deserialization time."),
+        registry.make_histogram("kth_block_wait_microseconds", "Time from deserialization to the start of the checks."),
+        registry.make_histogram("kth_block_check_microseconds", "Context free block checks time."),
+        registry.make_histogram("kth_block_populate_microseconds", "Prevout population time."),
+        registry.make_histogram("kth_block_accept_microseconds", "Contextual block checks time."),
+        registry.make_histogram("kth_block_connect_microseconds", "Script verification time."),
+        registry.make_histogram("kth_block_push_microseconds", "Time to store the block."),
+        registry.make_histogram("kth_block_validate_microseconds", "Block validation time, without the wait.")
+    };
+    return instance;
+}
+
+} // namespace
+
+// static
+void protocol_block_in::record_metrics(domain::chain::block const& block) {
+    auto& values = get_block_metrics();
+    auto const& times = block.validation;
+
+    values.blocks.add();
+    values.transactions.add(block.transactions().size());
+    values.inputs.add(domain::chain::total_inputs(block));
+
+    if (times.state) {
+        values.height.set(int64_t(times.state->height()));
+    }
+
+    values.cache_efficiency.set(int64_t(std::lround(times.cache_efficiency * 1000)));
+    values.script_cache_efficiency.set(int64_t(std::lround(times.script_cache_efficiency * 1000)));
+
+    // As in report, the wait is not part of the validation time.
+    auto const start_validate = times.start_check - (times.end_deserialize - times.start_deserialize);
+
+    values.deserialize.record(elapsed_us(times.start_deserialize, times.end_deserialize));
+    values.wait.record(elapsed_us(times.end_deserialize, times.start_check));
+    values.check.record(elapsed_us(times.start_check, times.start_populate));
+    values.populate.record(elapsed_us(times.start_populate, times.start_accept));
+    values.accept.record(elapsed_us(times.start_accept, times.start_connect));
+    values.connect.record(elapsed_us(times.start_connect, times.start_notify));
+    values.push.record(elapsed_us(times.start_push, times.end_push));
+    values.validate.record(elapsed_us(start_validate, times.start_notify));
+}
+
+} // namespace kth::node
@@ -156,6 +156,9 @@ bool protocol_transaction_in::handle_receive_transaction(code const& ec, transac
     }
 
     message->validation.originator = nonce();
+
+    // This blocks while the admission pipeline is full, so the channel stops
+    // reading and the peer is throttled by the transport.
     chain_.organize(message, BIND2(handle_store_transaction, _1, message));
     return true;
 }
@@ -0,0 +1,225 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/node/utility/metrics_server.hpp>
+
+#include <functional>
+#include <string>
+
+#include <kth/infrastructure/log/source.hpp>
+
+#if defined(KTH_LOG_LIBRARY_BOOST)
+#include <kth/infrastructure/log/statsd_sink.hpp>
+#endif
+
+namespace kth::node {
+
+using namespace std::placeholders;
+
+static auto const reuse_address = asio::acceptor::reuse_address(true);
+
+metrics_server::metrics_server(threadpool& pool, infrastructure::config::authority const& endpoint, bool publish_statsd)
+    : pool_(pool)
+    , endpoint_(endpoint)
+    , publish_statsd_(publish_statsd)
+    , stopped_(true)
+    , connections_(0)
+    , acceptor_(pool.service())
+{}
+
+bool metrics_server::start() {
+    std::lock_guard lock(mutex_);
+    if ( ! stopped_) {
+        return false;
+    }
+
+    if (endpoint_) {
+        boost_code error;
+        asio::endpoint const endpoint(endpoint_.asio_ip(), endpoint_.port());
+
+        acceptor_.open(endpoint.protocol(), error);
+
+        if ( ! error) {
+            acceptor_.set_option(reuse_address, error);
+        }
+
+        if ( ! error) {
+            acceptor_.bind(endpoint, error);
+        }
+
+        if ( ! error) {
+            acceptor_.listen(asio::max_connections, error);
+        }
+
+        if (error) {
+            LOG_ERROR(LOG_NODE, "Failure binding the metrics endpoint [", endpoint_, "]: ", error.message());
+            boost_code ignore;
+            acceptor_.close(ignore);
+            return false;
+        }
+
+        LOG_INFO(LOG_NODE, "Serving metrics on [", endpoint_, "].");
+    }
+
+    stopped_ = false;
+
+    // Connections left from a previous run resume the accept when they finish.
+    if (endpoint_ && connections_ < connection_limit) {
+        accept();
+    }
+
+    if (publish_statsd_) {
+        timer_ = std::make_shared<deadline>(pool_, publish_interval);
+        timer_->start(std::bind(&metrics_server::handle_timer, shared_from_this(), _1));
+    }
+
+    return true;
+}
+
+void metrics_server::stop() {
+    std::lock_guard lock(mutex_);
+    if (stopped_) {
+        return;
+    }
+
+    stopped_ = true;
+
+    // This will asynchronously invoke the handler of the pending accept.
+    boost_code ignore;
+    acceptor_.close(ignore);
+
+    if (timer_) {
+        timer_->stop();
+        timer_.reset();
+    }
+
+    if (accept_retry_timer_) {
+        accept_retry_timer_->stop();
+        accept_retry_timer_.reset();
+    }
+}
+
+// private
+// precondition: mutex_ is held
+void metrics_server::accept() {
+    auto const socket = std::make_shared<asio::socket>(pool_.service());
+    acceptor_.async_accept(*socket, std::bind(&metrics_server::handle_accept, shared_from_this(), _1, socket));
+}
+
+// private
+void metrics_server::handle_accept(boost_code const& ec, asio::socket_ptr socket) {
+    std::lock_guard lock(mutex_);
+    if (stopped_) {
+        return;
+    }
+
+    if (ec) {
+        if (ec == ::asio::error::operation_aborted || ec == ::asio::error::bad_descriptor) {
+            LOG_ERROR(LOG_NODE, "Metrics endpoint closed: ", ec.message());
+            return;
+        }
+
+        // Errors such as descriptor exhaustion persist, accepting again right
+        // away would spin. The accept is retried after a delay.
+        LOG_WARNING(LOG_NODE, "Error accepting a metrics scrape, retrying: ", ec.message());
+        accept_retry_timer_ = std::make_shared<deadline>(pool_, accept_retry_interval);
+        accept_retry_timer_->start(std::bind(&metrics_server::handle_accept_retry, shared_from_this(), _1));
+        return;
+    }
+
+    // A scraper that does not complete the exchange in time is disconnected.
+    auto const timer = std::make_shared<deadline>(pool_, connection_timeout);
+    timer->start(std::bind(&metrics_server::handle_timeout, shared_from_this(), _1, socket));
+
+    // A single read, the requests of the scrapers fit in the buffer.
+    auto const request = std::make_shared<buffer>();
+    socket->async_read_some(::asio::buffer(*request),
+        std::bind(&metrics_server::handle_request, shared_from_this(), _1, socket, timer, request));
+
+    // At the limit the next accept waits for a connection to finish, the
+    // pending ones stay in the listen backlog.
+    if (++connections_ < connection_limit) {
+        accept();
+    }
+}
+
+// private
+void metrics_server::handle_accept_retry(code const& ec) {
+    if (ec) {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+    if ( ! stopped_) {
+        accept();
+    }
+}
+
+// private
+void metrics_server::handle_timeout(code const& ec, asio::socket_ptr socket) {
+    if (ec) {
+        return;
+    }
+
+    // The pending read or write completes with an error and finishes.
+    std::lock_guard lock(mutex_);
+    boost_code ignore;
+    socket->close(ignore);
+}
+
+// private
+// The request is not parsed, any method and path get the metrics.
+void metrics_server::handle_request(boost_code const& ec, asio::socket_ptr socket, deadline::ptr timer, std::shared_ptr<buffer> /*request*/) {
+    if (ec) {
+        finish(socket, timer);
+        return;
+    }
+
+    auto const body = metrics::default_registry().to_prometheus();
+    auto const response = std::make_shared<std::string>(
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: close\r\n"
+        "\r\n" + body);
+
+    auto const self = shared_from_this();
+    std::lock_guard lock(mutex_);
+    ::asio::async_write(*socket, ::asio::buffer(*response), [self, socket, timer, response](boost_code const&, size_t) {
+        self->finish(socket, timer);
+    });
+}
+
+// private
+void metrics_server::finish(asio::socket_ptr socket, deadline::ptr timer) {
+    timer->stop();
+
+    std::lock_guard lock(mutex_);
+    boost_code ignore;
+    socket->shutdown(asio::socket::shutdown_both, ignore);
+    socket->close(ignore);
+
+    // The accept was paused at the limit, it resumes with the freed slot.
+    if (connections_-- == connection_limit && ! stopped_) {
+        accept();
+    }
+}
+
+// private
+void metrics_server::handle_timer(code const& ec) {
+    if (ec) {
+        return;
+    }
+
+#if defined(KTH_LOG_LIBRARY_BOOST)
+    kth::log::publish_statsd(metrics::default_registry());
+#endif
+
+    std::lock_guard lock(mutex_);
+    if ( ! stopped_ && timer_) {
+        timer_->start(std::bind(&metrics_server::handle_timer, shared_from_this(), _1));
+    }
+}
+
+} // namespace kth::node